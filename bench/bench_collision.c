@@ -0,0 +1,158 @@
+/**
+ * @file bench_collision.c
+ * @brief Collision test benchmark: padded row masks vs. per-cell checks
+ *
+ * Replays random move sequences (shift, rotate, soft drop) on boards
+ * with random rubble and times every position test twice: once with
+ * game_is_valid_position(), which ANDs shape row masks into the
+ * sentinel-padded Board::rows, and once with the per-cell bounds and
+ * occupancy test it replaced. Both must agree on every position.
+ *
+ * Usage: bench_collision [moves]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "../src/game.h"
+
+#define DEFAULT_MOVES 20000000UL
+#define BOARDS        64
+#define SEQUENCE      4096
+
+/* The previous implementation, with range checks for every filled cell */
+static int reference_is_valid(const GameState *game, const Tetromino *t)
+{
+    const int (*shape)[TETRO_MATRIX_SIZE] = tetromino_get_shape(t->type, t->rotation);
+
+    if (shape == NULL) {
+        return 0;
+    }
+    for (int row = 0; row < TETRO_MATRIX_SIZE; row++) {
+        for (int col = 0; col < TETRO_MATRIX_SIZE; col++) {
+            if (shape[row][col] == 1) {
+                int board_x = t->x + col;
+                int board_y = t->y + row;
+                if (board_x < 0 || board_x >= BOARD_WIDTH) {
+                    return 0;
+                }
+                if (board_y < 0 || board_y >= BOARD_HEIGHT) {
+                    return 0;
+                }
+                if (game->board.cells[board_y][board_x] != 0) {
+                    return 0;
+                }
+            }
+        }
+    }
+    return 1;
+}
+
+static uint64_t now_ns(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000ULL + (uint64_t)now.tv_nsec;
+}
+
+static uint64_t next_random(uint64_t *state)
+{
+    *state = *state * 6364136223846793005ULL + 1442695040888963407ULL;
+    return *state >> 33;
+}
+
+/* Random rubble up to a random height, one gap per row */
+static void fill_board(GameState *game, uint64_t *state)
+{
+    int height = (int)(next_random(state) % (BOARD_HEIGHT / 2));
+
+    for (int y = 0; y < BOARD_HEIGHT; y++) {
+        int gap = (int)(next_random(state) % BOARD_WIDTH);
+        for (int x = 0; x < BOARD_WIDTH; x++) {
+            int filled = y >= BOARD_HEIGHT - height && x != gap && next_random(state) % 4 != 0;
+            game->board.cells[y][x] = filled ? COLOR_Z : 0;
+        }
+    }
+    game_board_sync(&game->board);
+}
+
+/*
+ * Moves a piece by the random steps and returns how many of the
+ * candidate positions were valid. Valid moves are taken, so the piece
+ * wanders over the board and into the rubble like a real one.
+ */
+static unsigned long replay(const GameState *game, const unsigned char *steps, size_t count,
+                            int (*is_valid)(const GameState *, const Tetromino *))
+{
+    static const int dx[4] = { -1, 1, 0, 0 };
+    static const int dy[4] = { 0, 0, 1, 0 };
+    unsigned long valid = 0;
+    Tetromino piece = tetromino_create((TetrominoType)(steps[0] % TETRO_COUNT));
+
+    for (size_t i = 0; i < count; i++) {
+        Tetromino test = piece;
+        int step = steps[i] & 3;
+        test.x += dx[step];
+        test.y += dy[step];
+        if (step == 3) {
+            test.rotation = tetromino_rotate_clockwise(test.rotation);
+        }
+        if (is_valid(game, &test)) {
+            piece = test;
+            valid++;
+        } else if (step == 2) {
+            /* Landed: start the next piece at the top */
+            piece = tetromino_create((TetrominoType)((steps[i] >> 2) % TETRO_COUNT));
+        }
+    }
+    return valid;
+}
+
+int main(int argc, char **argv)
+{
+    unsigned long moves = DEFAULT_MOVES;
+    if (argc > 1) {
+        moves = strtoul(argv[1], NULL, 10);
+    }
+
+    static GameState games[BOARDS];
+    static unsigned char steps[BOARDS][SEQUENCE];
+    uint64_t state = 0x5eed;
+
+    for (int b = 0; b < BOARDS; b++) {
+        game_init_seeded(&games[b], (uint64_t)b);
+        fill_board(&games[b], &state);
+        for (int i = 0; i < SEQUENCE; i++) {
+            steps[b][i] = (unsigned char)next_random(&state);
+        }
+    }
+
+    unsigned long rounds = moves / SEQUENCE;
+    unsigned long valid_reference = 0;
+    unsigned long valid_padded = 0;
+
+    uint64_t start = now_ns();
+    for (unsigned long r = 0; r < rounds; r++) {
+        valid_reference += replay(&games[r % BOARDS], steps[r % BOARDS], SEQUENCE, reference_is_valid);
+    }
+    uint64_t reference_ns = now_ns() - start;
+
+    start = now_ns();
+    for (unsigned long r = 0; r < rounds; r++) {
+        valid_padded += replay(&games[r % BOARDS], steps[r % BOARDS], SEQUENCE, game_is_valid_position);
+    }
+    uint64_t padded_ns = now_ns() - start;
+
+    unsigned long checks = rounds * SEQUENCE;
+    printf("\n=== Collision Benchmark (%lu position tests, %d boards) ===\n\n", checks, BOARDS);
+    printf("%-28s %8.2f ns/test\n", "per-cell bounds checks:", (double)reference_ns / (double)checks);
+    printf("%-28s %8.2f ns/test\n", "padded row masks:", (double)padded_ns / (double)checks);
+    printf("%-28s %8.2fx\n", "speedup:", (double)reference_ns / (double)padded_ns);
+    printf("%-28s %lu of %lu\n", "valid positions:", valid_padded, checks);
+
+    if (valid_padded != valid_reference) {
+        fprintf(stderr, "Mismatch: reference found %lu valid positions\n", valid_reference);
+        return 1;
+    }
+    return 0;
+}
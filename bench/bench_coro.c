@@ -0,0 +1,170 @@
+/**
+ * @file bench_coro.c
+ * @brief Context switch benchmark for the coroutine scheduler
+ *
+ * Measures:
+ * - yield between two coroutines (hot caches)
+ * - yield round-robin over many coroutines (one stack each)
+ * - spawn + finish with recycled stacks
+ * - raw swapcontext() as the portable baseline
+ * - condition variable hand-off between two OS threads for comparison
+ */
+
+#include <stdio.h>
+#include <pthread.h>
+#include <ucontext.h>
+#include "../src/coro.h"
+
+#define PINGPONG_YIELDS 2000000UL
+#define MANY_COROUTINES 10000
+#define MANY_YIELDS     100
+#define SPAWN_COUNT     200000UL
+#define SWAP_ROUNDS     1000000UL
+#define THREAD_ROUNDS   100000UL
+
+static void yield_body(void *arg)
+{
+    unsigned long count = *(unsigned long *)arg;
+    for (unsigned long i = 0; i < count; i++) {
+        coro_yield();
+    }
+}
+
+static void empty_body(void *arg)
+{
+    (void)arg;
+}
+
+/* Reports the cost per switch for a scheduler run */
+static void report(const char *label, const CoroScheduler *sched, uint64_t elapsed)
+{
+    printf("%-32s %8.1f ns/switch\n", label,
+           (double)elapsed / (double)coro_scheduler_switches(sched));
+}
+
+static void bench_pingpong(void)
+{
+    CoroScheduler *sched = coro_scheduler_create(0);
+    unsigned long count = PINGPONG_YIELDS / 2;
+
+    coro_spawn(sched, yield_body, &count);
+    coro_spawn(sched, yield_body, &count);
+
+    uint64_t start = coro_now_ns();
+    coro_scheduler_run(sched);
+    report("yield, 2 coroutines:", sched, coro_now_ns() - start);
+    coro_scheduler_destroy(sched);
+}
+
+static void bench_many(void)
+{
+    CoroScheduler *sched = coro_scheduler_create(16 * 1024);
+    unsigned long count = MANY_YIELDS;
+
+    for (int i = 0; i < MANY_COROUTINES; i++) {
+        coro_spawn(sched, yield_body, &count);
+    }
+
+    uint64_t start = coro_now_ns();
+    coro_scheduler_run(sched);
+    report("yield, 10000 coroutines:", sched, coro_now_ns() - start);
+    coro_scheduler_destroy(sched);
+}
+
+static void bench_spawn(void)
+{
+    CoroScheduler *sched = coro_scheduler_create(0);
+
+    uint64_t start = coro_now_ns();
+    for (unsigned long i = 0; i < SPAWN_COUNT; i++) {
+        coro_spawn(sched, empty_body, NULL);
+        coro_scheduler_poll(sched);
+    }
+    uint64_t elapsed = coro_now_ns() - start;
+
+    printf("%-32s %8.1f ns/coroutine\n", "spawn + finish (recycled):",
+           (double)elapsed / (double)SPAWN_COUNT);
+    coro_scheduler_destroy(sched);
+}
+
+static ucontext_t main_context;
+static ucontext_t swap_context;
+static char swap_stack[64 * 1024];
+
+static void swap_body(void)
+{
+    for (;;) {
+        swapcontext(&swap_context, &main_context);
+    }
+}
+
+static void bench_swapcontext(void)
+{
+    getcontext(&swap_context);
+    swap_context.uc_stack.ss_sp = swap_stack;
+    swap_context.uc_stack.ss_size = sizeof(swap_stack);
+    swap_context.uc_link = NULL;
+    makecontext(&swap_context, swap_body, 0);
+
+    uint64_t start = coro_now_ns();
+    for (unsigned long i = 0; i < SWAP_ROUNDS; i++) {
+        swapcontext(&main_context, &swap_context);
+    }
+    uint64_t elapsed = coro_now_ns() - start;
+
+    printf("%-32s %8.1f ns/switch\n", "raw swapcontext():",
+           (double)elapsed / (double)(SWAP_ROUNDS * 2));
+}
+
+static pthread_mutex_t handoff_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t handoff_cond = PTHREAD_COND_INITIALIZER;
+static unsigned long handoff_turn;
+
+static void *handoff_thread(void *arg)
+{
+    (void)arg;
+    pthread_mutex_lock(&handoff_lock);
+    for (unsigned long i = 0; i < THREAD_ROUNDS; i++) {
+        while (handoff_turn % 2 == 0) {
+            pthread_cond_wait(&handoff_cond, &handoff_lock);
+        }
+        handoff_turn++;
+        pthread_cond_signal(&handoff_cond);
+    }
+    pthread_mutex_unlock(&handoff_lock);
+    return NULL;
+}
+
+static void bench_threads(void)
+{
+    pthread_t thread;
+    handoff_turn = 0;
+    pthread_create(&thread, NULL, handoff_thread, NULL);
+
+    uint64_t start = coro_now_ns();
+    pthread_mutex_lock(&handoff_lock);
+    for (unsigned long i = 0; i < THREAD_ROUNDS; i++) {
+        handoff_turn++;
+        pthread_cond_signal(&handoff_cond);
+        while (handoff_turn % 2 == 1) {
+            pthread_cond_wait(&handoff_cond, &handoff_lock);
+        }
+    }
+    pthread_mutex_unlock(&handoff_lock);
+    uint64_t elapsed = coro_now_ns() - start;
+    pthread_join(thread, NULL);
+
+    printf("%-32s %8.1f ns/switch\n", "thread hand-off (condvar):",
+           (double)elapsed / (double)(THREAD_ROUNDS * 2));
+}
+
+int main(void)
+{
+    printf("\n=== Coroutine Benchmark ===\n\n");
+    bench_pingpong();
+    bench_many();
+    bench_spawn();
+    bench_swapcontext();
+    bench_threads();
+    return 0;
+}
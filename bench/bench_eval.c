@@ -0,0 +1,117 @@
+/**
+ * @file bench_eval.c
+ * @brief Row evaluation benchmark: lookup tables vs. per-cell loops
+ *
+ * Sums filled cells, row transitions, gaps and well cells over boards
+ * with random rubble, once with eval_rows(), which does one table load
+ * per row, and once with a loop over the cells of every row. Both must
+ * agree on every board.
+ *
+ * Usage: bench_eval [evaluations]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "../src/eval.h"
+
+#define DEFAULT_EVALS 2000000UL
+#define BOARDS        64
+
+/* Cell of a board row, with the walls filled */
+static int cell(const Board *board, int x, int y)
+{
+    return x < 0 || x >= BOARD_WIDTH ? 1 : board->cells[y][x] != 0;
+}
+
+/* The per-cell version of eval_rows() */
+static void reference_rows(const Board *board, EvalRowSums *sums)
+{
+    sums->filled = sums->row_transitions = sums->gaps = sums->well_cells = 0;
+    for (int y = 0; y < BOARD_HEIGHT; y++) {
+        int filled = 0, gaps = 0;
+        for (int x = 0; x < BOARD_WIDTH; x++) {
+            filled += cell(board, x, y);
+            sums->row_transitions += cell(board, x, y) != cell(board, x - 1, y);
+            gaps += !cell(board, x, y) && cell(board, x - 1, y);
+            sums->well_cells += !cell(board, x, y) && cell(board, x - 1, y) && cell(board, x + 1, y);
+        }
+        sums->row_transitions += cell(board, BOARD_WIDTH - 1, y) != cell(board, BOARD_WIDTH, y);
+        sums->filled += filled;
+        sums->gaps += filled != 0 ? gaps : 0;
+    }
+}
+
+static uint64_t now_ns(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000ULL + (uint64_t)now.tv_nsec;
+}
+
+static uint64_t next_random(uint64_t *state)
+{
+    *state = *state * 6364136223846793005ULL + 1442695040888963407ULL;
+    return *state >> 33;
+}
+
+/* Random rubble up to a random height, one gap per row */
+static void fill_board(GameState *game, uint64_t *state)
+{
+    int height = (int)(next_random(state) % BOARD_HEIGHT);
+
+    for (int y = 0; y < BOARD_HEIGHT; y++) {
+        int gap = (int)(next_random(state) % BOARD_WIDTH);
+        for (int x = 0; x < BOARD_WIDTH; x++) {
+            int filled = y >= BOARD_HEIGHT - height && x != gap && next_random(state) % 4 != 0;
+            game->board.cells[y][x] = filled ? COLOR_Z : 0;
+        }
+    }
+    game_board_sync(&game->board);
+}
+
+int main(int argc, char **argv)
+{
+    unsigned long evals = DEFAULT_EVALS;
+    if (argc > 1) {
+        evals = strtoul(argv[1], NULL, 10);
+    }
+
+    static GameState games[BOARDS];
+    uint64_t state = 0x5eed;
+    for (int b = 0; b < BOARDS; b++) {
+        game_init_seeded(&games[b], (uint64_t)b);
+        fill_board(&games[b], &state);
+    }
+
+    /* Fold the sums into a checksum so neither loop is optimized away */
+    unsigned long check_reference = 0;
+    unsigned long check_table = 0;
+    EvalRowSums sums;
+
+    uint64_t start = now_ns();
+    for (unsigned long i = 0; i < evals; i++) {
+        reference_rows(&games[i % BOARDS].board, &sums);
+        check_reference += (unsigned long)(sums.filled + sums.row_transitions + sums.gaps + sums.well_cells);
+    }
+    uint64_t reference_ns = now_ns() - start;
+
+    start = now_ns();
+    for (unsigned long i = 0; i < evals; i++) {
+        eval_rows(&games[i % BOARDS].board, &sums);
+        check_table += (unsigned long)(sums.filled + sums.row_transitions + sums.gaps + sums.well_cells);
+    }
+    uint64_t table_ns = now_ns() - start;
+
+    printf("\n=== Row Evaluation Benchmark (%lu boards of %d rows) ===\n\n", evals, BOARD_HEIGHT);
+    printf("%-28s %8.2f ns/board\n", "per-cell loops:", (double)reference_ns / (double)evals);
+    printf("%-28s %8.2f ns/board\n", "row lookup tables:", (double)table_ns / (double)evals);
+    printf("%-28s %8.2fx\n", "speedup:", (double)reference_ns / (double)table_ns);
+
+    if (check_table != check_reference) {
+        fprintf(stderr, "Mismatch: reference checksum %lu, table checksum %lu\n",
+                check_reference, check_table);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,73 @@
+/**
+ * @file bench_session_host.c
+ * @brief Tick duration benchmark for the multi-session host
+ *
+ * Hosts growing numbers of scripted headless games on a thread pool
+ * with one worker per CPU and reports tick duration percentiles for
+ * each session count. Ticks run back to back, so the numbers show the
+ * cost of one tick rather than the 60 Hz schedule.
+ *
+ * Usage: bench_session_host [ticks]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "../src/session_host.h"
+
+#define DEFAULT_TICKS 120
+
+static const size_t session_counts[] = { 1000, 2500, 5000, 10000, 20000 };
+
+int main(int argc, char **argv)
+{
+    unsigned long ticks = DEFAULT_TICKS;
+    if (argc > 1) {
+        ticks = strtoul(argv[1], NULL, 10);
+    }
+
+    ThreadPool *pool = threadpool_create(NULL);
+    if (pool == NULL) {
+        fprintf(stderr, "Failed to create thread pool\n");
+        return 1;
+    }
+
+    printf("\n=== Session Host Benchmark (%d workers, %lu ticks) ===\n\n",
+           threadpool_size(pool), ticks);
+    printf("%9s %10s %10s %10s %10s %12s %10s\n",
+           "sessions", "p50 us", "p90 us", "p99 us", "max us", "ns/session", "60Hz load");
+
+    for (size_t c = 0; c < sizeof(session_counts) / sizeof(session_counts[0]); c++) {
+        size_t count = session_counts[c];
+        SessionHostConfig config = { pool, NULL, NULL, 0, 1, NULL };
+        SessionHost *host = session_host_create(&config);
+        if (host == NULL) {
+            break;
+        }
+        for (size_t i = 0; i < count; i++) {
+            session_host_create_session(host, (uint64_t)i);
+        }
+
+        /* Warm up caches and let the games fill their boards a little */
+        for (int t = 0; t < 10; t++) {
+            session_host_tick(host);
+        }
+        session_host_reset_stats(host);
+        for (unsigned long t = 0; t < ticks; t++) {
+            session_host_tick(host);
+        }
+
+        SessionTickStats stats;
+        session_host_tick_stats(host, &stats);
+        printf("%9zu %10.1f %10.1f %10.1f %10.1f %12.1f %9.1f%%\n",
+               count,
+               (double)stats.p50 / 1e3, (double)stats.p90 / 1e3,
+               (double)stats.p99 / 1e3, (double)stats.max / 1e3,
+               (double)stats.p50 / (double)count,
+               100.0 * (double)stats.p50 / (double)SESSION_DEFAULT_TICK_NS);
+
+        session_host_destroy(host);
+    }
+
+    threadpool_destroy(pool);
+    return 0;
+}
@@ -0,0 +1,319 @@
+/**
+ * @file book.c
+ * @brief Opening book file, lookup and builder
+ */
+
+#include "book.h"
+#include "canon.h"
+
+#include <assert.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+/**
+ * @brief File signature
+ */
+static const char BOOK_MAGIC[8] = { 'T', 'E', 'T', 'R', 'B', 'O', 'O', 'K' };
+
+/**
+ * @brief Interpolation steps before the lookup falls back to bisection
+ */
+#define INTERPOLATION_STEPS 8
+
+typedef struct {
+    char magic[8];
+    uint32_t version;
+    uint32_t entry_size;        /**< sizeof(BookEntry), guards against layout changes */
+    uint64_t count;
+} BookHeader;
+
+typedef struct {
+    uint64_t key;
+    Placement placement;        /**< In canonical orientation */
+    unsigned char reserved[5];
+} BookEntry;
+
+_Static_assert(sizeof(BookHeader) % 8 == 0, "Entries must stay aligned");
+_Static_assert(sizeof(BookEntry) == 16, "Entry layout is part of the file format");
+
+struct OpeningBook {
+    void *mapping;
+    size_t mapping_size;
+    const BookEntry *entries;
+    size_t count;
+};
+
+struct BookBuilder {
+    BookEntry *entries;
+    size_t count;
+    size_t capacity;
+};
+
+/**
+ * @brief Mixes a value into a running hash (splitmix64 finalizer)
+ */
+static uint64_t mix(uint64_t hash, uint64_t value)
+{
+    hash ^= value + 0x9E3779B97F4A7C15ULL + (hash << 6) + (hash >> 2);
+    hash ^= hash >> 30;
+    hash *= 0xBF58476D1CE4E5B9ULL;
+    hash ^= hash >> 27;
+    hash *= 0x94D049BB133111EBULL;
+    return hash ^ (hash >> 31);
+}
+
+uint64_t book_key(const GameState *game, int *mirrored)
+{
+    assert(game != NULL);
+    
+    static _Thread_local GameState canonical;
+    int flipped = canon_state(game, &canonical);
+    
+    uint64_t hash = 0;
+    for (int y = 0; y < BOARD_HEIGHT; y++) {
+        hash = mix(hash, canonical.board.rows[y + BOARD_PAD]);
+    }
+    hash = mix(hash, (uint64_t)canonical.current.type << 16 |
+                     (uint64_t)canonical.next.type << 8 | (uint64_t)canonical.hold);
+    
+    if (mirrored != NULL) {
+        *mirrored = flipped;
+    }
+    return hash;
+}
+
+/**
+ * @brief Maps a placement of @p type between the two orientations
+ */
+static Placement mirror_placement(TetrominoType type, const Placement *placement)
+{
+    Tetromino t = { type, placement->x, placement->y, placement->rotation };
+    Tetromino m = canon_mirror_piece(&t);
+    return (Placement){ (signed char)m.x, (signed char)m.y, (signed char)m.rotation };
+}
+
+OpeningBook *book_open(const char *path)
+{
+    assert(path != NULL);
+    
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        return NULL;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 || (size_t)info.st_size < sizeof(BookHeader)) {
+        close(fd);
+        return NULL;
+    }
+    
+    size_t size = (size_t)info.st_size;
+    void *mapping = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapping == MAP_FAILED) {
+        return NULL;
+    }
+    
+    const BookHeader *header = mapping;
+    if (memcmp(header->magic, BOOK_MAGIC, sizeof(BOOK_MAGIC)) != 0 ||
+        header->version != BOOK_VERSION || header->entry_size != sizeof(BookEntry) ||
+        header->count != (size - sizeof(BookHeader)) / sizeof(BookEntry)) {
+        munmap(mapping, size);
+        return NULL;
+    }
+    
+    OpeningBook *book = malloc(sizeof(*book));
+    if (book == NULL) {
+        munmap(mapping, size);
+        return NULL;
+    }
+    book->mapping = mapping;
+    book->mapping_size = size;
+    book->entries = (const BookEntry *)((const char *)mapping + sizeof(BookHeader));
+    book->count = (size_t)header->count;
+    /* Lookups jump around the whole table */
+    posix_madvise(mapping, size, POSIX_MADV_RANDOM);
+    return book;
+}
+
+void book_close(OpeningBook *book)
+{
+    if (book == NULL) {
+        return;
+    }
+    munmap(book->mapping, book->mapping_size);
+    free(book);
+}
+
+size_t book_size(const OpeningBook *book)
+{
+    assert(book != NULL);
+    return book->count;
+}
+
+/**
+ * @brief Finds a key in the sorted entries
+ * @return Entry, or NULL if the key is not in the book
+ */
+static const BookEntry *find(const OpeningBook *book, uint64_t key)
+{
+    const BookEntry *entries = book->entries;
+    size_t low = 0;
+    size_t high = book->count;      /* Search [low, high) */
+    
+    /* Hash keys are spread evenly, so interpolation lands close */
+    for (int step = 0; step < INTERPOLATION_STEPS && high - low > 2; step++) {
+        uint64_t first = entries[low].key;
+        uint64_t last = entries[high - 1].key;
+        if (key < first || key > last) {
+            return NULL;
+        }
+        double fraction = (double)(key - first) / ((double)(last - first) + 1.0);
+        size_t guess = low + (size_t)(fraction * (double)(high - low));
+        if (guess >= high) {
+            guess = high - 1;
+        }
+        if (entries[guess].key == key) {
+            return &entries[guess];
+        }
+        if (entries[guess].key < key) {
+            low = guess + 1;
+        } else {
+            high = guess;
+        }
+    }
+    
+    while (low < high) {
+        size_t middle = low + (high - low) / 2;
+        if (entries[middle].key < key) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    return low < book->count && entries[low].key == key ? &entries[low] : NULL;
+}
+
+int book_lookup(const OpeningBook *book, const GameState *game, Placement *out)
+{
+    assert(book != NULL && game != NULL && out != NULL);
+    
+    int mirrored;
+    const BookEntry *entry = find(book, book_key(game, &mirrored));
+    if (entry == NULL) {
+        return 0;
+    }
+    *out = mirrored
+         ? mirror_placement(canon_mirror_type(game->current.type), &entry->placement)
+         : entry->placement;
+    return 1;
+}
+
+BookBuilder *book_builder_create(void)
+{
+    return calloc(1, sizeof(BookBuilder));
+}
+
+void book_builder_destroy(BookBuilder *builder)
+{
+    if (builder == NULL) {
+        return;
+    }
+    free(builder->entries);
+    free(builder);
+}
+
+int book_builder_add(BookBuilder *builder, const GameState *game, const Placement *placement)
+{
+    assert(builder != NULL && game != NULL && placement != NULL);
+    
+    if (builder->count == UINT32_MAX) {
+        /* The insertion order must fit in the reserved bytes */
+        return 0;
+    }
+    if (builder->count == builder->capacity) {
+        size_t capacity = builder->capacity != 0 ? 2 * builder->capacity : 1024;
+        BookEntry *entries = realloc(builder->entries, capacity * sizeof(*entries));
+        if (entries == NULL) {
+            return 0;
+        }
+        builder->entries = entries;
+        builder->capacity = capacity;
+    }
+    
+    int mirrored;
+    BookEntry *entry = &builder->entries[builder->count++];
+    memset(entry, 0, sizeof(*entry));
+    entry->key = book_key(game, &mirrored);
+    entry->placement = mirrored ? mirror_placement(game->current.type, placement) : *placement;
+    return 1;
+}
+
+/**
+ * @brief Insertion index the builder keeps in an entry's reserved bytes
+ */
+static uint32_t entry_order(const BookEntry *entry)
+{
+    uint32_t order;
+    memcpy(&order, entry->reserved, sizeof(order));
+    return order;
+}
+
+/**
+ * @brief Orders entries by key, then by insertion so the first one wins
+ */
+static int compare_entries(const void *a, const void *b)
+{
+    const BookEntry *p = a;
+    const BookEntry *q = b;
+    if (p->key != q->key) {
+        return p->key < q->key ? -1 : 1;
+    }
+    uint32_t p_order = entry_order(p);
+    uint32_t q_order = entry_order(q);
+    return p_order < q_order ? -1 : p_order > q_order;
+}
+
+long book_builder_write(BookBuilder *builder, const char *path)
+{
+    assert(builder != NULL && path != NULL);
+    
+    /* qsort is not stable; tag entries with their insertion order */
+    for (size_t i = 0; i < builder->count; i++) {
+        uint32_t order = (uint32_t)i;
+        memcpy(builder->entries[i].reserved, &order, sizeof(order));
+    }
+    qsort(builder->entries, builder->count, sizeof(BookEntry), compare_entries);
+    
+    size_t unique = 0;
+    for (size_t i = 0; i < builder->count; i++) {
+        if (unique == 0 || builder->entries[unique - 1].key != builder->entries[i].key) {
+            builder->entries[unique++] = builder->entries[i];
+        }
+    }
+    builder->count = unique;
+    for (size_t i = 0; i < unique; i++) {
+        memset(builder->entries[i].reserved, 0, sizeof(builder->entries[i].reserved));
+    }
+    
+    FILE *file = fopen(path, "wb");
+    if (file == NULL) {
+        return -1;
+    }
+    BookHeader header;
+    memcpy(header.magic, BOOK_MAGIC, sizeof(BOOK_MAGIC));
+    header.version = BOOK_VERSION;
+    header.entry_size = sizeof(BookEntry);
+    header.count = unique;
+    
+    int failed = fwrite(&header, sizeof(header), 1, file) != 1 ||
+                 fwrite(builder->entries, sizeof(BookEntry), unique, file) != unique;
+    if (fclose(file) != 0 || failed) {
+        return -1;
+    }
+    return (long)unique;
+}
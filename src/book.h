@@ -0,0 +1,138 @@
+/**
+ * @file book.h
+ * @brief Memory-mapped opening book for early-game bot decisions
+ *
+ * The first pieces of a game start from an empty board and the same
+ * positions come up again and again. An opening book stores the best
+ * placement found offline for each of them, so a bot can answer those
+ * positions without searching.
+ *
+ * A book file is a header followed by entries sorted by key. The key
+ * hashes the position in canonical orientation (see canon.h) together
+ * with the queue: current, next and hold piece types. Mirrored
+ * positions therefore share an entry. book_open() maps the file
+ * read-only and book_lookup() finds a key by interpolation search,
+ * which suits the uniformly spread hash keys, with a binary search
+ * fallback.
+ *
+ * Files use the byte order of the machine that wrote them.
+ *
+ * @author Tetris CLI Project
+ * @version 1.0
+ */
+
+#ifndef BOOK_H
+#define BOOK_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "game.h"
+#include "placement.h"
+
+/**
+ * @brief File format version in the header
+ */
+#define BOOK_VERSION 1
+
+/**
+ * @brief Pieces per game the tools record into and play from a book
+ */
+#define BOOK_DEPTH 10
+
+/**
+ * @brief Opaque handle of a mapped book
+ */
+typedef struct OpeningBook OpeningBook;
+
+/**
+ * @brief Opaque handle of a book under construction
+ */
+typedef struct BookBuilder BookBuilder;
+
+/**
+ * @brief Computes the book key of a position
+ *
+ * @param game Position with its current, next and hold piece
+ * @param mirrored Output: 1 if the key was taken from the mirror image
+ *                 (may be NULL)
+ * @return 64-bit key
+ */
+uint64_t book_key(const GameState *game, int *mirrored);
+
+/**
+ * @brief Maps a book file
+ *
+ * @param path Book file written by book_builder_write()
+ * @return Book, or NULL if the file cannot be read or is not a book
+ */
+OpeningBook *book_open(const char *path);
+
+/**
+ * @brief Unmaps the book
+ *
+ * @param book Book to close (NULL is ignored)
+ */
+void book_close(OpeningBook *book);
+
+/**
+ * @brief Gets the number of entries
+ *
+ * @param book Pointer to book
+ * @return Entry count
+ */
+size_t book_size(const OpeningBook *book);
+
+/**
+ * @brief Looks up the stored placement of the current piece
+ *
+ * The placement is mapped back from canonical orientation. It comes
+ * from a hash, so callers should check that it is a legal resting
+ * position before playing it.
+ *
+ * @param book Pointer to book
+ * @param game Position to look up
+ * @param out Output placement
+ * @return 1 if the position is in the book, 0 otherwise
+ *
+ * @note Thread safety: reads only; any number of threads may share a book.
+ */
+int book_lookup(const OpeningBook *book, const GameState *game, Placement *out);
+
+/**
+ * @brief Creates an empty builder
+ *
+ * @return New builder, or NULL if allocation failed
+ */
+BookBuilder *book_builder_create(void);
+
+/**
+ * @brief Frees the builder
+ *
+ * @param builder Builder to destroy (NULL is ignored)
+ */
+void book_builder_destroy(BookBuilder *builder);
+
+/**
+ * @brief Records the placement chosen for a position
+ *
+ * When a position is recorded more than once, the first placement is
+ * kept.
+ *
+ * @param builder Pointer to builder
+ * @param game Position the decision was made in
+ * @param placement Placement chosen for the current piece
+ * @return 1 on success, 0 if out of memory or UINT32_MAX positions
+ *         were already recorded
+ */
+int book_builder_add(BookBuilder *builder, const GameState *game, const Placement *placement);
+
+/**
+ * @brief Sorts the recorded positions and writes the book file
+ *
+ * @param builder Pointer to builder
+ * @param path Output file (replaced if it exists)
+ * @return Number of entries written, or -1 if writing failed
+ */
+long book_builder_write(BookBuilder *builder, const char *path);
+
+#endif /* BOOK_H */
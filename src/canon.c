@@ -0,0 +1,157 @@
+/**
+ * @file canon.c
+ * @brief Mirror tables and canonical orientation
+ */
+
+#include "canon.h"
+
+#include <assert.h>
+
+static const TetrominoType mirror_types[TETRO_COUNT] = {
+    [TETRO_I] = TETRO_I,
+    [TETRO_O] = TETRO_O,
+    [TETRO_T] = TETRO_T,
+    [TETRO_S] = TETRO_Z,
+    [TETRO_Z] = TETRO_S,
+    [TETRO_J] = TETRO_L,
+    [TETRO_L] = TETRO_J
+};
+
+static const int mirror_colors[COLOR_L + 1] = {
+    0, COLOR_I, COLOR_O, COLOR_T, COLOR_Z, COLOR_S, COLOR_L, COLOR_J
+};
+
+/**
+ * @brief Mirrored rotation and column sum per type and rotation
+ *
+ * The mirror of a piece at column x has the given rotation and sits at
+ * column (sum - x); its row is unchanged.
+ */
+static const struct {
+    int rotation;
+    int column_sum;
+} mirror_pieces[TETRO_COUNT][ROTATION_COUNT] = {
+    [TETRO_I] = { { 0, 6 }, { 1, 5 }, { 0, 6 }, { 1, 5 } },
+    [TETRO_O] = { { 0, 6 }, { 0, 6 }, { 0, 6 }, { 0, 6 } },
+    [TETRO_T] = { { 0, 7 }, { 3, 7 }, { 2, 7 }, { 1, 7 } },
+    [TETRO_S] = { { 0, 7 }, { 1, 6 }, { 0, 7 }, { 1, 6 } },
+    [TETRO_Z] = { { 0, 7 }, { 1, 6 }, { 0, 7 }, { 1, 6 } },
+    [TETRO_J] = { { 0, 7 }, { 3, 7 }, { 2, 7 }, { 1, 7 } },
+    [TETRO_L] = { { 0, 7 }, { 3, 7 }, { 2, 7 }, { 1, 7 } }
+};
+
+_Static_assert(BOARD_WIDTH == 10, "The piece table is for 10-wide boards");
+
+TetrominoType canon_mirror_type(TetrominoType type)
+{
+    assert(tetromino_type_is_valid(type));
+    return mirror_types[type];
+}
+
+int canon_mirror_color(int color)
+{
+    assert(color >= 0 && color <= COLOR_L);
+    return mirror_colors[color];
+}
+
+unsigned int canon_mirror_row(unsigned int pattern)
+{
+    /* Reverse all 32 bits, then move the row back to the low bits */
+    uint32_t bits = pattern;
+    bits = ((bits >> 1) & 0x55555555u) | ((bits & 0x55555555u) << 1);
+    bits = ((bits >> 2) & 0x33333333u) | ((bits & 0x33333333u) << 2);
+    bits = ((bits >> 4) & 0x0F0F0F0Fu) | ((bits & 0x0F0F0F0Fu) << 4);
+    bits = ((bits >> 8) & 0x00FF00FFu) | ((bits & 0x00FF00FFu) << 8);
+    bits = (bits >> 16) | (bits << 16);
+    return bits >> (32 - BOARD_WIDTH);
+}
+
+Tetromino canon_mirror_piece(const Tetromino *t)
+{
+    assert(t != NULL);
+    assert(tetromino_type_is_valid(t->type) && tetromino_rotation_is_valid(t->rotation));
+    
+    Tetromino mirrored = {
+        .type = mirror_types[t->type],
+        .x = mirror_pieces[t->type][t->rotation].column_sum - t->x,
+        .y = t->y,
+        .rotation = mirror_pieces[t->type][t->rotation].rotation
+    };
+    return mirrored;
+}
+
+void canon_mirror_board(const Board *board, Board *out)
+{
+    assert(board != NULL && out != NULL && board != out);
+    
+    for (int y = 0; y < BOARD_HEIGHT; y++) {
+        for (int x = 0; x < BOARD_WIDTH; x++) {
+            out->cells[y][BOARD_WIDTH - 1 - x] = canon_mirror_color(board->cells[y][x]);
+        }
+    }
+    game_board_sync(out);
+}
+
+/**
+ * @brief Cell bits of a board row
+ */
+static unsigned int row_pattern(const Board *board, int y)
+{
+    return (board->rows[y + BOARD_PAD] >> BOARD_PAD) & ((1u << BOARD_WIDTH) - 1);
+}
+
+int canon_board_order(const Board *board)
+{
+    assert(board != NULL);
+    
+    for (int y = BOARD_HEIGHT - 1; y >= 0; y--) {
+        unsigned int pattern = row_pattern(board, y);
+        unsigned int mirrored = canon_mirror_row(pattern);
+        if (pattern != mirrored) {
+            return pattern < mirrored ? -1 : 1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief Piece types of a state packed for comparison
+ */
+static unsigned int piece_order(TetrominoType current, TetrominoType next, TetrominoType hold)
+{
+    return ((unsigned int)current << 8) | ((unsigned int)next << 4) | (unsigned int)hold;
+}
+
+int canon_state(const GameState *game, GameState *out)
+{
+    assert(game != NULL && out != NULL && game != out);
+    
+    *out = *game;
+    int order = canon_board_order(&game->board);
+    
+    TetrominoType hold = game->hold;
+    TetrominoType mirrored_hold = tetromino_type_is_valid(hold) ? mirror_types[hold] : hold;
+    if (order == 0) {
+        /* Symmetric board: the piece types decide */
+        unsigned int plain = piece_order(game->current.type, game->next.type, hold);
+        unsigned int mirrored = piece_order(mirror_types[game->current.type],
+                                            mirror_types[game->next.type], mirrored_hold);
+        order = mirrored < plain ? 1 : -1;
+    }
+    if (order < 0) {
+        return 0;
+    }
+    
+    canon_mirror_board(&game->board, &out->board);
+    out->current = canon_mirror_piece(&game->current);
+    /* The next piece only matters by type and always spawns the same way */
+    out->next = tetromino_create(mirror_types[game->next.type]);
+    out->hold = mirrored_hold;
+    out->bag = 0;
+    for (int type = 0; type < TETRO_COUNT; type++) {
+        if (game->bag & (1u << type)) {
+            out->bag |= 1u << mirror_types[type];
+        }
+    }
+    return 1;
+}
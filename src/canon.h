@@ -0,0 +1,92 @@
+/**
+ * @file canon.h
+ * @brief Mirror canonicalization of boards, pieces and game states
+ *
+ * A board and its horizontal mirror, with S and Z as well as J and L
+ * swapped, are strategically the same position. This module mirrors
+ * row masks (bit reversal), piece types, colors and pieces, and picks
+ * one of the two orientations as the canonical form, so search
+ * transposition tables, opening books and datasets can store mirrored
+ * states once.
+ *
+ * The canonical orientation is the one whose row patterns, read from
+ * the bottom row up, compare smaller; a symmetric board is broken by
+ * the piece types. All functions are pure and may run concurrently.
+ *
+ * @author Tetris CLI Project
+ * @version 1.0
+ */
+
+#ifndef CANON_H
+#define CANON_H
+
+#include "game.h"
+
+/**
+ * @brief Gets the piece type that mirrors @p type
+ *
+ * @param type Piece type
+ * @return S for Z, Z for S, J for L, L for J, @p type otherwise
+ */
+TetrominoType canon_mirror_type(TetrominoType type);
+
+/**
+ * @brief Gets the cell color of the mirrored piece type
+ *
+ * @param color Cell value (0 = empty, 1-7 = COLOR_*)
+ * @return Color of the mirrored type, 0 for empty cells
+ */
+int canon_mirror_color(int color);
+
+/**
+ * @brief Mirrors a row pattern
+ *
+ * @param pattern Row cells, bit x = column x filled (BOARD_WIDTH bits)
+ * @return Pattern with column x moved to BOARD_WIDTH - 1 - x
+ */
+unsigned int canon_mirror_row(unsigned int pattern);
+
+/**
+ * @brief Mirrors a piece
+ *
+ * The result has the mirrored type and covers the mirrored cells; it
+ * is valid on the mirrored board exactly when @p t is valid on the
+ * original.
+ *
+ * @param t Piece to mirror
+ * @return Mirrored piece
+ */
+Tetromino canon_mirror_piece(const Tetromino *t);
+
+/**
+ * @brief Mirrors a board, colors included
+ *
+ * @param board Board to mirror
+ * @param out Output board (masks and features rebuilt; may not alias @p board)
+ */
+void canon_mirror_board(const Board *board, Board *out);
+
+/**
+ * @brief Compares a board with its mirror image
+ *
+ * @param board Pointer to Board
+ * @return Negative if the board is canonical, positive if its mirror
+ *         is, 0 if it is symmetric
+ */
+int canon_board_order(const Board *board);
+
+/**
+ * @brief Brings the position of a game into canonical orientation
+ *
+ * Mirrors board, current piece, the next and hold types and the bag
+ * when the mirror is the canonical form. Everything else, the random
+ * generator included, is copied unchanged, so the result is meant for
+ * keys and datasets, not for playing on.
+ *
+ * @param game Game to canonicalize
+ * @param out Output state (may not alias @p game)
+ * @return 1 if @p out is mirrored, 0 if it is a copy
+ */
+int canon_state(const GameState *game, GameState *out);
+
+#endif /* CANON_H */
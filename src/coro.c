@@ -0,0 +1,545 @@
+/**
+ * @file coro.c
+ * @brief Stackful coroutine scheduler implementation
+ */
+
+#define _GNU_SOURCE
+
+#include "coro.h"
+
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
+#if defined(__x86_64__)
+#define CORO_ASM_SWITCH 1
+#else
+#define CORO_ASM_SWITCH 0
+#include <ucontext.h>
+#endif
+
+/**
+ * @brief Marks a coroutine that is not in the timer heap
+ */
+#define NOT_IN_HEAP SIZE_MAX
+
+/**
+ * @brief Lifecycle of a coroutine
+ */
+typedef enum {
+    CORO_READY,     /**< In the ready queue */
+    CORO_RUNNING,   /**< Currently executing */
+    CORO_PARKED,    /**< Waiting for coro_wake() or its deadline */
+    CORO_DONE       /**< Body returned; slot is on the free list */
+} CoroStatus;
+
+struct Coro {
+#if CORO_ASM_SWITCH
+    void *sp;                   /**< Saved stack pointer while suspended */
+#else
+    ucontext_t context;         /**< Saved context while suspended */
+#endif
+    CoroScheduler *sched;       /**< Owning scheduler */
+    CoroFn fn;                  /**< Body */
+    void *arg;                  /**< Argument for fn */
+    CoroStatus status;          /**< Lifecycle state */
+    int woken;                  /**< 1 if the last park ended by coro_wake() */
+    uint64_t deadline;          /**< Park deadline (valid in the heap) */
+    size_t heap_index;          /**< Position in the timer heap */
+    void *mapping;              /**< Stack mapping including the guard page */
+    size_t mapping_size;        /**< Size of the mapping */
+    Coro *next;                 /**< Ready queue or free list link */
+};
+
+struct CoroScheduler {
+    size_t stack_size;          /**< Usable stack bytes per coroutine */
+    size_t page_size;           /**< Guard page size */
+    Coro *ready_head;           /**< Oldest ready coroutine */
+    Coro *ready_tail;           /**< Newest ready coroutine */
+    size_t ready_count;         /**< Coroutines in the ready queue */
+    Coro **timers;              /**< Min-heap of parked coroutines by deadline */
+    size_t timer_count;         /**< Entries in the heap */
+    size_t timer_capacity;      /**< Capacity of the heap */
+    Coro **all;                 /**< Every coroutine ever allocated */
+    size_t all_count;           /**< Entries in all */
+    size_t all_capacity;        /**< Capacity of all */
+    Coro *free_list;            /**< Finished coroutines with reusable stacks */
+    size_t live;                /**< Coroutines that have not finished */
+    uint64_t switches;          /**< Context switches performed */
+    Coro *current;              /**< Running coroutine */
+#if CORO_ASM_SWITCH
+    void *main_sp;              /**< Scheduler stack pointer while a coroutine runs */
+#else
+    ucontext_t main_context;    /**< Scheduler context while a coroutine runs */
+#endif
+};
+
+/**
+ * @brief Scheduler currently running a coroutine on this thread
+ */
+static _Thread_local CoroScheduler *running_sched = NULL;
+
+#if CORO_ASM_SWITCH
+/**
+ * @brief Saves callee-saved registers, stores the stack pointer in
+ *        @p save_sp, then restores the context found at @p load_sp
+ */
+void coro_switch_context(void **save_sp, void *load_sp);
+
+__asm__(
+    ".text\n"
+    ".globl coro_switch_context\n"
+    ".hidden coro_switch_context\n"
+    ".type coro_switch_context, @function\n"
+    ".p2align 4\n"
+    "coro_switch_context:\n"
+    "    pushq %rbp\n"
+    "    pushq %rbx\n"
+    "    pushq %r12\n"
+    "    pushq %r13\n"
+    "    pushq %r14\n"
+    "    pushq %r15\n"
+    "    movq %rsp, (%rdi)\n"
+    "    movq %rsi, %rsp\n"
+    "    popq %r15\n"
+    "    popq %r14\n"
+    "    popq %r13\n"
+    "    popq %r12\n"
+    "    popq %rbx\n"
+    "    popq %rbp\n"
+    "    ret\n"
+    ".size coro_switch_context, .-coro_switch_context\n");
+#endif
+
+uint64_t coro_now_ns(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000ULL + (uint64_t)now.tv_nsec;
+}
+
+/**
+ * @brief Switches from the running coroutine back to the scheduler
+ * @param sched Pointer to scheduler
+ */
+static void suspend(CoroScheduler *sched)
+{
+    Coro *coro = sched->current;
+#if CORO_ASM_SWITCH
+    coro_switch_context(&coro->sp, sched->main_sp);
+#else
+    swapcontext(&coro->context, &sched->main_context);
+#endif
+}
+
+/**
+ * @brief First function run on a new coroutine stack
+ *
+ * Never returns: after the body finishes it switches back to the
+ * scheduler, which recycles the stack.
+ */
+static void coro_entry(void)
+{
+    CoroScheduler *sched = running_sched;
+    Coro *coro = sched->current;
+
+    coro->fn(coro->arg);
+
+    coro->status = CORO_DONE;
+    sched->live--;
+    suspend(sched);
+    abort();    /* A finished coroutine is never resumed */
+}
+
+/**
+ * @brief Prepares a coroutine's stack so the next resume enters coro_entry
+ * @param coro Coroutine with an allocated stack
+ */
+static void prepare_context(Coro *coro)
+{
+    CoroScheduler *sched = coro->sched;
+    char *base = (char *)coro->mapping + sched->page_size;
+
+#if CORO_ASM_SWITCH
+    /*
+     * Build the frame coro_switch_context pops: six callee-saved
+     * registers, then the return address coro_entry. The dummy return
+     * address above it leaves rsp at 8 mod 16 on entry, as after a call.
+     */
+    uintptr_t top = ((uintptr_t)(base + sched->stack_size)) & ~(uintptr_t)15;
+    void **sp = (void **)top;
+    *--sp = NULL;
+    *--sp = (void *)(uintptr_t)coro_entry;
+    for (int i = 0; i < 6; i++) {
+        *--sp = NULL;
+    }
+    coro->sp = sp;
+#else
+    getcontext(&coro->context);
+    coro->context.uc_stack.ss_sp = base;
+    coro->context.uc_stack.ss_size = sched->stack_size;
+    coro->context.uc_link = NULL;
+    makecontext(&coro->context, coro_entry, 0);
+#endif
+}
+
+/**
+ * @brief Appends a coroutine to the ready queue
+ * @param sched Pointer to scheduler
+ * @param coro Coroutine to queue
+ */
+static void make_ready(CoroScheduler *sched, Coro *coro)
+{
+    coro->status = CORO_READY;
+    coro->next = NULL;
+    if (sched->ready_tail != NULL) {
+        sched->ready_tail->next = coro;
+    } else {
+        sched->ready_head = coro;
+    }
+    sched->ready_tail = coro;
+    sched->ready_count++;
+}
+
+/**
+ * @brief Removes the oldest coroutine from the ready queue
+ * @param sched Pointer to scheduler
+ * @return Coroutine, or NULL if the queue is empty
+ */
+static Coro *take_ready(CoroScheduler *sched)
+{
+    Coro *coro = sched->ready_head;
+    if (coro != NULL) {
+        sched->ready_head = coro->next;
+        if (sched->ready_head == NULL) {
+            sched->ready_tail = NULL;
+        }
+        sched->ready_count--;
+    }
+    return coro;
+}
+
+/**
+ * @brief Places a coroutine at a heap position and records it
+ * @param sched Pointer to scheduler
+ * @param index Heap position
+ * @param coro Coroutine
+ */
+static void heap_set(CoroScheduler *sched, size_t index, Coro *coro)
+{
+    sched->timers[index] = coro;
+    coro->heap_index = index;
+}
+
+/**
+ * @brief Restores the heap property around one position
+ * @param sched Pointer to scheduler
+ * @param index Position whose deadline changed
+ */
+static void heap_fix(CoroScheduler *sched, size_t index)
+{
+    Coro **heap = sched->timers;
+    Coro *coro = heap[index];
+
+    /* Sift up */
+    while (index > 0) {
+        size_t parent = (index - 1) / 2;
+        if (heap[parent]->deadline <= coro->deadline) {
+            break;
+        }
+        heap_set(sched, index, heap[parent]);
+        index = parent;
+    }
+
+    /* Sift down */
+    for (;;) {
+        size_t child = index * 2 + 1;
+        if (child >= sched->timer_count) {
+            break;
+        }
+        if (child + 1 < sched->timer_count &&
+            heap[child + 1]->deadline < heap[child]->deadline) {
+            child++;
+        }
+        if (coro->deadline <= heap[child]->deadline) {
+            break;
+        }
+        heap_set(sched, index, heap[child]);
+        index = child;
+    }
+    heap_set(sched, index, coro);
+}
+
+/**
+ * @brief Adds a parked coroutine to the timer heap
+ * @param sched Pointer to scheduler
+ * @param coro Coroutine with its deadline set
+ * @return 1 on success, 0 if the heap could not grow
+ */
+static int heap_push(CoroScheduler *sched, Coro *coro)
+{
+    if (sched->timer_count == sched->timer_capacity) {
+        size_t capacity = sched->timer_capacity ? sched->timer_capacity * 2 : 64;
+        Coro **timers = realloc(sched->timers, capacity * sizeof(Coro *));
+        if (timers == NULL) {
+            return 0;
+        }
+        sched->timers = timers;
+        sched->timer_capacity = capacity;
+    }
+    heap_set(sched, sched->timer_count++, coro);
+    heap_fix(sched, coro->heap_index);
+    return 1;
+}
+
+/**
+ * @brief Removes a coroutine from the timer heap
+ * @param sched Pointer to scheduler
+ * @param coro Coroutine currently in the heap
+ */
+static void heap_remove(CoroScheduler *sched, Coro *coro)
+{
+    size_t index = coro->heap_index;
+    Coro *last = sched->timers[--sched->timer_count];
+
+    coro->heap_index = NOT_IN_HEAP;
+    if (last != coro) {
+        heap_set(sched, index, last);
+        heap_fix(sched, index);
+    }
+}
+
+/**
+ * @brief Switches into a coroutine until it yields, parks or finishes
+ * @param sched Pointer to scheduler
+ * @param coro Ready coroutine
+ */
+static void resume(CoroScheduler *sched, Coro *coro)
+{
+    coro->status = CORO_RUNNING;
+    sched->current = coro;
+    running_sched = sched;
+    sched->switches += 2;
+
+#if CORO_ASM_SWITCH
+    coro_switch_context(&sched->main_sp, coro->sp);
+#else
+    swapcontext(&sched->main_context, &coro->context);
+#endif
+
+    running_sched = NULL;
+    sched->current = NULL;
+
+    if (coro->status == CORO_DONE) {
+        coro->next = sched->free_list;
+        sched->free_list = coro;
+    }
+}
+
+/**
+ * @brief Allocates a coroutine with a guarded stack
+ * @param sched Pointer to scheduler
+ * @return New coroutine, or NULL if allocation failed
+ */
+static Coro *allocate(CoroScheduler *sched)
+{
+    if (sched->all_count == sched->all_capacity) {
+        size_t capacity = sched->all_capacity ? sched->all_capacity * 2 : 64;
+        Coro **all = realloc(sched->all, capacity * sizeof(Coro *));
+        if (all == NULL) {
+            return NULL;
+        }
+        sched->all = all;
+        sched->all_capacity = capacity;
+    }
+
+    Coro *coro = calloc(1, sizeof(Coro));
+    if (coro == NULL) {
+        return NULL;
+    }
+
+    /* Lowest page stays inaccessible so a stack overflow faults */
+    coro->mapping_size = sched->stack_size + sched->page_size;
+    coro->mapping = mmap(NULL, coro->mapping_size, PROT_READ | PROT_WRITE,
+                         MAP_PRIVATE | MAP_ANONYMOUS | MAP_STACK, -1, 0);
+    if (coro->mapping == MAP_FAILED) {
+        free(coro);
+        return NULL;
+    }
+    mprotect(coro->mapping, sched->page_size, PROT_NONE);
+
+    coro->sched = sched;
+    sched->all[sched->all_count++] = coro;
+    return coro;
+}
+
+CoroScheduler *coro_scheduler_create(size_t stack_size)
+{
+    CoroScheduler *sched = calloc(1, sizeof(CoroScheduler));
+    if (sched == NULL) {
+        return NULL;
+    }
+
+    long page = sysconf(_SC_PAGESIZE);
+    sched->page_size = page > 0 ? (size_t)page : 4096;
+    if (stack_size == 0) {
+        stack_size = CORO_DEFAULT_STACK_SIZE;
+    }
+    sched->stack_size = (stack_size + sched->page_size - 1) / sched->page_size * sched->page_size;
+    return sched;
+}
+
+void coro_scheduler_destroy(CoroScheduler *sched)
+{
+    if (sched == NULL) {
+        return;
+    }
+    assert(running_sched != sched);
+
+    for (size_t i = 0; i < sched->all_count; i++) {
+        munmap(sched->all[i]->mapping, sched->all[i]->mapping_size);
+        free(sched->all[i]);
+    }
+    free(sched->all);
+    free(sched->timers);
+    free(sched);
+}
+
+Coro *coro_spawn(CoroScheduler *sched, CoroFn fn, void *arg)
+{
+    assert(sched != NULL);
+    assert(fn != NULL);
+
+    Coro *coro = sched->free_list;
+    if (coro != NULL) {
+        sched->free_list = coro->next;
+    } else {
+        coro = allocate(sched);
+        if (coro == NULL) {
+            return NULL;
+        }
+    }
+
+    coro->fn = fn;
+    coro->arg = arg;
+    coro->woken = 0;
+    coro->heap_index = NOT_IN_HEAP;
+    prepare_context(coro);
+
+    sched->live++;
+    make_ready(sched, coro);
+    return coro;
+}
+
+size_t coro_scheduler_poll(CoroScheduler *sched)
+{
+    assert(sched != NULL);
+    assert(running_sched == NULL);
+
+    /* Expired timers join the ready queue behind what is already there */
+    if (sched->timer_count > 0) {
+        uint64_t now = coro_now_ns();
+        while (sched->timer_count > 0 && sched->timers[0]->deadline <= now) {
+            Coro *coro = sched->timers[0];
+            heap_remove(sched, coro);
+            coro->woken = 0;
+            make_ready(sched, coro);
+        }
+    }
+
+    size_t count = sched->ready_count;
+    for (size_t i = 0; i < count; i++) {
+        resume(sched, take_ready(sched));
+    }
+    return count;
+}
+
+void coro_scheduler_run(CoroScheduler *sched)
+{
+    assert(sched != NULL);
+
+    for (;;) {
+        coro_scheduler_poll(sched);
+        if (sched->ready_count > 0) {
+            continue;
+        }
+        if (sched->timer_count == 0) {
+            break;
+        }
+
+        uint64_t deadline = sched->timers[0]->deadline;
+        struct timespec wake = {
+            .tv_sec = (time_t)(deadline / 1000000000ULL),
+            .tv_nsec = (long)(deadline % 1000000000ULL)
+        };
+        clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &wake, NULL);
+    }
+}
+
+size_t coro_scheduler_live(const CoroScheduler *sched)
+{
+    assert(sched != NULL);
+    return sched->live;
+}
+
+uint64_t coro_scheduler_switches(const CoroScheduler *sched)
+{
+    assert(sched != NULL);
+    return sched->switches;
+}
+
+Coro *coro_current(void)
+{
+    return running_sched != NULL ? running_sched->current : NULL;
+}
+
+void coro_yield(void)
+{
+    CoroScheduler *sched = running_sched;
+    assert(sched != NULL);
+
+    make_ready(sched, sched->current);
+    suspend(sched);
+}
+
+int coro_park_until(uint64_t deadline_ns)
+{
+    CoroScheduler *sched = running_sched;
+    assert(sched != NULL);
+    Coro *coro = sched->current;
+
+    coro->status = CORO_PARKED;
+    coro->woken = 0;
+    if (deadline_ns != CORO_NO_DEADLINE) {
+        coro->deadline = deadline_ns;
+        if (!heap_push(sched, coro)) {
+            /* No room for the timer: behave like an immediate timeout */
+            make_ready(sched, coro);
+        }
+    }
+    suspend(sched);
+    return coro->woken;
+}
+
+void coro_sleep_ns(uint64_t duration_ns)
+{
+    coro_park_until(coro_now_ns() + duration_ns);
+}
+
+int coro_wake(Coro *coro)
+{
+    assert(coro != NULL);
+
+    if (coro->status != CORO_PARKED) {
+        return 0;
+    }
+    if (coro->heap_index != NOT_IN_HEAP) {
+        heap_remove(coro->sched, coro);
+    }
+    coro->woken = 1;
+    make_ready(coro->sched, coro);
+    return 1;
+}
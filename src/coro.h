@@ -0,0 +1,172 @@
+/**
+ * @file coro.h
+ * @brief Stackful coroutines for multiplexing sessions on one thread
+ *
+ * Lets one OS thread interleave thousands of sessions that spend most
+ * of their time waiting for input or for a timer, instead of parking
+ * one thread per game. Each coroutine has its own small stack (mmap'd
+ * with a guard page, recycled after the coroutine finishes) and runs
+ * until it yields, parks or returns.
+ *
+ * Switching is cooperative and always goes through the scheduler. On
+ * x86-64 a switch only saves the callee-saved registers and the stack
+ * pointer; elsewhere it falls back to swapcontext(), which also saves
+ * the signal mask and costs a system call.
+ *
+ * A scheduler and its coroutines belong to the thread that runs it.
+ * The coro_* functions without a scheduler argument must be called from
+ * inside a coroutine.
+ *
+ * @author Tetris CLI Project
+ * @version 1.0
+ */
+
+#ifndef CORO_H
+#define CORO_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief Default stack size per coroutine
+ */
+#define CORO_DEFAULT_STACK_SIZE (64 * 1024)
+
+/**
+ * @brief Deadline meaning "no timeout" for coro_park_until()
+ */
+#define CORO_NO_DEADLINE UINT64_MAX
+
+/**
+ * @brief Coroutine body
+ * @param arg User argument passed to coro_spawn()
+ */
+typedef void (*CoroFn)(void *arg);
+
+/**
+ * @brief Opaque coroutine handle
+ */
+typedef struct Coro Coro;
+
+/**
+ * @brief Opaque scheduler handle
+ */
+typedef struct CoroScheduler CoroScheduler;
+
+/**
+ * @brief Creates a scheduler
+ *
+ * @param stack_size Stack size per coroutine, 0 = CORO_DEFAULT_STACK_SIZE
+ * @return New scheduler, or NULL if allocation failed
+ */
+CoroScheduler *coro_scheduler_create(size_t stack_size);
+
+/**
+ * @brief Frees the scheduler and all coroutines
+ *
+ * Coroutines that have not finished are discarded without resuming.
+ *
+ * @param sched Scheduler to destroy (NULL is ignored)
+ */
+void coro_scheduler_destroy(CoroScheduler *sched);
+
+/**
+ * @brief Creates a coroutine and queues it to run
+ *
+ * May be called from outside or from inside a coroutine.
+ *
+ * @param sched Pointer to scheduler
+ * @param fn Coroutine body
+ * @param arg Argument for @p fn
+ * @return Coroutine handle (valid until @p fn returns), or NULL if the
+ *         stack could not be allocated
+ */
+Coro *coro_spawn(CoroScheduler *sched, CoroFn fn, void *arg);
+
+/**
+ * @brief Resumes ready coroutines and expired timers once
+ *
+ * Every coroutine that is ready when the call starts runs exactly once;
+ * coroutines made ready meanwhile wait for the next call. Use this to
+ * drive coroutines from an existing loop.
+ *
+ * @param sched Pointer to scheduler
+ * @return Number of coroutines resumed
+ */
+size_t coro_scheduler_poll(CoroScheduler *sched);
+
+/**
+ * @brief Runs until no coroutine is ready or sleeping
+ *
+ * Sleeps until the earliest timer when only timers are pending.
+ * Returns while coroutines are still parked without a deadline; they
+ * resume after coro_wake() and the next poll or run.
+ *
+ * @param sched Pointer to scheduler
+ */
+void coro_scheduler_run(CoroScheduler *sched);
+
+/**
+ * @brief Gets the number of coroutines that have not finished
+ *
+ * @param sched Pointer to scheduler
+ * @return Live coroutine count
+ */
+size_t coro_scheduler_live(const CoroScheduler *sched);
+
+/**
+ * @brief Gets the number of context switches performed so far
+ *
+ * Counts switches into and out of coroutines.
+ *
+ * @param sched Pointer to scheduler
+ * @return Switch count
+ */
+uint64_t coro_scheduler_switches(const CoroScheduler *sched);
+
+/**
+ * @brief Gets the running coroutine
+ *
+ * @return Current coroutine, or NULL outside a coroutine
+ */
+Coro *coro_current(void);
+
+/**
+ * @brief Lets the other ready coroutines run, then continues
+ */
+void coro_yield(void);
+
+/**
+ * @brief Suspends the current coroutine until woken or a deadline passes
+ *
+ * @param deadline_ns CLOCK_MONOTONIC deadline, or CORO_NO_DEADLINE
+ * @return 1 if woken by coro_wake(), 0 if the deadline passed
+ */
+int coro_park_until(uint64_t deadline_ns);
+
+/**
+ * @brief Suspends the current coroutine for a duration
+ *
+ * @param duration_ns Time to sleep in nanoseconds
+ */
+void coro_sleep_ns(uint64_t duration_ns);
+
+/**
+ * @brief Makes a parked coroutine ready
+ *
+ * Has no effect if @p coro is not parked. Must be called on the
+ * scheduler's thread (from a coroutine or from the driving loop).
+ *
+ * @param coro Coroutine to wake
+ * @return 1 if the coroutine was parked and is now ready, 0 otherwise
+ */
+int coro_wake(Coro *coro);
+
+/**
+ * @brief Reads the monotonic clock used for deadlines
+ *
+ * @return Current CLOCK_MONOTONIC time in ns
+ */
+uint64_t coro_now_ns(void);
+
+#endif /* CORO_H */
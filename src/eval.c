@@ -0,0 +1,331 @@
+/**
+ * @file eval.c
+ * @brief Row lookup tables and board evaluation
+ */
+
+#include "eval.h"
+
+#include <assert.h>
+#include <string.h>
+
+_Static_assert(BOARD_WIDTH == 10, "The row table covers 10-wide rows");
+
+const EvalWeights EVAL_DEFAULT_WEIGHTS = {
+    .aggregate_height = -1,
+    .holes = -8,
+    .row_transitions = -3,
+    .column_transitions = -9,
+    .gaps = -1,
+    .well_cells = -2
+};
+
+/**
+ * @brief Features per row pattern: filled, transitions, gaps, well cells, wells
+ */
+static const EvalRow ROWS[EVAL_ROW_PATTERNS] = {
+    {  0,  2, 1, 0, 0x000 }, {  1,  2, 1, 0, 0x000 }, {  1,  4, 2, 1, 0x001 }, {  2,  2, 1, 0, 0x000 },
+    {  1,  4, 2, 0, 0x000 }, {  2,  4, 2, 1, 0x002 }, {  2,  4, 2, 1, 0x001 }, {  3,  2, 1, 0, 0x000 },
+    {  1,  4, 2, 0, 0x000 }, {  2,  4, 2, 0, 0x000 }, {  2,  6, 3, 2, 0x005 }, {  3,  4, 2, 1, 0x004 },
+    {  2,  4, 2, 0, 0x000 }, {  3,  4, 2, 1, 0x002 }, {  3,  4, 2, 1, 0x001 }, {  4,  2, 1, 0, 0x000 },
+    {  1,  4, 2, 0, 0x000 }, {  2,  4, 2, 0, 0x000 }, {  2,  6, 3, 1, 0x001 }, {  3,  4, 2, 0, 0x000 },
+    {  2,  6, 3, 1, 0x008 }, {  3,  6, 3, 2, 0x00A }, {  3,  6, 3, 2, 0x009 }, {  4,  4, 2, 1, 0x008 },
+    {  2,  4, 2, 0, 0x000 }, {  3,  4, 2, 0, 0x000 }, {  3,  6, 3, 2, 0x005 }, {  4,  4, 2, 1, 0x004 },
+    {  3,  4, 2, 0, 0x000 }, {  4,  4, 2, 1, 0x002 }, {  4,  4, 2, 1, 0x001 }, {  5,  2, 1, 0, 0x000 },
+    {  1,  4, 2, 0, 0x000 }, {  2,  4, 2, 0, 0x000 }, {  2,  6, 3, 1, 0x001 }, {  3,  4, 2, 0, 0x000 },
+    {  2,  6, 3, 0, 0x000 }, {  3,  6, 3, 1, 0x002 }, {  3,  6, 3, 1, 0x001 }, {  4,  4, 2, 0, 0x000 },
+    {  2,  6, 3, 1, 0x010 }, {  3,  6, 3, 1, 0x010 }, {  3,  8, 4, 3, 0x015 }, {  4,  6, 3, 2, 0x014 },
+    {  3,  6, 3, 1, 0x010 }, {  4,  6, 3, 2, 0x012 }, {  4,  6, 3, 2, 0x011 }, {  5,  4, 2, 1, 0x010 },
+    {  2,  4, 2, 0, 0x000 }, {  3,  4, 2, 0, 0x000 }, {  3,  6, 3, 1, 0x001 }, {  4,  4, 2, 0, 0x000 },
+    {  3,  6, 3, 1, 0x008 }, {  4,  6, 3, 2, 0x00A }, {  4,  6, 3, 2, 0x009 }, {  5,  4, 2, 1, 0x008 },
+    {  3,  4, 2, 0, 0x000 }, {  4,  4, 2, 0, 0x000 }, {  4,  6, 3, 2, 0x005 }, {  5,  4, 2, 1, 0x004 },
+    {  4,  4, 2, 0, 0x000 }, {  5,  4, 2, 1, 0x002 }, {  5,  4, 2, 1, 0x001 }, {  6,  2, 1, 0, 0x000 },
+    {  1,  4, 2, 0, 0x000 }, {  2,  4, 2, 0, 0x000 }, {  2,  6, 3, 1, 0x001 }, {  3,  4, 2, 0, 0x000 },
+    {  2,  6, 3, 0, 0x000 }, {  3,  6, 3, 1, 0x002 }, {  3,  6, 3, 1, 0x001 }, {  4,  4, 2, 0, 0x000 },
+    {  2,  6, 3, 0, 0x000 }, {  3,  6, 3, 0, 0x000 }, {  3,  8, 4, 2, 0x005 }, {  4,  6, 3, 1, 0x004 },
+    {  3,  6, 3, 0, 0x000 }, {  4,  6, 3, 1, 0x002 }, {  4,  6, 3, 1, 0x001 }, {  5,  4, 2, 0, 0x000 },
+    {  2,  6, 3, 1, 0x020 }, {  3,  6, 3, 1, 0x020 }, {  3,  8, 4, 2, 0x021 }, {  4,  6, 3, 1, 0x020 },
+    {  3,  8, 4, 2, 0x028 }, {  4,  8, 4, 3, 0x02A }, {  4,  8, 4, 3, 0x029 }, {  5,  6, 3, 2, 0x028 },
+    {  3,  6, 3, 1, 0x020 }, {  4,  6, 3, 1, 0x020 }, {  4,  8, 4, 3, 0x025 }, {  5,  6, 3, 2, 0x024 },
+    {  4,  6, 3, 1, 0x020 }, {  5,  6, 3, 2, 0x022 }, {  5,  6, 3, 2, 0x021 }, {  6,  4, 2, 1, 0x020 },
+    {  2,  4, 2, 0, 0x000 }, {  3,  4, 2, 0, 0x000 }, {  3,  6, 3, 1, 0x001 }, {  4,  4, 2, 0, 0x000 },
+    {  3,  6, 3, 0, 0x000 }, {  4,  6, 3, 1, 0x002 }, {  4,  6, 3, 1, 0x001 }, {  5,  4, 2, 0, 0x000 },
+    {  3,  6, 3, 1, 0x010 }, {  4,  6, 3, 1, 0x010 }, {  4,  8, 4, 3, 0x015 }, {  5,  6, 3, 2, 0x014 },
+    {  4,  6, 3, 1, 0x010 }, {  5,  6, 3, 2, 0x012 }, {  5,  6, 3, 2, 0x011 }, {  6,  4, 2, 1, 0x010 },
+    {  3,  4, 2, 0, 0x000 }, {  4,  4, 2, 0, 0x000 }, {  4,  6, 3, 1, 0x001 }, {  5,  4, 2, 0, 0x000 },
+    {  4,  6, 3, 1, 0x008 }, {  5,  6, 3, 2, 0x00A }, {  5,  6, 3, 2, 0x009 }, {  6,  4, 2, 1, 0x008 },
+    {  4,  4, 2, 0, 0x000 }, {  5,  4, 2, 0, 0x000 }, {  5,  6, 3, 2, 0x005 }, {  6,  4, 2, 1, 0x004 },
+    {  5,  4, 2, 0, 0x000 }, {  6,  4, 2, 1, 0x002 }, {  6,  4, 2, 1, 0x001 }, {  7,  2, 1, 0, 0x000 },
+    {  1,  4, 2, 0, 0x000 }, {  2,  4, 2, 0, 0x000 }, {  2,  6, 3, 1, 0x001 }, {  3,  4, 2, 0, 0x000 },
+    {  2,  6, 3, 0, 0x000 }, {  3,  6, 3, 1, 0x002 }, {  3,  6, 3, 1, 0x001 }, {  4,  4, 2, 0, 0x000 },
+    {  2,  6, 3, 0, 0x000 }, {  3,  6, 3, 0, 0x000 }, {  3,  8, 4, 2, 0x005 }, {  4,  6, 3, 1, 0x004 },
+    {  3,  6, 3, 0, 0x000 }, {  4,  6, 3, 1, 0x002 }, {  4,  6, 3, 1, 0x001 }, {  5,  4, 2, 0, 0x000 },
+    {  2,  6, 3, 0, 0x000 }, {  3,  6, 3, 0, 0x000 }, {  3,  8, 4, 1, 0x001 }, {  4,  6, 3, 0, 0x000 },
+    {  3,  8, 4, 1, 0x008 }, {  4,  8, 4, 2, 0x00A }, {  4,  8, 4, 2, 0x009 }, {  5,  6, 3, 1, 0x008 },
+    {  3,  6, 3, 0, 0x000 }, {  4,  6, 3, 0, 0x000 }, {  4,  8, 4, 2, 0x005 }, {  5,  6, 3, 1, 0x004 },
+    {  4,  6, 3, 0, 0x000 }, {  5,  6, 3, 1, 0x002 }, {  5,  6, 3, 1, 0x001 }, {  6,  4, 2, 0, 0x000 },
+    {  2,  6, 3, 1, 0x040 }, {  3,  6, 3, 1, 0x040 }, {  3,  8, 4, 2, 0x041 }, {  4,  6, 3, 1, 0x040 },
+    {  3,  8, 4, 1, 0x040 }, {  4,  8, 4, 2, 0x042 }, {  4,  8, 4, 2, 0x041 }, {  5,  6, 3, 1, 0x040 },
+    {  3,  8, 4, 2, 0x050 }, {  4,  8, 4, 2, 0x050 }, {  4, 10, 5, 4, 0x055 }, {  5,  8, 4, 3, 0x054 },
+    {  4,  8, 4, 2, 0x050 }, {  5,  8, 4, 3, 0x052 }, {  5,  8, 4, 3, 0x051 }, {  6,  6, 3, 2, 0x050 },
+    {  3,  6, 3, 1, 0x040 }, {  4,  6, 3, 1, 0x040 }, {  4,  8, 4, 2, 0x041 }, {  5,  6, 3, 1, 0x040 },
+    {  4,  8, 4, 2, 0x048 }, {  5,  8, 4, 3, 0x04A }, {  5,  8, 4, 3, 0x049 }, {  6,  6, 3, 2, 0x048 },
+    {  4,  6, 3, 1, 0x040 }, {  5,  6, 3, 1, 0x040 }, {  5,  8, 4, 3, 0x045 }, {  6,  6, 3, 2, 0x044 },
+    {  5,  6, 3, 1, 0x040 }, {  6,  6, 3, 2, 0x042 }, {  6,  6, 3, 2, 0x041 }, {  7,  4, 2, 1, 0x040 },
+    {  2,  4, 2, 0, 0x000 }, {  3,  4, 2, 0, 0x000 }, {  3,  6, 3, 1, 0x001 }, {  4,  4, 2, 0, 0x000 },
+    {  3,  6, 3, 0, 0x000 }, {  4,  6, 3, 1, 0x002 }, {  4,  6, 3, 1, 0x001 }, {  5,  4, 2, 0, 0x000 },
+    {  3,  6, 3, 0, 0x000 }, {  4,  6, 3, 0, 0x000 }, {  4,  8, 4, 2, 0x005 }, {  5,  6, 3, 1, 0x004 },
+    {  4,  6, 3, 0, 0x000 }, {  5,  6, 3, 1, 0x002 }, {  5,  6, 3, 1, 0x001 }, {  6,  4, 2, 0, 0x000 },
+    {  3,  6, 3, 1, 0x020 }, {  4,  6, 3, 1, 0x020 }, {  4,  8, 4, 2, 0x021 }, {  5,  6, 3, 1, 0x020 },
+    {  4,  8, 4, 2, 0x028 }, {  5,  8, 4, 3, 0x02A }, {  5,  8, 4, 3, 0x029 }, {  6,  6, 3, 2, 0x028 },
+    {  4,  6, 3, 1, 0x020 }, {  5,  6, 3, 1, 0x020 }, {  5,  8, 4, 3, 0x025 }, {  6,  6, 3, 2, 0x024 },
+    {  5,  6, 3, 1, 0x020 }, {  6,  6, 3, 2, 0x022 }, {  6,  6, 3, 2, 0x021 }, {  7,  4, 2, 1, 0x020 },
+    {  3,  4, 2, 0, 0x000 }, {  4,  4, 2, 0, 0x000 }, {  4,  6, 3, 1, 0x001 }, {  5,  4, 2, 0, 0x000 },
+    {  4,  6, 3, 0, 0x000 }, {  5,  6, 3, 1, 0x002 }, {  5,  6, 3, 1, 0x001 }, {  6,  4, 2, 0, 0x000 },
+    {  4,  6, 3, 1, 0x010 }, {  5,  6, 3, 1, 0x010 }, {  5,  8, 4, 3, 0x015 }, {  6,  6, 3, 2, 0x014 },
+    {  5,  6, 3, 1, 0x010 }, {  6,  6, 3, 2, 0x012 }, {  6,  6, 3, 2, 0x011 }, {  7,  4, 2, 1, 0x010 },
+    {  4,  4, 2, 0, 0x000 }, {  5,  4, 2, 0, 0x000 }, {  5,  6, 3, 1, 0x001 }, {  6,  4, 2, 0, 0x000 },
+    {  5,  6, 3, 1, 0x008 }, {  6,  6, 3, 2, 0x00A }, {  6,  6, 3, 2, 0x009 }, {  7,  4, 2, 1, 0x008 },
+    {  5,  4, 2, 0, 0x000 }, {  6,  4, 2, 0, 0x000 }, {  6,  6, 3, 2, 0x005 }, {  7,  4, 2, 1, 0x004 },
+    {  6,  4, 2, 0, 0x000 }, {  7,  4, 2, 1, 0x002 }, {  7,  4, 2, 1, 0x001 }, {  8,  2, 1, 0, 0x000 },
+    {  1,  4, 2, 1, 0x200 }, {  2,  4, 2, 1, 0x200 }, {  2,  6, 3, 2, 0x201 }, {  3,  4, 2, 1, 0x200 },
+    {  2,  6, 3, 1, 0x200 }, {  3,  6, 3, 2, 0x202 }, {  3,  6, 3, 2, 0x201 }, {  4,  4, 2, 1, 0x200 },
+    {  2,  6, 3, 1, 0x200 }, {  3,  6, 3, 1, 0x200 }, {  3,  8, 4, 3, 0x205 }, {  4,  6, 3, 2, 0x204 },
+    {  3,  6, 3, 1, 0x200 }, {  4,  6, 3, 2, 0x202 }, {  4,  6, 3, 2, 0x201 }, {  5,  4, 2, 1, 0x200 },
+    {  2,  6, 3, 1, 0x200 }, {  3,  6, 3, 1, 0x200 }, {  3,  8, 4, 2, 0x201 }, {  4,  6, 3, 1, 0x200 },
+    {  3,  8, 4, 2, 0x208 }, {  4,  8, 4, 3, 0x20A }, {  4,  8, 4, 3, 0x209 }, {  5,  6, 3, 2, 0x208 },
+    {  3,  6, 3, 1, 0x200 }, {  4,  6, 3, 1, 0x200 }, {  4,  8, 4, 3, 0x205 }, {  5,  6, 3, 2, 0x204 },
+    {  4,  6, 3, 1, 0x200 }, {  5,  6, 3, 2, 0x202 }, {  5,  6, 3, 2, 0x201 }, {  6,  4, 2, 1, 0x200 },
+    {  2,  6, 3, 1, 0x200 }, {  3,  6, 3, 1, 0x200 }, {  3,  8, 4, 2, 0x201 }, {  4,  6, 3, 1, 0x200 },
+    {  3,  8, 4, 1, 0x200 }, {  4,  8, 4, 2, 0x202 }, {  4,  8, 4, 2, 0x201 }, {  5,  6, 3, 1, 0x200 },
+    {  3,  8, 4, 2, 0x210 }, {  4,  8, 4, 2, 0x210 }, {  4, 10, 5, 4, 0x215 }, {  5,  8, 4, 3, 0x214 },
+    {  4,  8, 4, 2, 0x210 }, {  5,  8, 4, 3, 0x212 }, {  5,  8, 4, 3, 0x211 }, {  6,  6, 3, 2, 0x210 },
+    {  3,  6, 3, 1, 0x200 }, {  4,  6, 3, 1, 0x200 }, {  4,  8, 4, 2, 0x201 }, {  5,  6, 3, 1, 0x200 },
+    {  4,  8, 4, 2, 0x208 }, {  5,  8, 4, 3, 0x20A }, {  5,  8, 4, 3, 0x209 }, {  6,  6, 3, 2, 0x208 },
+    {  4,  6, 3, 1, 0x200 }, {  5,  6, 3, 1, 0x200 }, {  5,  8, 4, 3, 0x205 }, {  6,  6, 3, 2, 0x204 },
+    {  5,  6, 3, 1, 0x200 }, {  6,  6, 3, 2, 0x202 }, {  6,  6, 3, 2, 0x201 }, {  7,  4, 2, 1, 0x200 },
+    {  2,  6, 3, 2, 0x280 }, {  3,  6, 3, 2, 0x280 }, {  3,  8, 4, 3, 0x281 }, {  4,  6, 3, 2, 0x280 },
+    {  3,  8, 4, 2, 0x280 }, {  4,  8, 4, 3, 0x282 }, {  4,  8, 4, 3, 0x281 }, {  5,  6, 3, 2, 0x280 },
+    {  3,  8, 4, 2, 0x280 }, {  4,  8, 4, 2, 0x280 }, {  4, 10, 5, 4, 0x285 }, {  5,  8, 4, 3, 0x284 },
+    {  4,  8, 4, 2, 0x280 }, {  5,  8, 4, 3, 0x282 }, {  5,  8, 4, 3, 0x281 }, {  6,  6, 3, 2, 0x280 },
+    {  3,  8, 4, 3, 0x2A0 }, {  4,  8, 4, 3, 0x2A0 }, {  4, 10, 5, 4, 0x2A1 }, {  5,  8, 4, 3, 0x2A0 },
+    {  4, 10, 5, 4, 0x2A8 }, {  5, 10, 5, 5, 0x2AA }, {  5, 10, 5, 5, 0x2A9 }, {  6,  8, 4, 4, 0x2A8 },
+    {  4,  8, 4, 3, 0x2A0 }, {  5,  8, 4, 3, 0x2A0 }, {  5, 10, 5, 5, 0x2A5 }, {  6,  8, 4, 4, 0x2A4 },
+    {  5,  8, 4, 3, 0x2A0 }, {  6,  8, 4, 4, 0x2A2 }, {  6,  8, 4, 4, 0x2A1 }, {  7,  6, 3, 3, 0x2A0 },
+    {  3,  6, 3, 2, 0x280 }, {  4,  6, 3, 2, 0x280 }, {  4,  8, 4, 3, 0x281 }, {  5,  6, 3, 2, 0x280 },
+    {  4,  8, 4, 2, 0x280 }, {  5,  8, 4, 3, 0x282 }, {  5,  8, 4, 3, 0x281 }, {  6,  6, 3, 2, 0x280 },
+    {  4,  8, 4, 3, 0x290 }, {  5,  8, 4, 3, 0x290 }, {  5, 10, 5, 5, 0x295 }, {  6,  8, 4, 4, 0x294 },
+    {  5,  8, 4, 3, 0x290 }, {  6,  8, 4, 4, 0x292 }, {  6,  8, 4, 4, 0x291 }, {  7,  6, 3, 3, 0x290 },
+    {  4,  6, 3, 2, 0x280 }, {  5,  6, 3, 2, 0x280 }, {  5,  8, 4, 3, 0x281 }, {  6,  6, 3, 2, 0x280 },
+    {  5,  8, 4, 3, 0x288 }, {  6,  8, 4, 4, 0x28A }, {  6,  8, 4, 4, 0x289 }, {  7,  6, 3, 3, 0x288 },
+    {  5,  6, 3, 2, 0x280 }, {  6,  6, 3, 2, 0x280 }, {  6,  8, 4, 4, 0x285 }, {  7,  6, 3, 3, 0x284 },
+    {  6,  6, 3, 2, 0x280 }, {  7,  6, 3, 3, 0x282 }, {  7,  6, 3, 3, 0x281 }, {  8,  4, 2, 2, 0x280 },
+    {  2,  4, 2, 1, 0x200 }, {  3,  4, 2, 1, 0x200 }, {  3,  6, 3, 2, 0x201 }, {  4,  4, 2, 1, 0x200 },
+    {  3,  6, 3, 1, 0x200 }, {  4,  6, 3, 2, 0x202 }, {  4,  6, 3, 2, 0x201 }, {  5,  4, 2, 1, 0x200 },
+    {  3,  6, 3, 1, 0x200 }, {  4,  6, 3, 1, 0x200 }, {  4,  8, 4, 3, 0x205 }, {  5,  6, 3, 2, 0x204 },
+    {  4,  6, 3, 1, 0x200 }, {  5,  6, 3, 2, 0x202 }, {  5,  6, 3, 2, 0x201 }, {  6,  4, 2, 1, 0x200 },
+    {  3,  6, 3, 1, 0x200 }, {  4,  6, 3, 1, 0x200 }, {  4,  8, 4, 2, 0x201 }, {  5,  6, 3, 1, 0x200 },
+    {  4,  8, 4, 2, 0x208 }, {  5,  8, 4, 3, 0x20A }, {  5,  8, 4, 3, 0x209 }, {  6,  6, 3, 2, 0x208 },
+    {  4,  6, 3, 1, 0x200 }, {  5,  6, 3, 1, 0x200 }, {  5,  8, 4, 3, 0x205 }, {  6,  6, 3, 2, 0x204 },
+    {  5,  6, 3, 1, 0x200 }, {  6,  6, 3, 2, 0x202 }, {  6,  6, 3, 2, 0x201 }, {  7,  4, 2, 1, 0x200 },
+    {  3,  6, 3, 2, 0x240 }, {  4,  6, 3, 2, 0x240 }, {  4,  8, 4, 3, 0x241 }, {  5,  6, 3, 2, 0x240 },
+    {  4,  8, 4, 2, 0x240 }, {  5,  8, 4, 3, 0x242 }, {  5,  8, 4, 3, 0x241 }, {  6,  6, 3, 2, 0x240 },
+    {  4,  8, 4, 3, 0x250 }, {  5,  8, 4, 3, 0x250 }, {  5, 10, 5, 5, 0x255 }, {  6,  8, 4, 4, 0x254 },
+    {  5,  8, 4, 3, 0x250 }, {  6,  8, 4, 4, 0x252 }, {  6,  8, 4, 4, 0x251 }, {  7,  6, 3, 3, 0x250 },
+    {  4,  6, 3, 2, 0x240 }, {  5,  6, 3, 2, 0x240 }, {  5,  8, 4, 3, 0x241 }, {  6,  6, 3, 2, 0x240 },
+    {  5,  8, 4, 3, 0x248 }, {  6,  8, 4, 4, 0x24A }, {  6,  8, 4, 4, 0x249 }, {  7,  6, 3, 3, 0x248 },
+    {  5,  6, 3, 2, 0x240 }, {  6,  6, 3, 2, 0x240 }, {  6,  8, 4, 4, 0x245 }, {  7,  6, 3, 3, 0x244 },
+    {  6,  6, 3, 2, 0x240 }, {  7,  6, 3, 3, 0x242 }, {  7,  6, 3, 3, 0x241 }, {  8,  4, 2, 2, 0x240 },
+    {  3,  4, 2, 1, 0x200 }, {  4,  4, 2, 1, 0x200 }, {  4,  6, 3, 2, 0x201 }, {  5,  4, 2, 1, 0x200 },
+    {  4,  6, 3, 1, 0x200 }, {  5,  6, 3, 2, 0x202 }, {  5,  6, 3, 2, 0x201 }, {  6,  4, 2, 1, 0x200 },
+    {  4,  6, 3, 1, 0x200 }, {  5,  6, 3, 1, 0x200 }, {  5,  8, 4, 3, 0x205 }, {  6,  6, 3, 2, 0x204 },
+    {  5,  6, 3, 1, 0x200 }, {  6,  6, 3, 2, 0x202 }, {  6,  6, 3, 2, 0x201 }, {  7,  4, 2, 1, 0x200 },
+    {  4,  6, 3, 2, 0x220 }, {  5,  6, 3, 2, 0x220 }, {  5,  8, 4, 3, 0x221 }, {  6,  6, 3, 2, 0x220 },
+    {  5,  8, 4, 3, 0x228 }, {  6,  8, 4, 4, 0x22A }, {  6,  8, 4, 4, 0x229 }, {  7,  6, 3, 3, 0x228 },
+    {  5,  6, 3, 2, 0x220 }, {  6,  6, 3, 2, 0x220 }, {  6,  8, 4, 4, 0x225 }, {  7,  6, 3, 3, 0x224 },
+    {  6,  6, 3, 2, 0x220 }, {  7,  6, 3, 3, 0x222 }, {  7,  6, 3, 3, 0x221 }, {  8,  4, 2, 2, 0x220 },
+    {  4,  4, 2, 1, 0x200 }, {  5,  4, 2, 1, 0x200 }, {  5,  6, 3, 2, 0x201 }, {  6,  4, 2, 1, 0x200 },
+    {  5,  6, 3, 1, 0x200 }, {  6,  6, 3, 2, 0x202 }, {  6,  6, 3, 2, 0x201 }, {  7,  4, 2, 1, 0x200 },
+    {  5,  6, 3, 2, 0x210 }, {  6,  6, 3, 2, 0x210 }, {  6,  8, 4, 4, 0x215 }, {  7,  6, 3, 3, 0x214 },
+    {  6,  6, 3, 2, 0x210 }, {  7,  6, 3, 3, 0x212 }, {  7,  6, 3, 3, 0x211 }, {  8,  4, 2, 2, 0x210 },
+    {  5,  4, 2, 1, 0x200 }, {  6,  4, 2, 1, 0x200 }, {  6,  6, 3, 2, 0x201 }, {  7,  4, 2, 1, 0x200 },
+    {  6,  6, 3, 2, 0x208 }, {  7,  6, 3, 3, 0x20A }, {  7,  6, 3, 3, 0x209 }, {  8,  4, 2, 2, 0x208 },
+    {  6,  4, 2, 1, 0x200 }, {  7,  4, 2, 1, 0x200 }, {  7,  6, 3, 3, 0x205 }, {  8,  4, 2, 2, 0x204 },
+    {  7,  4, 2, 1, 0x200 }, {  8,  4, 2, 2, 0x202 }, {  8,  4, 2, 2, 0x201 }, {  9,  2, 1, 1, 0x200 },
+    {  1,  2, 1, 0, 0x000 }, {  2,  2, 1, 0, 0x000 }, {  2,  4, 2, 1, 0x001 }, {  3,  2, 1, 0, 0x000 },
+    {  2,  4, 2, 0, 0x000 }, {  3,  4, 2, 1, 0x002 }, {  3,  4, 2, 1, 0x001 }, {  4,  2, 1, 0, 0x000 },
+    {  2,  4, 2, 0, 0x000 }, {  3,  4, 2, 0, 0x000 }, {  3,  6, 3, 2, 0x005 }, {  4,  4, 2, 1, 0x004 },
+    {  3,  4, 2, 0, 0x000 }, {  4,  4, 2, 1, 0x002 }, {  4,  4, 2, 1, 0x001 }, {  5,  2, 1, 0, 0x000 },
+    {  2,  4, 2, 0, 0x000 }, {  3,  4, 2, 0, 0x000 }, {  3,  6, 3, 1, 0x001 }, {  4,  4, 2, 0, 0x000 },
+    {  3,  6, 3, 1, 0x008 }, {  4,  6, 3, 2, 0x00A }, {  4,  6, 3, 2, 0x009 }, {  5,  4, 2, 1, 0x008 },
+    {  3,  4, 2, 0, 0x000 }, {  4,  4, 2, 0, 0x000 }, {  4,  6, 3, 2, 0x005 }, {  5,  4, 2, 1, 0x004 },
+    {  4,  4, 2, 0, 0x000 }, {  5,  4, 2, 1, 0x002 }, {  5,  4, 2, 1, 0x001 }, {  6,  2, 1, 0, 0x000 },
+    {  2,  4, 2, 0, 0x000 }, {  3,  4, 2, 0, 0x000 }, {  3,  6, 3, 1, 0x001 }, {  4,  4, 2, 0, 0x000 },
+    {  3,  6, 3, 0, 0x000 }, {  4,  6, 3, 1, 0x002 }, {  4,  6, 3, 1, 0x001 }, {  5,  4, 2, 0, 0x000 },
+    {  3,  6, 3, 1, 0x010 }, {  4,  6, 3, 1, 0x010 }, {  4,  8, 4, 3, 0x015 }, {  5,  6, 3, 2, 0x014 },
+    {  4,  6, 3, 1, 0x010 }, {  5,  6, 3, 2, 0x012 }, {  5,  6, 3, 2, 0x011 }, {  6,  4, 2, 1, 0x010 },
+    {  3,  4, 2, 0, 0x000 }, {  4,  4, 2, 0, 0x000 }, {  4,  6, 3, 1, 0x001 }, {  5,  4, 2, 0, 0x000 },
+    {  4,  6, 3, 1, 0x008 }, {  5,  6, 3, 2, 0x00A }, {  5,  6, 3, 2, 0x009 }, {  6,  4, 2, 1, 0x008 },
+    {  4,  4, 2, 0, 0x000 }, {  5,  4, 2, 0, 0x000 }, {  5,  6, 3, 2, 0x005 }, {  6,  4, 2, 1, 0x004 },
+    {  5,  4, 2, 0, 0x000 }, {  6,  4, 2, 1, 0x002 }, {  6,  4, 2, 1, 0x001 }, {  7,  2, 1, 0, 0x000 },
+    {  2,  4, 2, 0, 0x000 }, {  3,  4, 2, 0, 0x000 }, {  3,  6, 3, 1, 0x001 }, {  4,  4, 2, 0, 0x000 },
+    {  3,  6, 3, 0, 0x000 }, {  4,  6, 3, 1, 0x002 }, {  4,  6, 3, 1, 0x001 }, {  5,  4, 2, 0, 0x000 },
+    {  3,  6, 3, 0, 0x000 }, {  4,  6, 3, 0, 0x000 }, {  4,  8, 4, 2, 0x005 }, {  5,  6, 3, 1, 0x004 },
+    {  4,  6, 3, 0, 0x000 }, {  5,  6, 3, 1, 0x002 }, {  5,  6, 3, 1, 0x001 }, {  6,  4, 2, 0, 0x000 },
+    {  3,  6, 3, 1, 0x020 }, {  4,  6, 3, 1, 0x020 }, {  4,  8, 4, 2, 0x021 }, {  5,  6, 3, 1, 0x020 },
+    {  4,  8, 4, 2, 0x028 }, {  5,  8, 4, 3, 0x02A }, {  5,  8, 4, 3, 0x029 }, {  6,  6, 3, 2, 0x028 },
+    {  4,  6, 3, 1, 0x020 }, {  5,  6, 3, 1, 0x020 }, {  5,  8, 4, 3, 0x025 }, {  6,  6, 3, 2, 0x024 },
+    {  5,  6, 3, 1, 0x020 }, {  6,  6, 3, 2, 0x022 }, {  6,  6, 3, 2, 0x021 }, {  7,  4, 2, 1, 0x020 },
+    {  3,  4, 2, 0, 0x000 }, {  4,  4, 2, 0, 0x000 }, {  4,  6, 3, 1, 0x001 }, {  5,  4, 2, 0, 0x000 },
+    {  4,  6, 3, 0, 0x000 }, {  5,  6, 3, 1, 0x002 }, {  5,  6, 3, 1, 0x001 }, {  6,  4, 2, 0, 0x000 },
+    {  4,  6, 3, 1, 0x010 }, {  5,  6, 3, 1, 0x010 }, {  5,  8, 4, 3, 0x015 }, {  6,  6, 3, 2, 0x014 },
+    {  5,  6, 3, 1, 0x010 }, {  6,  6, 3, 2, 0x012 }, {  6,  6, 3, 2, 0x011 }, {  7,  4, 2, 1, 0x010 },
+    {  4,  4, 2, 0, 0x000 }, {  5,  4, 2, 0, 0x000 }, {  5,  6, 3, 1, 0x001 }, {  6,  4, 2, 0, 0x000 },
+    {  5,  6, 3, 1, 0x008 }, {  6,  6, 3, 2, 0x00A }, {  6,  6, 3, 2, 0x009 }, {  7,  4, 2, 1, 0x008 },
+    {  5,  4, 2, 0, 0x000 }, {  6,  4, 2, 0, 0x000 }, {  6,  6, 3, 2, 0x005 }, {  7,  4, 2, 1, 0x004 },
+    {  6,  4, 2, 0, 0x000 }, {  7,  4, 2, 1, 0x002 }, {  7,  4, 2, 1, 0x001 }, {  8,  2, 1, 0, 0x000 },
+    {  2,  4, 2, 1, 0x100 }, {  3,  4, 2, 1, 0x100 }, {  3,  6, 3, 2, 0x101 }, {  4,  4, 2, 1, 0x100 },
+    {  3,  6, 3, 1, 0x100 }, {  4,  6, 3, 2, 0x102 }, {  4,  6, 3, 2, 0x101 }, {  5,  4, 2, 1, 0x100 },
+    {  3,  6, 3, 1, 0x100 }, {  4,  6, 3, 1, 0x100 }, {  4,  8, 4, 3, 0x105 }, {  5,  6, 3, 2, 0x104 },
+    {  4,  6, 3, 1, 0x100 }, {  5,  6, 3, 2, 0x102 }, {  5,  6, 3, 2, 0x101 }, {  6,  4, 2, 1, 0x100 },
+    {  3,  6, 3, 1, 0x100 }, {  4,  6, 3, 1, 0x100 }, {  4,  8, 4, 2, 0x101 }, {  5,  6, 3, 1, 0x100 },
+    {  4,  8, 4, 2, 0x108 }, {  5,  8, 4, 3, 0x10A }, {  5,  8, 4, 3, 0x109 }, {  6,  6, 3, 2, 0x108 },
+    {  4,  6, 3, 1, 0x100 }, {  5,  6, 3, 1, 0x100 }, {  5,  8, 4, 3, 0x105 }, {  6,  6, 3, 2, 0x104 },
+    {  5,  6, 3, 1, 0x100 }, {  6,  6, 3, 2, 0x102 }, {  6,  6, 3, 2, 0x101 }, {  7,  4, 2, 1, 0x100 },
+    {  3,  6, 3, 2, 0x140 }, {  4,  6, 3, 2, 0x140 }, {  4,  8, 4, 3, 0x141 }, {  5,  6, 3, 2, 0x140 },
+    {  4,  8, 4, 2, 0x140 }, {  5,  8, 4, 3, 0x142 }, {  5,  8, 4, 3, 0x141 }, {  6,  6, 3, 2, 0x140 },
+    {  4,  8, 4, 3, 0x150 }, {  5,  8, 4, 3, 0x150 }, {  5, 10, 5, 5, 0x155 }, {  6,  8, 4, 4, 0x154 },
+    {  5,  8, 4, 3, 0x150 }, {  6,  8, 4, 4, 0x152 }, {  6,  8, 4, 4, 0x151 }, {  7,  6, 3, 3, 0x150 },
+    {  4,  6, 3, 2, 0x140 }, {  5,  6, 3, 2, 0x140 }, {  5,  8, 4, 3, 0x141 }, {  6,  6, 3, 2, 0x140 },
+    {  5,  8, 4, 3, 0x148 }, {  6,  8, 4, 4, 0x14A }, {  6,  8, 4, 4, 0x149 }, {  7,  6, 3, 3, 0x148 },
+    {  5,  6, 3, 2, 0x140 }, {  6,  6, 3, 2, 0x140 }, {  6,  8, 4, 4, 0x145 }, {  7,  6, 3, 3, 0x144 },
+    {  6,  6, 3, 2, 0x140 }, {  7,  6, 3, 3, 0x142 }, {  7,  6, 3, 3, 0x141 }, {  8,  4, 2, 2, 0x140 },
+    {  3,  4, 2, 1, 0x100 }, {  4,  4, 2, 1, 0x100 }, {  4,  6, 3, 2, 0x101 }, {  5,  4, 2, 1, 0x100 },
+    {  4,  6, 3, 1, 0x100 }, {  5,  6, 3, 2, 0x102 }, {  5,  6, 3, 2, 0x101 }, {  6,  4, 2, 1, 0x100 },
+    {  4,  6, 3, 1, 0x100 }, {  5,  6, 3, 1, 0x100 }, {  5,  8, 4, 3, 0x105 }, {  6,  6, 3, 2, 0x104 },
+    {  5,  6, 3, 1, 0x100 }, {  6,  6, 3, 2, 0x102 }, {  6,  6, 3, 2, 0x101 }, {  7,  4, 2, 1, 0x100 },
+    {  4,  6, 3, 2, 0x120 }, {  5,  6, 3, 2, 0x120 }, {  5,  8, 4, 3, 0x121 }, {  6,  6, 3, 2, 0x120 },
+    {  5,  8, 4, 3, 0x128 }, {  6,  8, 4, 4, 0x12A }, {  6,  8, 4, 4, 0x129 }, {  7,  6, 3, 3, 0x128 },
+    {  5,  6, 3, 2, 0x120 }, {  6,  6, 3, 2, 0x120 }, {  6,  8, 4, 4, 0x125 }, {  7,  6, 3, 3, 0x124 },
+    {  6,  6, 3, 2, 0x120 }, {  7,  6, 3, 3, 0x122 }, {  7,  6, 3, 3, 0x121 }, {  8,  4, 2, 2, 0x120 },
+    {  4,  4, 2, 1, 0x100 }, {  5,  4, 2, 1, 0x100 }, {  5,  6, 3, 2, 0x101 }, {  6,  4, 2, 1, 0x100 },
+    {  5,  6, 3, 1, 0x100 }, {  6,  6, 3, 2, 0x102 }, {  6,  6, 3, 2, 0x101 }, {  7,  4, 2, 1, 0x100 },
+    {  5,  6, 3, 2, 0x110 }, {  6,  6, 3, 2, 0x110 }, {  6,  8, 4, 4, 0x115 }, {  7,  6, 3, 3, 0x114 },
+    {  6,  6, 3, 2, 0x110 }, {  7,  6, 3, 3, 0x112 }, {  7,  6, 3, 3, 0x111 }, {  8,  4, 2, 2, 0x110 },
+    {  5,  4, 2, 1, 0x100 }, {  6,  4, 2, 1, 0x100 }, {  6,  6, 3, 2, 0x101 }, {  7,  4, 2, 1, 0x100 },
+    {  6,  6, 3, 2, 0x108 }, {  7,  6, 3, 3, 0x10A }, {  7,  6, 3, 3, 0x109 }, {  8,  4, 2, 2, 0x108 },
+    {  6,  4, 2, 1, 0x100 }, {  7,  4, 2, 1, 0x100 }, {  7,  6, 3, 3, 0x105 }, {  8,  4, 2, 2, 0x104 },
+    {  7,  4, 2, 1, 0x100 }, {  8,  4, 2, 2, 0x102 }, {  8,  4, 2, 2, 0x101 }, {  9,  2, 1, 1, 0x100 },
+    {  2,  2, 1, 0, 0x000 }, {  3,  2, 1, 0, 0x000 }, {  3,  4, 2, 1, 0x001 }, {  4,  2, 1, 0, 0x000 },
+    {  3,  4, 2, 0, 0x000 }, {  4,  4, 2, 1, 0x002 }, {  4,  4, 2, 1, 0x001 }, {  5,  2, 1, 0, 0x000 },
+    {  3,  4, 2, 0, 0x000 }, {  4,  4, 2, 0, 0x000 }, {  4,  6, 3, 2, 0x005 }, {  5,  4, 2, 1, 0x004 },
+    {  4,  4, 2, 0, 0x000 }, {  5,  4, 2, 1, 0x002 }, {  5,  4, 2, 1, 0x001 }, {  6,  2, 1, 0, 0x000 },
+    {  3,  4, 2, 0, 0x000 }, {  4,  4, 2, 0, 0x000 }, {  4,  6, 3, 1, 0x001 }, {  5,  4, 2, 0, 0x000 },
+    {  4,  6, 3, 1, 0x008 }, {  5,  6, 3, 2, 0x00A }, {  5,  6, 3, 2, 0x009 }, {  6,  4, 2, 1, 0x008 },
+    {  4,  4, 2, 0, 0x000 }, {  5,  4, 2, 0, 0x000 }, {  5,  6, 3, 2, 0x005 }, {  6,  4, 2, 1, 0x004 },
+    {  5,  4, 2, 0, 0x000 }, {  6,  4, 2, 1, 0x002 }, {  6,  4, 2, 1, 0x001 }, {  7,  2, 1, 0, 0x000 },
+    {  3,  4, 2, 0, 0x000 }, {  4,  4, 2, 0, 0x000 }, {  4,  6, 3, 1, 0x001 }, {  5,  4, 2, 0, 0x000 },
+    {  4,  6, 3, 0, 0x000 }, {  5,  6, 3, 1, 0x002 }, {  5,  6, 3, 1, 0x001 }, {  6,  4, 2, 0, 0x000 },
+    {  4,  6, 3, 1, 0x010 }, {  5,  6, 3, 1, 0x010 }, {  5,  8, 4, 3, 0x015 }, {  6,  6, 3, 2, 0x014 },
+    {  5,  6, 3, 1, 0x010 }, {  6,  6, 3, 2, 0x012 }, {  6,  6, 3, 2, 0x011 }, {  7,  4, 2, 1, 0x010 },
+    {  4,  4, 2, 0, 0x000 }, {  5,  4, 2, 0, 0x000 }, {  5,  6, 3, 1, 0x001 }, {  6,  4, 2, 0, 0x000 },
+    {  5,  6, 3, 1, 0x008 }, {  6,  6, 3, 2, 0x00A }, {  6,  6, 3, 2, 0x009 }, {  7,  4, 2, 1, 0x008 },
+    {  5,  4, 2, 0, 0x000 }, {  6,  4, 2, 0, 0x000 }, {  6,  6, 3, 2, 0x005 }, {  7,  4, 2, 1, 0x004 },
+    {  6,  4, 2, 0, 0x000 }, {  7,  4, 2, 1, 0x002 }, {  7,  4, 2, 1, 0x001 }, {  8,  2, 1, 0, 0x000 },
+    {  3,  4, 2, 1, 0x080 }, {  4,  4, 2, 1, 0x080 }, {  4,  6, 3, 2, 0x081 }, {  5,  4, 2, 1, 0x080 },
+    {  4,  6, 3, 1, 0x080 }, {  5,  6, 3, 2, 0x082 }, {  5,  6, 3, 2, 0x081 }, {  6,  4, 2, 1, 0x080 },
+    {  4,  6, 3, 1, 0x080 }, {  5,  6, 3, 1, 0x080 }, {  5,  8, 4, 3, 0x085 }, {  6,  6, 3, 2, 0x084 },
+    {  5,  6, 3, 1, 0x080 }, {  6,  6, 3, 2, 0x082 }, {  6,  6, 3, 2, 0x081 }, {  7,  4, 2, 1, 0x080 },
+    {  4,  6, 3, 2, 0x0A0 }, {  5,  6, 3, 2, 0x0A0 }, {  5,  8, 4, 3, 0x0A1 }, {  6,  6, 3, 2, 0x0A0 },
+    {  5,  8, 4, 3, 0x0A8 }, {  6,  8, 4, 4, 0x0AA }, {  6,  8, 4, 4, 0x0A9 }, {  7,  6, 3, 3, 0x0A8 },
+    {  5,  6, 3, 2, 0x0A0 }, {  6,  6, 3, 2, 0x0A0 }, {  6,  8, 4, 4, 0x0A5 }, {  7,  6, 3, 3, 0x0A4 },
+    {  6,  6, 3, 2, 0x0A0 }, {  7,  6, 3, 3, 0x0A2 }, {  7,  6, 3, 3, 0x0A1 }, {  8,  4, 2, 2, 0x0A0 },
+    {  4,  4, 2, 1, 0x080 }, {  5,  4, 2, 1, 0x080 }, {  5,  6, 3, 2, 0x081 }, {  6,  4, 2, 1, 0x080 },
+    {  5,  6, 3, 1, 0x080 }, {  6,  6, 3, 2, 0x082 }, {  6,  6, 3, 2, 0x081 }, {  7,  4, 2, 1, 0x080 },
+    {  5,  6, 3, 2, 0x090 }, {  6,  6, 3, 2, 0x090 }, {  6,  8, 4, 4, 0x095 }, {  7,  6, 3, 3, 0x094 },
+    {  6,  6, 3, 2, 0x090 }, {  7,  6, 3, 3, 0x092 }, {  7,  6, 3, 3, 0x091 }, {  8,  4, 2, 2, 0x090 },
+    {  5,  4, 2, 1, 0x080 }, {  6,  4, 2, 1, 0x080 }, {  6,  6, 3, 2, 0x081 }, {  7,  4, 2, 1, 0x080 },
+    {  6,  6, 3, 2, 0x088 }, {  7,  6, 3, 3, 0x08A }, {  7,  6, 3, 3, 0x089 }, {  8,  4, 2, 2, 0x088 },
+    {  6,  4, 2, 1, 0x080 }, {  7,  4, 2, 1, 0x080 }, {  7,  6, 3, 3, 0x085 }, {  8,  4, 2, 2, 0x084 },
+    {  7,  4, 2, 1, 0x080 }, {  8,  4, 2, 2, 0x082 }, {  8,  4, 2, 2, 0x081 }, {  9,  2, 1, 1, 0x080 },
+    {  3,  2, 1, 0, 0x000 }, {  4,  2, 1, 0, 0x000 }, {  4,  4, 2, 1, 0x001 }, {  5,  2, 1, 0, 0x000 },
+    {  4,  4, 2, 0, 0x000 }, {  5,  4, 2, 1, 0x002 }, {  5,  4, 2, 1, 0x001 }, {  6,  2, 1, 0, 0x000 },
+    {  4,  4, 2, 0, 0x000 }, {  5,  4, 2, 0, 0x000 }, {  5,  6, 3, 2, 0x005 }, {  6,  4, 2, 1, 0x004 },
+    {  5,  4, 2, 0, 0x000 }, {  6,  4, 2, 1, 0x002 }, {  6,  4, 2, 1, 0x001 }, {  7,  2, 1, 0, 0x000 },
+    {  4,  4, 2, 0, 0x000 }, {  5,  4, 2, 0, 0x000 }, {  5,  6, 3, 1, 0x001 }, {  6,  4, 2, 0, 0x000 },
+    {  5,  6, 3, 1, 0x008 }, {  6,  6, 3, 2, 0x00A }, {  6,  6, 3, 2, 0x009 }, {  7,  4, 2, 1, 0x008 },
+    {  5,  4, 2, 0, 0x000 }, {  6,  4, 2, 0, 0x000 }, {  6,  6, 3, 2, 0x005 }, {  7,  4, 2, 1, 0x004 },
+    {  6,  4, 2, 0, 0x000 }, {  7,  4, 2, 1, 0x002 }, {  7,  4, 2, 1, 0x001 }, {  8,  2, 1, 0, 0x000 },
+    {  4,  4, 2, 1, 0x040 }, {  5,  4, 2, 1, 0x040 }, {  5,  6, 3, 2, 0x041 }, {  6,  4, 2, 1, 0x040 },
+    {  5,  6, 3, 1, 0x040 }, {  6,  6, 3, 2, 0x042 }, {  6,  6, 3, 2, 0x041 }, {  7,  4, 2, 1, 0x040 },
+    {  5,  6, 3, 2, 0x050 }, {  6,  6, 3, 2, 0x050 }, {  6,  8, 4, 4, 0x055 }, {  7,  6, 3, 3, 0x054 },
+    {  6,  6, 3, 2, 0x050 }, {  7,  6, 3, 3, 0x052 }, {  7,  6, 3, 3, 0x051 }, {  8,  4, 2, 2, 0x050 },
+    {  5,  4, 2, 1, 0x040 }, {  6,  4, 2, 1, 0x040 }, {  6,  6, 3, 2, 0x041 }, {  7,  4, 2, 1, 0x040 },
+    {  6,  6, 3, 2, 0x048 }, {  7,  6, 3, 3, 0x04A }, {  7,  6, 3, 3, 0x049 }, {  8,  4, 2, 2, 0x048 },
+    {  6,  4, 2, 1, 0x040 }, {  7,  4, 2, 1, 0x040 }, {  7,  6, 3, 3, 0x045 }, {  8,  4, 2, 2, 0x044 },
+    {  7,  4, 2, 1, 0x040 }, {  8,  4, 2, 2, 0x042 }, {  8,  4, 2, 2, 0x041 }, {  9,  2, 1, 1, 0x040 },
+    {  4,  2, 1, 0, 0x000 }, {  5,  2, 1, 0, 0x000 }, {  5,  4, 2, 1, 0x001 }, {  6,  2, 1, 0, 0x000 },
+    {  5,  4, 2, 0, 0x000 }, {  6,  4, 2, 1, 0x002 }, {  6,  4, 2, 1, 0x001 }, {  7,  2, 1, 0, 0x000 },
+    {  5,  4, 2, 0, 0x000 }, {  6,  4, 2, 0, 0x000 }, {  6,  6, 3, 2, 0x005 }, {  7,  4, 2, 1, 0x004 },
+    {  6,  4, 2, 0, 0x000 }, {  7,  4, 2, 1, 0x002 }, {  7,  4, 2, 1, 0x001 }, {  8,  2, 1, 0, 0x000 },
+    {  5,  4, 2, 1, 0x020 }, {  6,  4, 2, 1, 0x020 }, {  6,  6, 3, 2, 0x021 }, {  7,  4, 2, 1, 0x020 },
+    {  6,  6, 3, 2, 0x028 }, {  7,  6, 3, 3, 0x02A }, {  7,  6, 3, 3, 0x029 }, {  8,  4, 2, 2, 0x028 },
+    {  6,  4, 2, 1, 0x020 }, {  7,  4, 2, 1, 0x020 }, {  7,  6, 3, 3, 0x025 }, {  8,  4, 2, 2, 0x024 },
+    {  7,  4, 2, 1, 0x020 }, {  8,  4, 2, 2, 0x022 }, {  8,  4, 2, 2, 0x021 }, {  9,  2, 1, 1, 0x020 },
+    {  5,  2, 1, 0, 0x000 }, {  6,  2, 1, 0, 0x000 }, {  6,  4, 2, 1, 0x001 }, {  7,  2, 1, 0, 0x000 },
+    {  6,  4, 2, 0, 0x000 }, {  7,  4, 2, 1, 0x002 }, {  7,  4, 2, 1, 0x001 }, {  8,  2, 1, 0, 0x000 },
+    {  6,  4, 2, 1, 0x010 }, {  7,  4, 2, 1, 0x010 }, {  7,  6, 3, 3, 0x015 }, {  8,  4, 2, 2, 0x014 },
+    {  7,  4, 2, 1, 0x010 }, {  8,  4, 2, 2, 0x012 }, {  8,  4, 2, 2, 0x011 }, {  9,  2, 1, 1, 0x010 },
+    {  6,  2, 1, 0, 0x000 }, {  7,  2, 1, 0, 0x000 }, {  7,  4, 2, 1, 0x001 }, {  8,  2, 1, 0, 0x000 },
+    {  7,  4, 2, 1, 0x008 }, {  8,  4, 2, 2, 0x00A }, {  8,  4, 2, 2, 0x009 }, {  9,  2, 1, 1, 0x008 },
+    {  7,  2, 1, 0, 0x000 }, {  8,  2, 1, 0, 0x000 }, {  8,  4, 2, 2, 0x005 }, {  9,  2, 1, 1, 0x004 },
+    {  8,  2, 1, 0, 0x000 }, {  9,  2, 1, 1, 0x002 }, {  9,  2, 1, 1, 0x001 }, { 10,  0, 0, 0, 0x000 }
+};
+
+const EvalRow *eval_row(unsigned int pattern)
+{
+    assert(pattern < EVAL_ROW_PATTERNS);
+    return &ROWS[pattern];
+}
+
+unsigned int eval_row_pattern(const Board *board, int y)
+{
+    assert(board != NULL);
+    assert(y >= 0 && y < BOARD_HEIGHT);
+    return (board->rows[y + BOARD_PAD] >> BOARD_PAD) & (EVAL_ROW_PATTERNS - 1);
+}
+
+void eval_rows(const Board *board, EvalRowSums *sums)
+{
+    assert(board != NULL && sums != NULL);
+    
+    memset(sums, 0, sizeof(*sums));
+    for (int y = 0; y < BOARD_HEIGHT; y++) {
+        const EvalRow *row = &ROWS[eval_row_pattern(board, y)];
+        sums->filled += row->filled;
+        sums->row_transitions += row->transitions;
+        /* An empty row is one gap that says nothing about the stack */
+        sums->gaps += row->filled != 0 ? row->gaps : 0;
+        sums->well_cells += row->well_cells;
+    }
+}
+
+int eval_board(const Board *board, const EvalWeights *weights)
+{
+    assert(board != NULL && weights != NULL);
+    
+    const BoardFeatures *features = &board->features;
+    EvalRowSums rows;
+    eval_rows(board, &rows);
+    
+    int aggregate_height = 0;
+    for (int x = 0; x < BOARD_WIDTH; x++) {
+        aggregate_height += features->heights[x];
+    }
+    
+    return weights->aggregate_height * aggregate_height
+         + weights->holes * features->holes
+         + weights->row_transitions * rows.row_transitions
+         + weights->column_transitions * features->column_transition_total
+         + weights->gaps * rows.gaps
+         + weights->well_cells * rows.well_cells;
+}
@@ -0,0 +1,106 @@
+/**
+ * @file eval.h
+ * @brief Board evaluation from per-row lookup tables
+ *
+ * A 10-wide row has only 1024 occupancy patterns, so everything an
+ * evaluation function wants to know about a single row (filled cells,
+ * transitions, gaps, well cells) is precomputed in one const table
+ * indexed by the row's cell bits. Evaluating a row is one load from
+ * that table instead of a loop over BOARD_WIDTH cells. Column
+ * aggregates come from Board::features, which the engine keeps up to
+ * date on every lock and clear.
+ *
+ * All functions only read the board and may run concurrently.
+ *
+ * @author Tetris CLI Project
+ * @version 1.0
+ */
+
+#ifndef EVAL_H
+#define EVAL_H
+
+#include <stdint.h>
+#include "game.h"
+
+/**
+ * @brief Number of occupancy patterns of one row
+ */
+#define EVAL_ROW_PATTERNS (1u << BOARD_WIDTH)
+
+/**
+ * @brief Precomputed features of one row pattern
+ *
+ * Walls count as filled.
+ */
+typedef struct {
+    unsigned char filled;       /**< Filled cells */
+    unsigned char transitions;  /**< Changes between filled and empty, walls included */
+    unsigned char gaps;         /**< Runs of empty cells */
+    unsigned char well_cells;   /**< Set bits in @c wells */
+    uint16_t wells;             /**< Bit x set if cell x is empty and both neighbours are filled */
+} EvalRow;
+
+/**
+ * @brief Row features summed over the board
+ */
+typedef struct {
+    int filled;                 /**< Filled cells */
+    int row_transitions;        /**< Sum of EvalRow::transitions */
+    int gaps;                   /**< Sum of EvalRow::gaps over rows with a filled cell */
+    int well_cells;             /**< Empty cells with filled neighbours on both sides */
+} EvalRowSums;
+
+/**
+ * @brief Weights of the evaluation terms (higher score = better board)
+ */
+typedef struct {
+    int aggregate_height;       /**< Per unit of summed column height */
+    int holes;                  /**< Per hole */
+    int row_transitions;        /**< Per row transition */
+    int column_transitions;     /**< Per column transition */
+    int gaps;                   /**< Per run of empty cells in a non-empty row */
+    int well_cells;             /**< Per well cell */
+} EvalWeights;
+
+/**
+ * @brief Default weights: every term is a penalty
+ */
+extern const EvalWeights EVAL_DEFAULT_WEIGHTS;
+
+/**
+ * @brief Gets the precomputed features of a row pattern
+ *
+ * @param pattern Row cells, bit x = column x filled (below EVAL_ROW_PATTERNS)
+ * @return Pointer into the const table
+ */
+const EvalRow *eval_row(unsigned int pattern);
+
+/**
+ * @brief Gets the cell bits of a board row from its padded mask
+ *
+ * @param board Pointer to Board
+ * @param y Board row
+ * @return Row pattern for eval_row()
+ */
+unsigned int eval_row_pattern(const Board *board, int y);
+
+/**
+ * @brief Sums the table features of all board rows
+ *
+ * @param board Pointer to Board
+ * @param sums Output sums
+ */
+void eval_rows(const Board *board, EvalRowSums *sums);
+
+/**
+ * @brief Scores a board as the weighted sum of its features
+ *
+ * Row terms come from eval_rows(), column terms from Board::features.
+ *
+ * @param board Pointer to Board
+ * @param weights Term weights
+ * @return Score; higher is better with the default weights
+ */
+int eval_board(const Board *board, const EvalWeights *weights);
+
+#endif /* EVAL_H */
@@ -10,12 +10,96 @@
 #include <assert.h>
 
 /**
- * @brief Generates a random tetromino type (0-6)
- * @return Random TetrominoType
+ * @brief Advances the game's random number generator (SplitMix64)
+ * @param game Pointer to GameState owning the generator
+ * @return Next 64-bit random value
  */
-static TetrominoType random_type(void)
+static uint64_t next_random(GameState *game)
 {
-    return (TetrominoType)(rand() % TETRO_COUNT);
+    uint64_t z = (game->rng_state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+/**
+ * @brief Draws the next tetromino type from the 7-bag
+ * @param game Pointer to GameState owning the generator and the bag
+ * @return Random TetrominoType still in the bag
+ */
+static TetrominoType random_type(GameState *game)
+{
+    unsigned int bag = game->bag;
+    uint64_t left = (uint64_t)__builtin_popcount(bag);
+    
+    /* Multiply-shift maps the top 32 bits onto 0..left-1 without modulo bias */
+    unsigned int pick = (unsigned int)(((next_random(game) >> 32) * left) >> 32);
+    while (pick-- > 0) {
+        bag &= bag - 1;
+    }
+    TetrominoType type = (TetrominoType)__builtin_ctz(bag);
+    game->bag = game_bag_after(game->bag, type);
+    return type;
+}
+
+/**
+ * @brief Points per lock indexed by spin type and lines cleared (× level)
+ *
+ * A T piece cannot clear four lines, so the T-spin Tetris entry is
+ * unreachable and simply scores like a regular Tetris.
+ */
+static const int score_table[3][5] = {
+    [SPIN_NONE] = {   0, 100,  300,  500, 800 },
+    [SPIN_MINI] = { 100, 200,  400,  500, 800 },
+    [SPIN_FULL] = { 400, 800, 1200, 1600, 800 }
+};
+
+/**
+ * @brief Diagonal corners on the pointing side of a T, per rotation
+ *
+ * Corner bits: 0=top-left, 1=top-right, 2=bottom-right, 3=bottom-left.
+ */
+static const int t_front_corners[ROTATION_COUNT] = { 0x3, 0x6, 0xC, 0x9 };
+
+/**
+ * @brief Gravity per level in GAME_GRAVITY_ONE units, from level 1
+ *
+ * round(65536 / (60 * (0.8 - (level-1) * 0.007)^(level-1))), capped at
+ * 20G; the last entry holds for all higher levels.
+ */
+static const uint32_t gravity_table[] = {
+    1092, 1377, 1768, 2311, 3075, 4169, 5759, 8107, 11634, 17026,
+    25416, 38709, 60169, 95483, 154742, 256187, 433425, 749597, GAME_GRAVITY_20G
+};
+
+#define GRAVITY_LEVELS ((int)(sizeof(gravity_table) / sizeof(gravity_table[0])))
+
+/**
+ * @brief Number of set bits in a 4-bit corner mask
+ */
+static const int corner_count[16] = {
+    0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4
+};
+
+static int clear_lines(GameState *game, SpinType spin);
+
+/**
+ * @brief Appends an event to the game's queue
+ * 
+ * Drops (and counts) the event when the queue is full so the engine
+ * never blocks on a caller that does not drain events.
+ * 
+ * @param game Pointer to GameState
+ * @param event Event to append
+ */
+static void push_event(GameState *game, const GameEvent *event)
+{
+    if (game->event_tail - game->event_head >= GAME_EVENT_QUEUE_SIZE) {
+        game->events_dropped++;
+        return;
+    }
+    game->events[game->event_tail % GAME_EVENT_QUEUE_SIZE] = *event;
+    game->event_tail++;
 }
 
 /**
@@ -25,18 +109,204 @@ static TetrominoType random_type(void)
 static void clear_board(Board *board)
 {
     memset(board->cells, 0, sizeof(board->cells));
+    game_board_sync(board);
+}
+
+/**
+ * @brief Board rows of a column mask, without the floor bits
+ */
+#define COLUMN_CELLS ((1u << BOARD_HEIGHT) - 1)
+
+/**
+ * @brief Wall and cell bits of a row mask whose neighbour pairs count
+ *        as row transitions
+ */
+#define ROW_PAIRS (((1u << (BOARD_WIDTH + 1)) - 1) << (BOARD_PAD - 1))
+
+/**
+ * @brief Transitions of an empty row: one at each wall
+ */
+#define EMPTY_ROW_TRANSITIONS 2
+
+/**
+ * @brief Recomputes the features of one row
+ */
+static void update_row_features(Board *board, int y)
+{
+    BoardFeatures *f = &board->features;
+    uint32_t row = board->rows[y + BOARD_PAD];
+    int transitions = __builtin_popcount((row ^ (row >> 1)) & ROW_PAIRS);
+    
+    f->row_transition_total += transitions - f->row_transitions[y];
+    f->row_transitions[y] = transitions;
+}
+
+/**
+ * @brief Recomputes height, holes and transitions of one column
+ */
+static void update_column_features(Board *board, int x)
+{
+    BoardFeatures *f = &board->features;
+    uint32_t col = board->cols[x];
+    int top = __builtin_ctz(col);
+    int holes = __builtin_popcount((~col & COLUMN_CELLS) >> top);
+    int transitions = __builtin_popcount((col ^ (col >> 1)) & COLUMN_CELLS);
+    
+    f->heights[x] = BOARD_HEIGHT - top;
+    f->holes += holes - f->column_holes[x];
+    f->column_holes[x] = holes;
+    f->column_transition_total += transitions - f->column_transitions[x];
+    f->column_transitions[x] = transitions;
+}
+
+/**
+ * @brief Recomputes the well depth of one column from the heights
+ */
+static void update_well(BoardFeatures *f, int x)
+{
+    int left = x > 0 ? f->heights[x - 1] : BOARD_HEIGHT;
+    int right = x < BOARD_WIDTH - 1 ? f->heights[x + 1] : BOARD_HEIGHT;
+    int depth = (left < right ? left : right) - f->heights[x];
+    
+    if (depth < 0) {
+        depth = 0;
+    }
+    f->well_depth += depth - f->wells[x];
+    f->wells[x] = depth;
+}
+
+/**
+ * @brief Updates the features after the columns in @p touched changed
+ * 
+ * Well depths also depend on the neighbouring heights, so the wells
+ * next to every touched column are redone as well.
+ * 
+ * @param board Pointer to Board
+ * @param touched Bit x set for every changed column x
+ */
+static void update_columns(Board *board, unsigned int touched)
+{
+    unsigned int wells = touched | (touched << 1) | (touched >> 1);
+    
+    for (int x = 0; x < BOARD_WIDTH; x++) {
+        if (touched & (1u << x)) {
+            update_column_features(board, x);
+        }
+    }
+    for (int x = 0; x < BOARD_WIDTH; x++) {
+        if (wells & (1u << x)) {
+            update_well(&board->features, x);
+        }
+    }
+}
+
+/**
+ * @brief Computes the features of a board from scratch
+ */
+static void compute_features(const Board *board, BoardFeatures *features)
+{
+    Board scratch = *board;
+    
+    memset(&scratch.features, 0, sizeof(scratch.features));
+    for (int y = 0; y < BOARD_HEIGHT; y++) {
+        update_row_features(&scratch, y);
+    }
+    update_columns(&scratch, (1u << BOARD_WIDTH) - 1);
+    *features = scratch.features;
+}
+
+/**
+ * @brief Asserts the incremental features in a GAME_CHECK_FEATURES build
+ */
+static void check_features(const Board *board)
+{
+#if GAME_CHECK_FEATURES
+    assert(game_features_verify(board));
+#else
+    (void)board;
+#endif
+}
+
+/**
+ * @brief Derives the column masks from the row masks
+ */
+static void sync_columns(Board *board)
+{
+    for (int x = 0; x < BOARD_WIDTH; x++) {
+        uint32_t col = ~((1u << BOARD_HEIGHT) - 1);
+        for (int y = 0; y < BOARD_HEIGHT; y++) {
+            col |= ((board->rows[y + BOARD_PAD] >> (x + BOARD_PAD)) & 1u) << y;
+        }
+        board->cols[x] = col;
+    }
+}
+
+void game_board_sync(Board *board)
+{
+    assert(board != NULL);
+    
+    for (int i = 0; i < BOARD_PAD; i++) {
+        board->rows[i] = BOARD_FULL_ROW;
+        board->rows[BOARD_PAD + BOARD_HEIGHT + i] = BOARD_FULL_ROW;
+    }
+    
+    for (int y = 0; y < BOARD_HEIGHT; y++) {
+        uint32_t row = BOARD_EMPTY_ROW;
+        for (int x = 0; x < BOARD_WIDTH; x++) {
+            row |= (uint32_t)(board->cells[y][x] != 0) << (x + BOARD_PAD);
+        }
+        board->rows[y + BOARD_PAD] = row;
+    }
+    
+    sync_columns(board);
+    compute_features(board, &board->features);
+}
+
+const BoardFeatures *game_get_features(const GameState *game)
+{
+    assert(game != NULL);
+    return &game->board.features;
+}
+
+int game_features_verify(const Board *board)
+{
+    assert(board != NULL);
+    
+    BoardFeatures expected;
+    compute_features(board, &expected);
+    return memcmp(&expected, &board->features, sizeof(expected)) == 0;
+}
+
+/**
+ * @brief Tests whether a piece at (x, y) lies inside the padded masks
+ * 
+ * Outside this range no cell of a 4x4 shape can touch the board, and
+ * shifting the row masks there would leave Board::rows.
+ */
+static int in_padded_range(int x, int y)
+{
+    return x >= -BOARD_PAD && x < BOARD_WIDTH && y >= -BOARD_PAD && y < BOARD_HEIGHT;
 }
 
 void game_init(GameState *game)
 {
     assert(game != NULL);
     
-    /* Seed random number generator (only once per process ideally) */
-    static int seeded = 0;
-    if (!seeded) {
-        srand((unsigned int)time(NULL));
-        seeded = 1;
-    }
+    /* Per-game seed: clock plus address, no process-wide seeding */
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    uint64_t seed = (uint64_t)now.tv_sec * 1000000000ULL + (uint64_t)now.tv_nsec;
+    seed ^= (uint64_t)(uintptr_t)game;
+    
+    game_init_seeded(game, seed);
+}
+
+void game_init_seeded(GameState *game, uint64_t seed)
+{
+    assert(game != NULL);
+    
+    game->rng_state = seed;
+    game->bag = GAME_BAG_FULL;
     
     /* Clear the board */
     clear_board(&game->board);
@@ -47,10 +317,20 @@ void game_init(GameState *game)
     game->lines = 0;
     game->is_running = 1;
     game->is_paused = 0;
+    game->hold = TETRO_COUNT;
+    game->hold_used = 0;
+    game->last_move = MOVE_NONE;
+    memset(&game->last_clear, 0, sizeof(game->last_clear));
+    game->event_head = 0;
+    game->event_tail = 0;
+    game->events_dropped = 0;
+    game->revision = 0;
+    game->clock_ns = 0;
+    game->clock_started = 0;
     
     /* Generate first pieces */
-    game->next = tetromino_create(random_type());
-    game_spawn_piece(game, random_type());
+    game->next = tetromino_create(random_type(game));
+    game_spawn_piece(game, random_type(game));
 }
 
 void game_reset(GameState *game)
@@ -67,15 +347,51 @@ int game_spawn_piece(GameState *game, TetrominoType type)
     Tetromino new_piece = tetromino_create(type);
     
     /* Check if spawn position is valid */
+    game->revision++;
     if (!game_is_valid_position(game, &new_piece)) {
         game->is_running = 0;
+        
+        GameEvent event = { .type = GAME_EVENT_GAME_OVER };
+        event.over.score = game->score;
+        push_event(game, &event);
         return 0;
     }
     
     game->current = new_piece;
+    game->last_move = MOVE_NONE;
+    
+    /* Fresh gravity and lock delay for the new piece */
+    game->gravity_accum = 0;
+    game->lock_deadline_ns = 0;
+    game->lock_resets = 0;
+    game->lock_reset_pending = 0;
+    game->lowest_y = new_piece.y;
     return 1;
 }
 
+/**
+ * @brief Books successful moves or rotations against the lock delay
+ * 
+ * Reaching a new lowest row gives the piece its full set of resets
+ * back; a move on the ground restarts the running timer (applied by
+ * the next game_advance()) while resets are left.
+ * 
+ * @param game Pointer to GameState
+ * @param moves Number of single-step moves that succeeded
+ */
+static void note_moves(GameState *game, int moves)
+{
+    if (game->current.y > game->lowest_y) {
+        game->lowest_y = game->current.y;
+        game->lock_resets = 0;
+    }
+    if (game->lock_deadline_ns != 0 && game->lock_resets < GAME_LOCK_RESETS) {
+        int left = GAME_LOCK_RESETS - game->lock_resets;
+        game->lock_resets += moves < left ? moves : left;
+        game->lock_reset_pending = 1;
+    }
+}
+
 int game_move_current(GameState *game, int dx, int dy)
 {
     assert(game != NULL);
@@ -91,6 +407,9 @@ int game_move_current(GameState *game, int dx, int dy)
     
     /* Apply the move */
     game->current = test;
+    game->last_move = (dx != 0) ? MOVE_SHIFT : MOVE_DROP;
+    game->revision++;
+    note_moves(game, 1);
     return 1;
 }
 
@@ -114,6 +433,9 @@ int game_rotate_current(GameState *game, int clockwise)
     
     /* Apply the rotation */
     game->current = test;
+    game->last_move = MOVE_ROTATE;
+    game->revision++;
+    note_moves(game, 1);
     return 1;
 }
 
@@ -121,90 +443,269 @@ int game_hard_drop(GameState *game)
 {
     assert(game != NULL);
     
-    int drop_distance = 0;
+    int drop_distance = game_drop_distance(game);
     
-    /* Move down until blocked */
-    while (game_move_current(game, 0, 1)) {
-        drop_distance++;
+    if (drop_distance > 0) {
+        game->current.y += drop_distance;
+        game->last_move = MOVE_DROP;
+        game->revision++;
     }
     
     /* Lock the piece */
-    game_lock_piece(game);
+    game_commit_piece(game);
     
     return drop_distance;
 }
 
+/**
+ * @brief Columns the current piece can shift before it hits something
+ * 
+ * Every row of every shape is one contiguous run of cells, so per row
+ * only the gap between the run's end and the nearest filled bit on
+ * that side matters; walls are filled bits, so there always is one.
+ * 
+ * @param game Pointer to GameState (current piece at a valid position)
+ * @param dx -1 for left, 1 for right
+ * @return Free columns in that direction
+ */
+static int free_shift(const GameState *game, int dx)
+{
+    const Tetromino *t = &game->current;
+    const unsigned char *masks = tetromino_get_row_masks(t->type, t->rotation);
+    const uint32_t *rows = &game->board.rows[t->y + BOARD_PAD];
+    unsigned int shift = (unsigned int)(t->x + BOARD_PAD);
+    int free = BOARD_WIDTH;
+    
+    for (int row = 0; row < TETRO_MATRIX_SIZE; row++) {
+        uint32_t piece = (uint32_t)masks[row] << shift;
+        if (piece == 0) {
+            continue;
+        }
+        int gap;
+        if (dx < 0) {
+            int first = __builtin_ctz(piece);
+            uint32_t blockers = rows[row] & ((1u << first) - 1);
+            gap = first - (31 - __builtin_clz(blockers)) - 1;
+        } else {
+            int last = 31 - __builtin_clz(piece);
+            gap = __builtin_ctz(rows[row] >> (last + 1));
+        }
+        if (gap < free) {
+            free = gap;
+        }
+    }
+    return free;
+}
+
+/**
+ * @brief Length of the run of identical actions starting at @p first
+ */
+static size_t run_length(const InputAction *actions, size_t first, size_t count)
+{
+    size_t end = first + 1;
+    while (end < count && actions[end] == actions[first]) {
+        end++;
+    }
+    return end - first;
+}
+
+size_t game_apply_actions(GameState *game, const InputAction *actions, size_t count)
+{
+    assert(game != NULL);
+    assert(actions != NULL || count == 0);
+    
+    size_t i = 0;
+    while (i < count && game->is_running) {
+        InputAction action = actions[i];
+        
+        if (action == INPUT_LEFT || action == INPUT_RIGHT || action == INPUT_DOWN) {
+            size_t run = run_length(actions, i, count);
+            i += run;
+            
+            /* The masks assume a valid start; anything else goes step by step */
+            if (!game_is_valid_position(game, &game->current)) {
+                int dx = action == INPUT_LEFT ? -1 : action == INPUT_RIGHT ? 1 : 0;
+                for (size_t step = 0; step < run; step++) {
+                    game_move_current(game, dx, dx == 0);
+                }
+                continue;
+            }
+            int free = action == INPUT_DOWN ? game_drop_distance(game)
+                     : free_shift(game, action == INPUT_LEFT ? -1 : 1);
+            int moves = (size_t)free < run ? free : (int)run;
+            if (moves == 0) {
+                continue;
+            }
+            
+            if (action == INPUT_DOWN) {
+                game->current.y += moves;
+                game->last_move = MOVE_DROP;
+            } else {
+                game->current.x += action == INPUT_LEFT ? -moves : moves;
+                game->last_move = MOVE_SHIFT;
+            }
+            game->revision++;
+            /* Each step down is a new lowest row, which clears the resets */
+            note_moves(game, action == INPUT_DOWN ? 1 : moves);
+            continue;
+        }
+        
+        i++;
+        switch (action) {
+            case INPUT_ROTATE_CW:
+                game_rotate_current(game, 1);
+                break;
+            case INPUT_ROTATE_CCW:
+                game_rotate_current(game, 0);
+                break;
+            case INPUT_HARD_DROP:
+                game_hard_drop(game);
+                return i;
+            case INPUT_HOLD:
+                game_hold_piece(game);
+                break;
+            default:
+                break;
+        }
+    }
+    return i;
+}
+
 int game_lock_piece(GameState *game)
 {
     assert(game != NULL);
+    return game_commit_piece(game).clear.lines;
+}
+
+StepResult game_commit_piece(GameState *game)
+{
+    assert(game != NULL);
+    
+    StepResult result;
+    memset(&result, 0, sizeof(result));
     
-    const int (*shape)[TETRO_MATRIX_SIZE] = tetromino_get_shape(
+    const unsigned char *masks = tetromino_get_row_masks(
         game->current.type, game->current.rotation);
     
-    if (shape == NULL) {
-        return 0;
+    if (masks == NULL) {
+        return result;
     }
     
     int color = tetromino_get_color(game->current.type);
     
+    /* Classify the spin before the piece becomes part of the board */
+    SpinType spin = game_detect_spin(game);
+    
+    GameEvent lock_event = { .type = GAME_EVENT_PIECE_LOCKED };
+    lock_event.lock.piece = game->current.type;
+    lock_event.lock.spin = spin;
+    int cell = 0;
+    
     /* Copy tetromino cells to board */
+    int x = game->current.x;
+    int y = game->current.y;
+    int on_board = in_padded_range(x, y);
+    unsigned int touched = 0;
+    
     for (int row = 0; row < TETRO_MATRIX_SIZE; row++) {
         for (int col = 0; col < TETRO_MATRIX_SIZE; col++) {
-            if (shape[row][col] == 1) {
-                int board_x = game->current.x + col;
-                int board_y = game->current.y + row;
-                
-                /* Ensure within bounds */
-                if (board_x >= 0 && board_x < BOARD_WIDTH &&
-                    board_y >= 0 && board_y < BOARD_HEIGHT) {
-                    game->board.cells[board_y][board_x] = color;
-                }
+            if (masks[row] & (1u << col)) {
+                lock_event.lock.cell_x[cell] = x + col;
+                lock_event.lock.cell_y[cell] = y + row;
+                cell++;
+            }
+        }
+        
+        if (!on_board) {
+            continue;
+        }
+        
+        /* Bits that land on walls or sentinel rows are set there already */
+        uint32_t bits = (uint32_t)masks[row] << (x + BOARD_PAD);
+        uint32_t *mask_row = &game->board.rows[y + row + BOARD_PAD];
+        uint32_t placed = bits & ~*mask_row;
+        *mask_row |= bits;
+        
+        if (placed != 0) {
+            update_row_features(&game->board, y + row);
+            touched |= placed >> BOARD_PAD;
+        }
+        for (int col = 0; placed != 0; col++, placed >>= 1) {
+            if (placed & 1u) {
+                game->board.cells[y + row][col - BOARD_PAD] = color;
+                game->board.cols[col - BOARD_PAD] |= 1u << (y + row);
             }
         }
     }
+    update_columns(&game->board, touched);
+    check_features(&game->board);
+    result.locked = 1;
+    game->revision++;
+    push_event(game, &lock_event);
     
-    /* Move next to current and generate new next */
-    game->current = game->next;
-    game->next = tetromino_create(random_type());
+    /* Clear lines before the spawn check so a clear can save a top-out */
+    int level_before = game->level;
+    clear_lines(game, spin);
+    result.clear = game->last_clear;
+    result.level_up = (game->level != level_before);
     
-    /* Check if new current piece can be placed */
-    if (!game_is_valid_position(game, &game->current)) {
-        game->is_running = 0;
-        return 0;
+    /* Promote next (the only spawn validation) and draw exactly one new piece */
+    TetrominoType incoming = game->next.type;
+    game->next = tetromino_create(random_type(game));
+    game->hold_used = 0;
+    
+    if (!game_spawn_piece(game, incoming)) {
+        result.game_over = 1;
     }
     
-    /* Clear lines and return count */
-    return game_clear_lines(game);
+    return result;
 }
 
-int game_clear_lines(GameState *game)
+StepResult game_step(GameState *game)
 {
     assert(game != NULL);
     
+    if (game_move_current(game, 0, 1)) {
+        StepResult result;
+        memset(&result, 0, sizeof(result));
+        result.moved = 1;
+        return result;
+    }
+    
+    return game_commit_piece(game);
+}
+
+/**
+ * @brief Clears full lines and scores them with the given spin
+ *
+ * Spins score even without cleared lines. The outcome is recorded
+ * in game->last_clear.
+ *
+ * @param game Pointer to GameState
+ * @param spin Spin classification of the piece that just locked
+ * @return Number of lines cleared (0-4)
+ */
+static int clear_lines(GameState *game, SpinType spin)
+{
     int lines_cleared = 0;
+    int rows_mask = 0;
     int write_row = BOARD_HEIGHT - 1;
     
     /* Scan from bottom to top */
     for (int read_row = BOARD_HEIGHT - 1; read_row >= 0; read_row--) {
-        int is_full = 1;
-        
-        /* Check if row is full */
-        for (int col = 0; col < BOARD_WIDTH; col++) {
-            if (game->board.cells[read_row][col] == 0) {
-                is_full = 0;
-                break;
-            }
-        }
-        
-        if (is_full) {
+        if (game->board.rows[read_row + BOARD_PAD] == BOARD_FULL_ROW) {
             /* Skip this row (don't copy it) - it's cleared */
             lines_cleared++;
+            rows_mask |= 1 << read_row;
         } else {
             /* Copy row to write position */
             if (write_row != read_row) {
                 memcpy(game->board.cells[write_row],
                        game->board.cells[read_row],
                        sizeof(game->board.cells[write_row]));
+                game->board.rows[write_row + BOARD_PAD] = game->board.rows[read_row + BOARD_PAD];
+                game->board.features.row_transitions[write_row] =
+                    game->board.features.row_transitions[read_row];
             }
             write_row--;
         }
@@ -213,35 +714,123 @@ int game_clear_lines(GameState *game)
     /* Clear remaining rows at top */
     for (int row = write_row; row >= 0; row--) {
         memset(game->board.cells[row], 0, sizeof(game->board.cells[row]));
+        game->board.rows[row + BOARD_PAD] = BOARD_EMPTY_ROW;
+        game->board.features.row_transitions[row] = EMPTY_ROW_TRANSITIONS;
     }
     
-    /* Update statistics */
+    if (lines_cleared > 0) {
+        /* Full rows have no transitions; rows above only moved down */
+        game->board.features.row_transition_total += lines_cleared * EMPTY_ROW_TRANSITIONS;
+        sync_columns(&game->board);
+        update_columns(&game->board, (1u << BOARD_WIDTH) - 1);
+        check_features(&game->board);
+    }
+    
+    /* Update statistics (points use the level before a level-up) */
+    int points = game_calculate_spin_score(lines_cleared, spin, game->level);
+    game->score += points;
+    
+    game->last_clear.lines = lines_cleared;
+    game->last_clear.rows_mask = rows_mask;
+    game->last_clear.spin = spin;
+    game->last_clear.points = points;
+    
     if (lines_cleared > 0) {
         game->lines += lines_cleared;
-        game->score += game_calculate_score(lines_cleared, game->level);
+        game->revision++;
+        
+        GameEvent event = { .type = GAME_EVENT_LINES_CLEARED };
+        event.clear = game->last_clear;
+        push_event(game, &event);
         
         /* Update level: level = (lines / 10) + 1 */
+        int old_level = game->level;
         game->level = (game->lines / 10) + 1;
+        
+        if (game->level != old_level) {
+            GameEvent level_event = { .type = GAME_EVENT_LEVEL_CHANGED };
+            level_event.level.old_level = old_level;
+            level_event.level.new_level = game->level;
+            push_event(game, &level_event);
+        }
     }
     
     return lines_cleared;
 }
 
+int game_clear_lines(GameState *game)
+{
+    assert(game != NULL);
+    return clear_lines(game, SPIN_NONE);
+}
+
 int game_calculate_score(int lines_cleared, int level)
 {
     /* Standard Tetris scoring */
-    switch (lines_cleared) {
-        case 1:
-            return 100 * level;
-        case 2:
-            return 300 * level;
-        case 3:
-            return 500 * level;
-        case 4:
-            return 800 * level;  /* Tetris! */
-        default:
-            return 0;
+    return game_calculate_spin_score(lines_cleared, SPIN_NONE, level);
+}
+
+int game_calculate_spin_score(int lines_cleared, SpinType spin, int level)
+{
+    if (lines_cleared < 0 || lines_cleared > 4 ||
+        spin < SPIN_NONE || spin > SPIN_FULL) {
+        return 0;
     }
+    return score_table[spin][lines_cleared] * level;
+}
+
+/**
+ * @brief Tests whether a board cell blocks a piece
+ * 
+ * Cells outside the board (walls, floor, above the top) count as filled.
+ */
+static int cell_blocked(const GameState *game, int x, int y)
+{
+    if (x < -BOARD_PAD || x >= BOARD_WIDTH + BOARD_PAD ||
+        y < -BOARD_PAD || y >= BOARD_HEIGHT + BOARD_PAD) {
+        return 1;
+    }
+    return (game->board.rows[y + BOARD_PAD] >> (x + BOARD_PAD)) & 1u;
+}
+
+SpinType game_detect_spin(const GameState *game)
+{
+    assert(game != NULL);
+    
+    const Tetromino *t = &game->current;
+    
+    if (game->last_move != MOVE_ROTATE || t->type == TETRO_O) {
+        return SPIN_NONE;
+    }
+    
+    if (t->type == TETRO_T) {
+        /* The T centre sits at (1,1) of the shape matrix in every rotation */
+        int corners = cell_blocked(game, t->x,     t->y)
+                    | cell_blocked(game, t->x + 2, t->y)     << 1
+                    | cell_blocked(game, t->x + 2, t->y + 2) << 2
+                    | cell_blocked(game, t->x,     t->y + 2) << 3;
+        
+        if (corner_count[corners] < 3) {
+            return SPIN_NONE;
+        }
+        
+        int front = t_front_corners[t->rotation];
+        return ((corners & front) == front) ? SPIN_FULL : SPIN_MINI;
+    }
+    
+    /* All-spin: rotated into a spot it cannot leave sideways or upwards */
+    Tetromino test = *t;
+    static const int probes[3][2] = { { -1, 0 }, { 1, 0 }, { 0, -1 } };
+    
+    for (int i = 0; i < 3; i++) {
+        test.x = t->x + probes[i][0];
+        test.y = t->y + probes[i][1];
+        if (game_is_valid_position(game, &test)) {
+            return SPIN_NONE;
+        }
+    }
+    
+    return SPIN_MINI;
 }
 
 int game_is_valid_position(const GameState *game, const Tetromino *t)
@@ -249,36 +838,137 @@ int game_is_valid_position(const GameState *game, const Tetromino *t)
     assert(game != NULL);
     assert(t != NULL);
     
-    const int (*shape)[TETRO_MATRIX_SIZE] = tetromino_get_shape(t->type, t->rotation);
+    const unsigned char *masks = tetromino_get_row_masks(t->type, t->rotation);
     
-    if (shape == NULL) {
+    if (masks == NULL || !in_padded_range(t->x, t->y)) {
         return 0;
     }
     
-    /* Check each cell of the tetromino */
-    for (int row = 0; row < TETRO_MATRIX_SIZE; row++) {
-        for (int col = 0; col < TETRO_MATRIX_SIZE; col++) {
-            if (shape[row][col] == 1) {
-                int board_x = t->x + col;
-                int board_y = t->y + row;
-                
-                /* Check board boundaries */
-                if (board_x < 0 || board_x >= BOARD_WIDTH) {
-                    return 0;
-                }
-                if (board_y < 0 || board_y >= BOARD_HEIGHT) {
-                    return 0;
-                }
-                
-                /* Check collision with locked pieces */
-                if (game->board.cells[board_y][board_x] != 0) {
-                    return 0;
-                }
+    /* Walls, floor and the rows above the board are filled sentinels */
+    const uint32_t *rows = &game->board.rows[t->y + BOARD_PAD];
+    unsigned int shift = (unsigned int)(t->x + BOARD_PAD);
+    uint32_t hit = (rows[0] & ((uint32_t)masks[0] << shift))
+                 | (rows[1] & ((uint32_t)masks[1] << shift))
+                 | (rows[2] & ((uint32_t)masks[2] << shift))
+                 | (rows[3] & ((uint32_t)masks[3] << shift));
+    
+    return hit == 0;
+}
+
+uint32_t game_gravity(int level)
+{
+    if (level < 1) {
+        level = 1;
+    }
+    if (level > GRAVITY_LEVELS) {
+        level = GRAVITY_LEVELS;
+    }
+    return gravity_table[level - 1];
+}
+
+int game_drop_distance(const GameState *game)
+{
+    assert(game != NULL);
+    
+    const Tetromino *t = &game->current;
+    const unsigned char *masks = tetromino_get_row_masks(t->type, t->rotation);
+    
+    /* Guarantees every occupied column is on the board */
+    if (masks == NULL || !game_is_valid_position(game, t)) {
+        return 0;
+    }
+    
+    int distance = BOARD_HEIGHT;
+    for (int col = 0; col < TETRO_MATRIX_SIZE; col++) {
+        int bottom = -1;
+        for (int row = 0; row < TETRO_MATRIX_SIZE; row++) {
+            if (masks[row] & (1u << col)) {
+                bottom = row;
             }
         }
+        if (bottom < 0) {
+            continue;
+        }
+        
+        /* The floor bits make the shifted mask non-zero */
+        uint32_t below = game->board.cols[t->x + col] >> (t->y + bottom + 1);
+        int gap = __builtin_ctz(below);
+        if (gap < distance) {
+            distance = gap;
+        }
     }
+    return distance;
+}
+
+StepResult game_advance(GameState *game, uint64_t now_ns)
+{
+    assert(game != NULL);
     
-    return 1;
+    StepResult result;
+    memset(&result, 0, sizeof(result));
+    
+    uint64_t elapsed = game->clock_started ? now_ns - game->clock_ns : 0;
+    game->clock_ns = now_ns;
+    game->clock_started = 1;
+    
+    if (!game->is_running) {
+        return result;
+    }
+    if (game->is_paused) {
+        /* The lock delay does not run out during a pause */
+        if (game->lock_deadline_ns != 0) {
+            game->lock_deadline_ns += elapsed;
+        }
+        return result;
+    }
+    if (elapsed > GAME_MAX_ADVANCE_NS) {
+        elapsed = GAME_MAX_ADVANCE_NS;
+    }
+    
+    uint32_t gravity = game_gravity(game->level);
+    int distance = game_drop_distance(game);
+    uint64_t rows;
+    
+    if (gravity >= GAME_GRAVITY_20G) {
+        rows = (uint64_t)distance;
+    } else {
+        game->gravity_accum += (uint64_t)gravity * elapsed;
+        rows = game->gravity_accum / ((uint64_t)GAME_GRAVITY_ONE * GAME_FRAME_NS);
+        game->gravity_accum %= (uint64_t)GAME_GRAVITY_ONE * GAME_FRAME_NS;
+    }
+    if (rows >= (uint64_t)distance) {
+        /* Landing ends the fall; leftover gravity would carry over a ledge */
+        rows = (uint64_t)distance;
+        game->gravity_accum = 0;
+    }
+    
+    if (rows > 0) {
+        game->current.y += (int)rows;
+        game->last_move = MOVE_DROP;
+        game->revision++;
+        result.moved = 1;
+        distance -= (int)rows;
+        if (game->current.y > game->lowest_y) {
+            game->lowest_y = game->current.y;
+            game->lock_resets = 0;
+        }
+    }
+    
+    if (distance > 0) {
+        /* Airborne: no lock timer; used resets stay used */
+        game->lock_deadline_ns = 0;
+        game->lock_reset_pending = 0;
+        return result;
+    }
+    
+    if (game->lock_deadline_ns == 0 || game->lock_reset_pending) {
+        game->lock_deadline_ns = now_ns + GAME_LOCK_DELAY_NS;
+        game->lock_reset_pending = 0;
+    }
+    if (now_ns >= game->lock_deadline_ns) {
+        return game_commit_piece(game);
+    }
+    return result;
 }
 
 int game_get_speed_ms(int level)
@@ -325,4 +1015,89 @@ void game_set_next_type(GameState *game, TetrominoType type)
     assert(game != NULL);
     assert(tetromino_type_is_valid(type));
     game->next = tetromino_create(type);
+    game->revision++;
+}
+
+unsigned int game_bag(const GameState *game)
+{
+    assert(game != NULL);
+    return game->bag;
+}
+
+double game_draw_probability(const GameState *game, TetrominoType type)
+{
+    assert(game != NULL);
+    assert(tetromino_type_is_valid(type));
+    if (!(game->bag & (1u << type))) {
+        return 0.0;
+    }
+    return 1.0 / (double)__builtin_popcount(game->bag);
+}
+
+unsigned int game_bag_after(unsigned int bag, TetrominoType type)
+{
+    assert(tetromino_type_is_valid(type));
+    assert(bag & (1u << type));
+    bag &= ~(1u << type);
+    return bag != 0 ? bag : GAME_BAG_FULL;
+}
+
+int game_hold_piece(GameState *game)
+{
+    assert(game != NULL);
+    
+    if (game->hold_used) {
+        return 0;
+    }
+    
+    TetrominoType incoming;
+    if (game->hold == TETRO_COUNT) {
+        /* Empty slot: the next piece comes in and a new next is drawn */
+        incoming = game->next.type;
+        game->next = tetromino_create(random_type(game));
+    } else {
+        incoming = game->hold;
+    }
+    
+    game->hold = game->current.type;
+    game->hold_used = 1;
+    
+    return game_spawn_piece(game, incoming);
+}
+
+int game_can_hold(const GameState *game)
+{
+    assert(game != NULL);
+    return !game->hold_used;
+}
+
+TetrominoType game_get_hold_type(const GameState *game)
+{
+    assert(game != NULL);
+    return game->hold;
+}
+
+TetrominoType game_get_hold_alternative(const GameState *game)
+{
+    assert(game != NULL);
+    return (game->hold == TETRO_COUNT) ? game->next.type : game->hold;
+}
+
+int game_poll_event(GameState *game, GameEvent *event)
+{
+    assert(game != NULL);
+    assert(event != NULL);
+    
+    if (game->event_head == game->event_tail) {
+        return 0;
+    }
+    *event = game->events[game->event_head % GAME_EVENT_QUEUE_SIZE];
+    game->event_head++;
+    return 1;
+}
+
+int game_pending_events(const GameState *game)
+{
+    assert(game != NULL);
+    return (int)(game->event_tail - game->event_head);
 }
@@ -5,6 +5,13 @@
  * This module manages the complete game state including the board,
  * current and next tetrominos, scoring, levels, and line clearing.
  * 
+ * Thread safety: the engine has no global or static mutable state.
+ * Everything, including the random number generator, lives in the
+ * GameState passed to each call, so different GameStates can be used
+ * from different threads without locking. Calls on the same GameState
+ * must be serialized by the caller; each function documents whether it
+ * writes the state or only reads it.
+ * 
  * @author Tetris CLI Project
  * @version 1.0
  */
@@ -13,6 +20,9 @@
 #define GAME_H
 
 #include "tetromino.h"
+#include "input.h"
+#include <stddef.h>
+#include <stdint.h>
 
 /**
  * @brief Board width in cells (standard Tetris width)
@@ -29,16 +39,218 @@
  */
 typedef int Cell;
 
+/**
+ * @brief Sentinel rows and columns around the board in Board::rows
+ *
+ * Large enough that every cell of a 4x4 shape matrix lands on the board
+ * or on a sentinel when at least one of its cells could be on the board.
+ */
+#define BOARD_PAD 3
+
+/**
+ * @brief Occupancy mask of a row without any filled cell (walls only)
+ */
+#define BOARD_EMPTY_ROW (~(((1u << BOARD_WIDTH) - 1) << BOARD_PAD))
+
+/**
+ * @brief Occupancy mask of a completely filled row or sentinel row
+ */
+#define BOARD_FULL_ROW 0xFFFFFFFFu
+
+/**
+ * @brief Cross-check the incremental board features in every update
+ *
+ * When nonzero, every lock and line clear asserts that
+ * Board::features equals a full recomputation (game_features_verify()).
+ * The debug build turns it on.
+ */
+#ifndef GAME_CHECK_FEATURES
+#define GAME_CHECK_FEATURES 0
+#endif
+
+/**
+ * @brief Board aggregates read by evaluation functions
+ *
+ * Walls and the floor count as filled. A hole is an empty cell below
+ * the top filled cell of its column. A well is how far a column lies
+ * below the lower of its two neighbours. Transitions count changes
+ * between filled and empty along a row (walls included) or down a
+ * column (floor included).
+ */
+typedef struct {
+    int heights[BOARD_WIDTH];           /**< Column height (0 = empty column) */
+    int column_holes[BOARD_WIDTH];      /**< Holes per column */
+    int wells[BOARD_WIDTH];             /**< Well depth per column (0 = no well) */
+    int column_transitions[BOARD_WIDTH]; /**< Transitions per column */
+    int row_transitions[BOARD_HEIGHT];  /**< Transitions per row */
+    int holes;                          /**< Sum of column_holes */
+    int well_depth;                     /**< Sum of wells */
+    int row_transition_total;           /**< Sum of row_transitions */
+    int column_transition_total;        /**< Sum of column_transitions */
+} BoardFeatures;
+
 /**
  * @brief Game board structure
  * 
  * The board is a 2D array of cells. Each cell is either empty (0)
  * or contains a color value (1-7) representing a locked tetromino.
+ * 
+ * @c rows mirrors the cells as one occupancy mask per row, padded with
+ * BOARD_PAD filled sentinel rows above and below and filled wall bits
+ * left and right: board cell (x, y) is bit x + BOARD_PAD of
+ * rows[y + BOARD_PAD]. Collision and full-row tests use the masks only,
+ * without range checks. @c cols holds the same cells per column (bit y =
+ * row y, all bits from BOARD_HEIGHT up set as the floor), so the drop
+ * distance of a column is one count of trailing zeros. @c features
+ * is updated for the touched rows and columns only on every lock and
+ * clear. The game_* functions keep all of them in sync; code that
+ * writes @c cells directly must call game_board_sync() afterwards.
  */
 typedef struct {
     Cell cells[BOARD_HEIGHT][BOARD_WIDTH];
+    uint32_t rows[BOARD_HEIGHT + 2 * BOARD_PAD];
+    uint32_t cols[BOARD_WIDTH];
+    BoardFeatures features;
 } Board;
 
+/**
+ * @brief Kind of the last successful manipulation of the current piece
+ *
+ * Spin detection needs to know whether the piece reached its final
+ * position by a rotation, so every successful move records its kind.
+ */
+typedef enum {
+    MOVE_NONE,      /**< Piece has not been moved since it spawned */
+    MOVE_SHIFT,     /**< Horizontal move */
+    MOVE_DROP,      /**< Downward move (gravity, soft drop, hard drop) */
+    MOVE_ROTATE     /**< Rotation */
+} MoveType;
+
+/**
+ * @brief Spin classification of a locked piece
+ */
+typedef enum {
+    SPIN_NONE,      /**< Regular placement */
+    SPIN_MINI,      /**< Mini T-spin or non-T all-spin */
+    SPIN_FULL       /**< Full T-spin */
+} SpinType;
+
+/**
+ * @brief Summary of the most recent line clear
+ *
+ * Filled in by game_clear_lines() and game_commit_piece() so that
+ * statistics and bots can read the outcome of a lock without
+ * re-scanning the board.
+ */
+typedef struct {
+    int lines;          /**< Number of lines cleared (0-4) */
+    int rows_mask;      /**< Bit r is set if board row r was cleared */
+    SpinType spin;      /**< Spin classification of the locked piece */
+    int points;         /**< Points awarded for this lock */
+} ClearInfo;
+
+/**
+ * @brief Gravity of one row per frame in the fixed-point gravity unit
+ *
+ * Gravity is measured in rows per frame (1/60 s) as a 16.16 fixed-point
+ * number, so both 1/60 G at level 1 and 20G fit without floating point.
+ */
+#define GAME_GRAVITY_ONE (1u << 16)
+
+/**
+ * @brief 20G: the piece reaches the stack in the frame it spawns
+ */
+#define GAME_GRAVITY_20G (20u * GAME_GRAVITY_ONE)
+
+/**
+ * @brief Length of one gravity frame in nanoseconds (60 Hz)
+ */
+#define GAME_FRAME_NS 16666667ULL
+
+/**
+ * @brief Time a grounded piece may rest before it locks
+ */
+#define GAME_LOCK_DELAY_NS 500000000ULL
+
+/**
+ * @brief Moves or rotations on the ground that restart the lock delay
+ *
+ * The count starts over when the piece reaches a row lower than any
+ * before (step reset), so a piece cannot be kept alive forever.
+ */
+#define GAME_LOCK_RESETS 15
+
+/**
+ * @brief Longest interval one game_advance() call accounts for
+ *
+ * A caller that stalled (debugger, suspended terminal) does not
+ * teleport the piece to the floor when it resumes.
+ */
+#define GAME_MAX_ADVANCE_NS 250000000ULL
+
+/**
+ * @brief Outcome of a single engine step
+ *
+ * Returned by game_step() and game_commit_piece() so callers learn
+ * everything that happened without re-reading the whole GameState.
+ */
+typedef struct {
+    int moved;          /**< 1 if gravity moved the piece down (one row per
+                             game_step(), any number per game_advance()) */
+    int locked;         /**< 1 if the piece was committed to the board */
+    ClearInfo clear;    /**< Line clear outcome (valid when locked) */
+    int level_up;       /**< 1 if the clear raised the level */
+    int game_over;      /**< 1 if the next piece could not spawn */
+} StepResult;
+
+/**
+ * @brief Capacity of the per-game event queue (power of two)
+ */
+#define GAME_EVENT_QUEUE_SIZE 16
+
+/**
+ * @brief Types of events emitted by the engine
+ */
+typedef enum {
+    GAME_EVENT_PIECE_LOCKED,    /**< A piece was written into the board */
+    GAME_EVENT_LINES_CLEARED,   /**< One or more rows were removed */
+    GAME_EVENT_LEVEL_CHANGED,   /**< The level changed after a clear */
+    GAME_EVENT_GAME_OVER        /**< A piece could not spawn */
+} GameEventType;
+
+/**
+ * @brief A typed engine event
+ *
+ * Only the payload matching @c type is valid.
+ */
+typedef struct {
+    GameEventType type;                 /**< Event type */
+    union {
+        struct {
+            TetrominoType piece;        /**< Type of the locked piece */
+            int cell_x[4];              /**< Board columns of the locked cells */
+            int cell_y[4];              /**< Board rows of the locked cells */
+            SpinType spin;              /**< Spin classification */
+        } lock;                         /**< GAME_EVENT_PIECE_LOCKED */
+        ClearInfo clear;                /**< GAME_EVENT_LINES_CLEARED */
+        struct {
+            int old_level;              /**< Level before the clear */
+            int new_level;              /**< Level after the clear */
+        } level;                        /**< GAME_EVENT_LEVEL_CHANGED */
+        struct {
+            int score;                  /**< Final score */
+        } over;                         /**< GAME_EVENT_GAME_OVER */
+    };
+} GameEvent;
+
+/**
+ * @brief Bag of the 7-bag randomizer with every type still in it
+ *
+ * Bit @c t stands for TetrominoType @c t. Pieces are drawn from a bag
+ * holding each type once; an emptied bag is refilled straight away.
+ */
+#define GAME_BAG_FULL ((1u << TETRO_COUNT) - 1u)
+
 /**
  * @brief Complete game state structure
  * 
@@ -54,6 +266,24 @@ typedef struct {
     int lines;                 /**< Gesamt gelöschte Linien */
     int is_running;            /**< 1=läuft, 0=Game Over */
     int is_paused;             /**< 1=pausiert, 0=aktiv */
+    TetrominoType hold;        /**< Gehaltenes Tetromino (TETRO_COUNT = leer) */
+    int hold_used;             /**< 1=Hold in diesem Drop bereits benutzt */
+    MoveType last_move;        /**< Letzte erfolgreiche Bewegung des aktuellen Tetrominos */
+    ClearInfo last_clear;      /**< Ergebnis des letzten Lock/Line-Clears */
+    GameEvent events[GAME_EVENT_QUEUE_SIZE]; /**< Ringpuffer für Engine-Events */
+    unsigned int event_head;   /**< Leseposition im Ringpuffer */
+    unsigned int event_tail;   /**< Schreibposition im Ringpuffer */
+    unsigned int events_dropped; /**< Verworfene Events bei vollem Puffer */
+    uint64_t rng_state;        /**< Zustand des Zufallsgenerators (pro Spiel) */
+    unsigned int bag;          /**< Noch nicht gezogene Typen des 7er-Beutels (Bit = Typ, nie leer) */
+    unsigned int revision;     /**< Änderungszähler, steigt bei jeder sichtbaren Änderung */
+    uint64_t clock_ns;         /**< Zeitpunkt des letzten game_advance() */
+    int clock_started;         /**< 1 nach dem ersten game_advance() */
+    uint64_t gravity_accum;    /**< Angesammelte Gravitation (GAME_GRAVITY_ONE × ns pro Frame = 1 Zeile) */
+    uint64_t lock_deadline_ns; /**< Lock-Zeitpunkt des liegenden Tetrominos (0 = Timer aus) */
+    int lock_resets;           /**< Verbrauchte Lock-Resets seit der tiefsten Zeile */
+    int lock_reset_pending;    /**< Bewegung am Boden seit dem letzten game_advance() */
+    int lowest_y;              /**< Tiefste bisher erreichte Zeile des aktuellen Tetrominos */
 } GameState;
 
 /**
@@ -61,11 +291,28 @@ typedef struct {
  * 
  * Sets up a fresh game with empty board, random current and next pieces,
  * score=0, level=1, lines=0, and game running but not paused.
+ * The seed is derived from the monotonic clock and the address of
+ * @p game, so games initialized at the same time still differ.
  * 
  * @param game Pointer to GameState to initialize
+ * 
+ * @note Thread safety: writes @p game; calls on one game must not overlap.
  */
 void game_init(GameState *game);
 
+/**
+ * @brief Initializes a new game state with a fixed random seed
+ * 
+ * Same as game_init(), but the piece sequence is fully determined by
+ * @p seed, so replays, tests and simulations are reproducible.
+ * 
+ * @param game Pointer to GameState to initialize
+ * @param seed Seed for the game's random number generator
+ * 
+ * @note Thread safety: writes @p game; calls on one game must not overlap.
+ */
+void game_init_seeded(GameState *game, uint64_t seed);
+
 /**
  * @brief Resets the game state to initial values
  * 
@@ -73,6 +320,8 @@ void game_init(GameState *game);
  * Clears the board, resets score/level/lines, and generates new pieces.
  * 
  * @param game Pointer to GameState to reset
+ * 
+ * @note Thread safety: writes @p game; calls on one game must not overlap.
  */
 void game_reset(GameState *game);
 
@@ -85,6 +334,8 @@ void game_reset(GameState *game);
  * @param game Pointer to GameState
  * @param type Type of tetromino to spawn
  * @return 1 if spawn successful, 0 if blocked (Game Over condition)
+ * 
+ * @note Thread safety: writes @p game; calls on one game must not overlap.
  */
 int game_spawn_piece(GameState *game, TetrominoType type);
 
@@ -98,6 +349,8 @@ int game_spawn_piece(GameState *game, TetrominoType type);
  * @param dx Horizontal movement (positive=right, negative=left)
  * @param dy Vertical movement (positive=down, negative=up)
  * @return 1 if move successful, 0 if blocked by wall or other pieces
+ * 
+ * @note Thread safety: writes @p game; calls on one game must not overlap.
  */
 int game_move_current(GameState *game, int dx, int dy);
 
@@ -110,6 +363,8 @@ int game_move_current(GameState *game, int dx, int dy);
  * @param game Pointer to GameState
  * @param clockwise 1 for clockwise rotation, 0 for counter-clockwise
  * @return 1 if rotation successful, 0 if blocked (no wall-kick for MVP)
+ * 
+ * @note Thread safety: writes @p game; calls on one game must not overlap.
  */
 int game_rotate_current(GameState *game, int clockwise);
 
@@ -121,29 +376,94 @@ int game_rotate_current(GameState *game, int clockwise);
  * 
  * @param game Pointer to GameState
  * @return Number of cells the piece fell (0 if already at bottom)
+ * 
+ * @note Thread safety: writes @p game; calls on one game must not overlap.
  */
 int game_hard_drop(GameState *game);
 
+/**
+ * @brief Applies a sequence of input actions in one call
+ * 
+ * Meant for bots and replays that would otherwise call
+ * game_move_current() and game_rotate_current() once per step. The
+ * result is the same as applying the actions one by one, but a run of
+ * identical shifts is checked once: the free distance to the next
+ * obstacle in every row of the piece comes from the row masks, and the
+ * piece moves by the smaller of that and the run length. Runs of soft
+ * drops are capped by game_drop_distance() the same way.
+ * 
+ * Processing stops after the first action that locks a piece (a hard
+ * drop) or ends the game. INPUT_PAUSE, INPUT_QUIT, INPUT_NONE and
+ * INPUT_INVALID mean nothing to the engine and are skipped.
+ * 
+ * @param game Pointer to GameState
+ * @param actions Actions in the order they were issued
+ * @param count Number of actions
+ * @return Number of actions consumed, including the one that locked
+ * 
+ * @note Thread safety: writes @p game; calls on one game must not overlap.
+ */
+size_t game_apply_actions(GameState *game, const InputAction *actions, size_t count);
+
 /**
  * @brief Locks the current piece into the board
  * 
- * Transfers the current tetromino's cells to the board with its color,
- * then spawns the next piece and generates a new "next" piece.
- * Automatically clears completed lines and updates score.
+ * Convenience wrapper around game_commit_piece() for callers that
+ * only need the number of cleared lines.
  * 
  * @param game Pointer to GameState
  * @return Number of lines cleared after locking (0-4)
+ * 
+ * @note Thread safety: writes @p game; calls on one game must not overlap.
  */
 int game_lock_piece(GameState *game);
 
+/**
+ * @brief Commits the current piece and advances to the next one
+ * 
+ * The single authoritative piece transition. In this order it:
+ * 1. transfers the current tetromino's cells to the board,
+ * 2. clears completed lines and updates score, lines and level
+ *    (spin classification is taken first, see game_detect_spin()),
+ * 3. promotes the next piece to current, validating the spawn once
+ *    (a blocked spawn sets is_running=0),
+ * 4. draws exactly one new "next" piece and re-enables hold.
+ * 
+ * The clear outcome is also stored in game->last_clear.
+ * 
+ * @param game Pointer to GameState
+ * @return StepResult with locked=1, or all zero for an invalid piece
+ * 
+ * @note Thread safety: writes @p game; calls on one game must not overlap.
+ */
+StepResult game_commit_piece(GameState *game);
+
+/**
+ * @brief Advances the game by one gravity step
+ * 
+ * Moves the current piece one row down; if it cannot move, the piece
+ * is committed via game_commit_piece(). This is the only call a game
+ * loop needs per drop tick.
+ * 
+ * @param game Pointer to GameState
+ * @return StepResult describing the move or the lock
+ * 
+ * @note Thread safety: writes @p game; calls on one game must not overlap.
+ */
+StepResult game_step(GameState *game);
+
 /**
  * @brief Clears completed lines from the board
  * 
  * Scans the board for full lines, removes them, shifts lines down,
  * and updates the score and line count accordingly.
+ * The outcome (line count, cleared-rows mask, points) is stored in
+ * game->last_clear. Lines cleared this way never count as a spin.
  * 
  * @param game Pointer to GameState
  * @return Number of lines cleared (0-4)
+ * 
+ * @note Thread safety: writes @p game; calls on one game must not overlap.
  */
 int game_clear_lines(GameState *game);
 
@@ -159,9 +479,52 @@ int game_clear_lines(GameState *game);
  * @param lines_cleared Number of lines cleared (1-4)
  * @param level Current level (1+)
  * @return Points earned for this clear
+ * 
+ * @note Thread safety: pure function, safe to call from any thread.
  */
 int game_calculate_score(int lines_cleared, int level);
 
+/**
+ * @brief Calculates score for cleared lines including spin bonuses
+ * 
+ * Implements guideline scoring (all values × level):
+ * 
+ * | Lines | Normal | Mini spin | T-spin |
+ * |-------|--------|-----------|--------|
+ * | 0     | 0      | 100       | 400    |
+ * | 1     | 100    | 200       | 800    |
+ * | 2     | 300    | 400       | 1200   |
+ * | 3     | 500    | 500       | 1600   |
+ * | 4     | 800    | 800       | 800    |
+ * 
+ * @param lines_cleared Number of lines cleared (0-4)
+ * @param spin Spin classification of the locking piece
+ * @param level Current level (1+)
+ * @return Points earned for this lock, 0 for invalid parameters
+ * 
+ * @note Thread safety: pure function, safe to call from any thread.
+ */
+int game_calculate_spin_score(int lines_cleared, SpinType spin, int level);
+
+/**
+ * @brief Classifies the current piece as a spin if it locked now
+ * 
+ * A T piece whose last move was a rotation is tested with the
+ * 3-corner rule: the four cells diagonal to the T centre are packed
+ * into a 4-bit mask (walls and floor count as filled). Three or more
+ * filled corners make a spin; it is a full T-spin when both corners
+ * on the pointing side are filled, otherwise a mini.
+ * Other pieces (except O) count as a mini all-spin when they were
+ * rotated last and can move neither left, right nor up.
+ * 
+ * @param game Pointer to GameState
+ * @return Spin classification of game->current
+ * 
+ * @note Thread safety: reads @p game only; may run concurrently with other
+ *       read-only calls on the same game.
+ */
+SpinType game_detect_spin(const GameState *game);
+
 /**
  * @brief Validates if a tetromino position is valid
  * 
@@ -169,12 +532,56 @@ int game_calculate_score(int lines_cleared, int level);
  * colliding with any filled cells on the board.
  * Only considers cells with value 1 in the tetromino's shape matrix.
  * 
+ * Implemented as an AND of the shape's row masks with the padded
+ * Board::rows, so walls and floor need no separate range checks.
+ * 
  * @param game Pointer to GameState
  * @param t Pointer to Tetromino to validate
  * @return 1 if position is valid, 0 if collision or out of bounds
+ * 
+ * @note Thread safety: reads @p game only; may run concurrently with other
+ *       read-only calls on the same game.
  */
 int game_is_valid_position(const GameState *game, const Tetromino *t);
 
+/**
+ * @brief Rebuilds the occupancy masks from the cells
+ * 
+ * Sets the sentinel rows and walls, derives one row mask per board
+ * row from @c cells and recomputes Board::features. Needed after
+ * writing Board::cells directly; the game_* functions keep the masks
+ * and features up to date themselves.
+ * 
+ * @param board Pointer to Board
+ * 
+ * @note Thread safety: writes @p board; calls on one board must not overlap.
+ */
+void game_board_sync(Board *board);
+
+/**
+ * @brief Gets the board features after the last lock or clear
+ * 
+ * Maintained incrementally, so reading them costs nothing.
+ * 
+ * @param game Pointer to GameState
+ * @return Pointer to the features of the game's board
+ * 
+ * @note Thread safety: reads @p game only; may run concurrently with other
+ *       read-only calls on the same game.
+ */
+const BoardFeatures *game_get_features(const GameState *game);
+
+/**
+ * @brief Compares Board::features with a full recomputation
+ * 
+ * @param board Pointer to Board
+ * @return 1 if they match, 0 if the incremental update went wrong
+ * 
+ * @note Thread safety: reads @p board only; may run concurrently with other
+ *       read-only calls on the same board.
+ */
+int game_features_verify(const Board *board);
+
 /**
  * @brief Calculates fall speed in milliseconds for a given level
  * 
@@ -182,11 +589,67 @@ int game_is_valid_position(const GameState *game, const Tetromino *t);
  * Minimum speed is capped at 100ms.
  * Formula: max(100, 1000 - (level-1) * 100)
  * 
+ * Kept for callers that step gravity with game_step(); game_advance()
+ * uses the finer game_gravity() table instead.
+ * 
  * @param level Current level (1+)
  * @return Fall speed in milliseconds
+ * 
+ * @note Thread safety: pure function, safe to call from any thread.
  */
 int game_get_speed_ms(int level);
 
+/**
+ * @brief Gets the gravity of a level
+ * 
+ * Follows the guideline curve, (0.8 - (level-1) * 0.007)^(level-1)
+ * seconds per row, as a precomputed table; from level 19 on it is 20G.
+ * 
+ * @param level Current level (values below 1 count as 1)
+ * @return Rows per frame in units of GAME_GRAVITY_ONE
+ * 
+ * @note Thread safety: pure function, safe to call from any thread.
+ */
+uint32_t game_gravity(int level);
+
+/**
+ * @brief Gets how many rows the current piece can fall
+ * 
+ * Constant time: per occupied column of the piece, the distance to the
+ * stack is the number of trailing zeros of the board's column mask
+ * below the piece's lowest cell in that column.
+ * 
+ * @param game Pointer to GameState
+ * @return Rows to the landing position, 0 if the piece rests on the
+ *         stack or its position is invalid
+ * 
+ * @note Thread safety: reads @p game only; may run concurrently with other
+ *       read-only calls on the same game.
+ */
+int game_drop_distance(const GameState *game);
+
+/**
+ * @brief Advances gravity and lock delay to a point in time
+ * 
+ * The time-driven counterpart of game_step(). Gravity of the current
+ * level accumulates with the nanoseconds since the previous call and
+ * moves the piece down by whole rows at once; at 20G it lands in the
+ * same call. A grounded piece locks GAME_LOCK_DELAY_NS after it
+ * touched down; each successful move or rotation on the ground pushes
+ * the deadline back, at most GAME_LOCK_RESETS times per lowest row.
+ * 
+ * The first call only starts the clock. While the game is paused the
+ * clock keeps running but gravity does not, and the lock deadline moves
+ * along with the pause.
+ * 
+ * @param game Pointer to GameState
+ * @param now_ns Current time on a monotonic clock, in nanoseconds
+ * @return What happened; locked=1 when the lock delay ran out
+ * 
+ * @note Thread safety: writes @p game; calls on one game must not overlap.
+ */
+StepResult game_advance(GameState *game, uint64_t now_ns);
+
 /**
  * @brief Checks if the game is over
  * 
@@ -195,6 +658,9 @@ int game_get_speed_ms(int level);
  * 
  * @param game Pointer to GameState
  * @return 1 if game over, 0 if game can continue
+ * 
+ * @note Thread safety: reads @p game only; may run concurrently with other
+ *       read-only calls on the same game.
  */
 int game_check_game_over(const GameState *game);
 
@@ -203,6 +669,9 @@ int game_check_game_over(const GameState *game);
  * 
  * @param game Pointer to GameState
  * @return Type of the next tetromino (0-6)
+ * 
+ * @note Thread safety: reads @p game only; may run concurrently with other
+ *       read-only calls on the same game.
  */
 TetrominoType game_get_next_type(const GameState *game);
 
@@ -211,7 +680,134 @@ TetrominoType game_get_next_type(const GameState *game);
  * 
  * @param game Pointer to GameState
  * @param type Type of tetromino to set as next
+ * 
+ * @note Thread safety: writes @p game; calls on one game must not overlap.
  */
 void game_set_next_type(GameState *game, TetrominoType type);
 
+/**
+ * @brief Gets the types the randomizer can draw next
+ *
+ * The next draw is the piece that enters the preview after the visible
+ * next piece has been promoted. Chance nodes of a search only need to
+ * expand the types in this set, each with probability
+ * game_draw_probability().
+ *
+ * A type set with game_set_next_type() does not change the bag.
+ *
+ * @param game Pointer to GameState
+ * @return Set of types still in the current bag (never empty)
+ *
+ * @note Thread safety: reads @p game only; may run concurrently with other
+ *       read-only calls on the same game.
+ */
+unsigned int game_bag(const GameState *game);
+
+/**
+ * @brief Gets the exact probability that the next draw is @p type
+ *
+ * @param game Pointer to GameState
+ * @param type Tetromino type
+ * @return 1 / (types left in the bag) if @p type is in it, 0 otherwise
+ *
+ * @note Thread safety: reads @p game only; may run concurrently with other
+ *       read-only calls on the same game.
+ */
+double game_draw_probability(const GameState *game, TetrominoType type);
+
+/**
+ * @brief Gets the bag after @p type has been drawn from it
+ *
+ * Lets a search follow the bag down several chance levels without a
+ * GameState.
+ *
+ * @param bag Set of types in the bag, as returned by game_bag()
+ * @param type Drawn type (must be in @p bag)
+ * @return Remaining set, or GAME_BAG_FULL if @p type was the last one
+ *
+ * @note Thread safety: pure function, safe to call from any thread.
+ */
+unsigned int game_bag_after(unsigned int bag, TetrominoType type);
+
+/**
+ * @brief Swaps the current piece with the hold slot
+ * 
+ * The current piece's type goes into the hold slot and the previously
+ * held type (or, with an empty slot, the next piece) respawns at the
+ * starting position. Only piece types are exchanged; position and
+ * rotation of the swapped-out piece are discarded.
+ * Hold is allowed once per drop; the lock flag is cleared when the
+ * next piece is promoted by game_commit_piece().
+ * 
+ * @param game Pointer to GameState
+ * @return 1 if the swap happened, 0 if hold was already used this drop
+ *         or the incoming piece is blocked (Game Over condition)
+ * 
+ * @note Thread safety: writes @p game; calls on one game must not overlap.
+ */
+int game_hold_piece(GameState *game);
+
+/**
+ * @brief Checks whether hold is available for the current drop
+ * 
+ * @param game Pointer to GameState
+ * @return 1 if game_hold_piece() may be called, 0 otherwise
+ * 
+ * @note Thread safety: reads @p game only; may run concurrently with other
+ *       read-only calls on the same game.
+ */
+int game_can_hold(const GameState *game);
+
+/**
+ * @brief Gets the type in the hold slot
+ * 
+ * @param game Pointer to GameState
+ * @return Held tetromino type, or TETRO_COUNT if the slot is empty
+ * 
+ * @note Thread safety: reads @p game only; may run concurrently with other
+ *       read-only calls on the same game.
+ */
+TetrominoType game_get_hold_type(const GameState *game);
+
+/**
+ * @brief Gets the piece type that would be active after a hold
+ * 
+ * Lets search code branch over both candidates (current and
+ * hold alternative) without performing the swap.
+ * 
+ * @param game Pointer to GameState
+ * @return Held type, or the next type if the hold slot is empty
+ * 
+ * @note Thread safety: reads @p game only; may run concurrently with other
+ *       read-only calls on the same game.
+ */
+TetrominoType game_get_hold_alternative(const GameState *game);
+
+/**
+ * @brief Takes the oldest pending event from the game's event queue
+ * 
+ * The engine appends events while it runs (lock, line clear, level
+ * change, game over); callers drain them once per frame instead of
+ * diffing the whole GameState. When the queue is full, new events are
+ * dropped and counted in game->events_dropped.
+ * 
+ * @param game Pointer to GameState
+ * @param event Output for the dequeued event
+ * @return 1 if an event was returned, 0 if the queue is empty
+ * 
+ * @note Thread safety: writes @p game; calls on one game must not overlap.
+ */
+int game_poll_event(GameState *game, GameEvent *event);
+
+/**
+ * @brief Gets the number of events waiting in the queue
+ * 
+ * @param game Pointer to GameState
+ * @return Number of pending events
+ * 
+ * @note Thread safety: reads @p game only; may run concurrently with other
+ *       read-only calls on the same game.
+ */
+int game_pending_events(const GameState *game);
+
 #endif /* GAME_H */
@@ -0,0 +1,112 @@
+/**
+ * @file glyphs.c
+ * @brief Packed cell glyph tables
+ */
+
+#include "glyphs.h"
+
+#include <assert.h>
+
+/**
+ * @brief Half block per mask (bit 0 = upper cell, bit 1 = lower cell)
+ */
+static const char HALF_BLOCKS[4][4] = { " ", "▀", "▄", "█" };
+
+/**
+ * @brief Braille pattern per mask, UTF-8 encoded
+ *
+ * Mask bit (2 * row + column) maps to braille dots 1 4 / 2 5 / 3 6 /
+ * 7 8, i.e. code point U+2800 plus the dot bits.
+ */
+static const char BRAILLE[256][4] = {
+    "\xE2\xA0\x80", "\xE2\xA0\x81", "\xE2\xA0\x88", "\xE2\xA0\x89",
+    "\xE2\xA0\x82", "\xE2\xA0\x83", "\xE2\xA0\x8A", "\xE2\xA0\x8B",
+    "\xE2\xA0\x90", "\xE2\xA0\x91", "\xE2\xA0\x98", "\xE2\xA0\x99",
+    "\xE2\xA0\x92", "\xE2\xA0\x93", "\xE2\xA0\x9A", "\xE2\xA0\x9B",
+    "\xE2\xA0\x84", "\xE2\xA0\x85", "\xE2\xA0\x8C", "\xE2\xA0\x8D",
+    "\xE2\xA0\x86", "\xE2\xA0\x87", "\xE2\xA0\x8E", "\xE2\xA0\x8F",
+    "\xE2\xA0\x94", "\xE2\xA0\x95", "\xE2\xA0\x9C", "\xE2\xA0\x9D",
+    "\xE2\xA0\x96", "\xE2\xA0\x97", "\xE2\xA0\x9E", "\xE2\xA0\x9F",
+    "\xE2\xA0\xA0", "\xE2\xA0\xA1", "\xE2\xA0\xA8", "\xE2\xA0\xA9",
+    "\xE2\xA0\xA2", "\xE2\xA0\xA3", "\xE2\xA0\xAA", "\xE2\xA0\xAB",
+    "\xE2\xA0\xB0", "\xE2\xA0\xB1", "\xE2\xA0\xB8", "\xE2\xA0\xB9",
+    "\xE2\xA0\xB2", "\xE2\xA0\xB3", "\xE2\xA0\xBA", "\xE2\xA0\xBB",
+    "\xE2\xA0\xA4", "\xE2\xA0\xA5", "\xE2\xA0\xAC", "\xE2\xA0\xAD",
+    "\xE2\xA0\xA6", "\xE2\xA0\xA7", "\xE2\xA0\xAE", "\xE2\xA0\xAF",
+    "\xE2\xA0\xB4", "\xE2\xA0\xB5", "\xE2\xA0\xBC", "\xE2\xA0\xBD",
+    "\xE2\xA0\xB6", "\xE2\xA0\xB7", "\xE2\xA0\xBE", "\xE2\xA0\xBF",
+    "\xE2\xA1\x80", "\xE2\xA1\x81", "\xE2\xA1\x88", "\xE2\xA1\x89",
+    "\xE2\xA1\x82", "\xE2\xA1\x83", "\xE2\xA1\x8A", "\xE2\xA1\x8B",
+    "\xE2\xA1\x90", "\xE2\xA1\x91", "\xE2\xA1\x98", "\xE2\xA1\x99",
+    "\xE2\xA1\x92", "\xE2\xA1\x93", "\xE2\xA1\x9A", "\xE2\xA1\x9B",
+    "\xE2\xA1\x84", "\xE2\xA1\x85", "\xE2\xA1\x8C", "\xE2\xA1\x8D",
+    "\xE2\xA1\x86", "\xE2\xA1\x87", "\xE2\xA1\x8E", "\xE2\xA1\x8F",
+    "\xE2\xA1\x94", "\xE2\xA1\x95", "\xE2\xA1\x9C", "\xE2\xA1\x9D",
+    "\xE2\xA1\x96", "\xE2\xA1\x97", "\xE2\xA1\x9E", "\xE2\xA1\x9F",
+    "\xE2\xA1\xA0", "\xE2\xA1\xA1", "\xE2\xA1\xA8", "\xE2\xA1\xA9",
+    "\xE2\xA1\xA2", "\xE2\xA1\xA3", "\xE2\xA1\xAA", "\xE2\xA1\xAB",
+    "\xE2\xA1\xB0", "\xE2\xA1\xB1", "\xE2\xA1\xB8", "\xE2\xA1\xB9",
+    "\xE2\xA1\xB2", "\xE2\xA1\xB3", "\xE2\xA1\xBA", "\xE2\xA1\xBB",
+    "\xE2\xA1\xA4", "\xE2\xA1\xA5", "\xE2\xA1\xAC", "\xE2\xA1\xAD",
+    "\xE2\xA1\xA6", "\xE2\xA1\xA7", "\xE2\xA1\xAE", "\xE2\xA1\xAF",
+    "\xE2\xA1\xB4", "\xE2\xA1\xB5", "\xE2\xA1\xBC", "\xE2\xA1\xBD",
+    "\xE2\xA1\xB6", "\xE2\xA1\xB7", "\xE2\xA1\xBE", "\xE2\xA1\xBF",
+    "\xE2\xA2\x80", "\xE2\xA2\x81", "\xE2\xA2\x88", "\xE2\xA2\x89",
+    "\xE2\xA2\x82", "\xE2\xA2\x83", "\xE2\xA2\x8A", "\xE2\xA2\x8B",
+    "\xE2\xA2\x90", "\xE2\xA2\x91", "\xE2\xA2\x98", "\xE2\xA2\x99",
+    "\xE2\xA2\x92", "\xE2\xA2\x93", "\xE2\xA2\x9A", "\xE2\xA2\x9B",
+    "\xE2\xA2\x84", "\xE2\xA2\x85", "\xE2\xA2\x8C", "\xE2\xA2\x8D",
+    "\xE2\xA2\x86", "\xE2\xA2\x87", "\xE2\xA2\x8E", "\xE2\xA2\x8F",
+    "\xE2\xA2\x94", "\xE2\xA2\x95", "\xE2\xA2\x9C", "\xE2\xA2\x9D",
+    "\xE2\xA2\x96", "\xE2\xA2\x97", "\xE2\xA2\x9E", "\xE2\xA2\x9F",
+    "\xE2\xA2\xA0", "\xE2\xA2\xA1", "\xE2\xA2\xA8", "\xE2\xA2\xA9",
+    "\xE2\xA2\xA2", "\xE2\xA2\xA3", "\xE2\xA2\xAA", "\xE2\xA2\xAB",
+    "\xE2\xA2\xB0", "\xE2\xA2\xB1", "\xE2\xA2\xB8", "\xE2\xA2\xB9",
+    "\xE2\xA2\xB2", "\xE2\xA2\xB3", "\xE2\xA2\xBA", "\xE2\xA2\xBB",
+    "\xE2\xA2\xA4", "\xE2\xA2\xA5", "\xE2\xA2\xAC", "\xE2\xA2\xAD",
+    "\xE2\xA2\xA6", "\xE2\xA2\xA7", "\xE2\xA2\xAE", "\xE2\xA2\xAF",
+    "\xE2\xA2\xB4", "\xE2\xA2\xB5", "\xE2\xA2\xBC", "\xE2\xA2\xBD",
+    "\xE2\xA2\xB6", "\xE2\xA2\xB7", "\xE2\xA2\xBE", "\xE2\xA2\xBF",
+    "\xE2\xA3\x80", "\xE2\xA3\x81", "\xE2\xA3\x88", "\xE2\xA3\x89",
+    "\xE2\xA3\x82", "\xE2\xA3\x83", "\xE2\xA3\x8A", "\xE2\xA3\x8B",
+    "\xE2\xA3\x90", "\xE2\xA3\x91", "\xE2\xA3\x98", "\xE2\xA3\x99",
+    "\xE2\xA3\x92", "\xE2\xA3\x93", "\xE2\xA3\x9A", "\xE2\xA3\x9B",
+    "\xE2\xA3\x84", "\xE2\xA3\x85", "\xE2\xA3\x8C", "\xE2\xA3\x8D",
+    "\xE2\xA3\x86", "\xE2\xA3\x87", "\xE2\xA3\x8E", "\xE2\xA3\x8F",
+    "\xE2\xA3\x94", "\xE2\xA3\x95", "\xE2\xA3\x9C", "\xE2\xA3\x9D",
+    "\xE2\xA3\x96", "\xE2\xA3\x97", "\xE2\xA3\x9E", "\xE2\xA3\x9F",
+    "\xE2\xA3\xA0", "\xE2\xA3\xA1", "\xE2\xA3\xA8", "\xE2\xA3\xA9",
+    "\xE2\xA3\xA2", "\xE2\xA3\xA3", "\xE2\xA3\xAA", "\xE2\xA3\xAB",
+    "\xE2\xA3\xB0", "\xE2\xA3\xB1", "\xE2\xA3\xB8", "\xE2\xA3\xB9",
+    "\xE2\xA3\xB2", "\xE2\xA3\xB3", "\xE2\xA3\xBA", "\xE2\xA3\xBB",
+    "\xE2\xA3\xA4", "\xE2\xA3\xA5", "\xE2\xA3\xAC", "\xE2\xA3\xAD",
+    "\xE2\xA3\xA6", "\xE2\xA3\xA7", "\xE2\xA3\xAE", "\xE2\xA3\xAF",
+    "\xE2\xA3\xB4", "\xE2\xA3\xB5", "\xE2\xA3\xBC", "\xE2\xA3\xBD",
+    "\xE2\xA3\xB6", "\xE2\xA3\xB7", "\xE2\xA3\xBE", "\xE2\xA3\xBF",
+};
+
+unsigned int glyphs_half_mask(uint32_t top, uint32_t bottom, int x)
+{
+    return ((top >> x) & 1u) | (((bottom >> x) & 1u) << 1);
+}
+
+unsigned int glyphs_braille_mask(const uint32_t rows[GLYPHS_BRAILLE_ROWS], int x)
+{
+    unsigned int mask = 0;
+    for (int row = 0; row < GLYPHS_BRAILLE_ROWS; row++) {
+        mask |= ((rows[row] >> x) & 3u) << (2 * row);
+    }
+    return mask;
+}
+
+const char *glyphs_half(unsigned int mask)
+{
+    assert(mask < 4);
+    return HALF_BLOCKS[mask];
+}
+
+const char *glyphs_braille(unsigned int mask)
+{
+    assert(mask < 256);
+    return BRAILLE[mask];
+}
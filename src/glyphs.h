@@ -0,0 +1,68 @@
+/**
+ * @file glyphs.h
+ * @brief Packed cell glyphs: half blocks and braille
+ *
+ * Packs several board cells into one terminal character for dense
+ * views. A half block shows 1x2 cells (▀ ▄ █), a braille pattern 2x4
+ * cells (U+2800-U+28FF). Glyphs are looked up in precomputed tables by
+ * a cell mask that is cut straight out of per-row bitmasks, so encoding
+ * costs no branching per cell.
+ *
+ * Packed glyphs only show whether a cell is filled, not its color.
+ *
+ * @author Tetris CLI Project
+ * @version 1.0
+ */
+
+#ifndef GLYPHS_H
+#define GLYPHS_H
+
+#include <stdint.h>
+
+/**
+ * @brief Cells per braille glyph horizontally and vertically
+ */
+#define GLYPHS_BRAILLE_COLS 2
+#define GLYPHS_BRAILLE_ROWS 4
+
+/**
+ * @brief Cells per half block glyph vertically
+ */
+#define GLYPHS_HALF_ROWS 2
+
+/**
+ * @brief Builds the mask of a half block glyph
+ *
+ * @param top Bitmask of the upper row (bit x = column x filled)
+ * @param bottom Bitmask of the lower row
+ * @param x Board column of the glyph
+ * @return Bit 0 = upper cell, bit 1 = lower cell
+ */
+unsigned int glyphs_half_mask(uint32_t top, uint32_t bottom, int x);
+
+/**
+ * @brief Builds the mask of a braille glyph
+ *
+ * @param rows Bitmasks of the four rows the glyph covers
+ * @param x Board column of the glyph's left cell
+ * @return Bit (2 * row + column) set for every filled cell
+ */
+unsigned int glyphs_braille_mask(const uint32_t rows[GLYPHS_BRAILLE_ROWS], int x);
+
+/**
+ * @brief Gets the half block character for a mask
+ *
+ * @param mask Mask from glyphs_half_mask() (0-3)
+ * @return UTF-8 string (" ", "▀", "▄" or "█")
+ */
+const char *glyphs_half(unsigned int mask);
+
+/**
+ * @brief Gets the braille character for a mask
+ *
+ * @param mask Mask from glyphs_braille_mask() (0-255)
+ * @return UTF-8 string of the braille pattern with those dots raised
+ */
+const char *glyphs_braille(unsigned int mask);
+
+#endif /* GLYPHS_H */
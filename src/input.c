@@ -4,14 +4,76 @@
  */
 
 #include "input.h"
+#include "input_queue.h"
 
 #include <ncurses.h>
+#include <poll.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <string.h>
+#include <unistd.h>
 
 /**
  * @brief Internal flag to track initialization state
  */
 static int input_initialized = 0;
 
+/**
+ * @brief Poll timeout of the input thread, bounds the stop latency
+ */
+#define INPUT_THREAD_POLL_MS 10
+
+/**
+ * @brief Time an incomplete escape sequence waits for its remaining bytes
+ *
+ * Plays the role of ncurses' ESCDELAY: after it, a lone ESC or a
+ * cut-off sequence is dropped.
+ */
+#define INPUT_ESCAPE_TIMEOUT_NS 50000000ULL
+
+/**
+ * @brief Input thread state
+ */
+static pthread_t input_thread;
+static int input_thread_running = 0;
+static atomic_int input_thread_stop_flag;
+
+/**
+ * @brief Map a plain (non-arrow) key to its action
+ */
+static InputAction map_key(int ch)
+{
+    switch (ch) {
+        /* Space bar - hard drop */
+        case ' ':
+            return INPUT_HARD_DROP;
+            
+        /* z or Z - rotate counter-clockwise */
+        case 'z':
+        case 'Z':
+            return INPUT_ROTATE_CCW;
+            
+        /* c or C - hold */
+        case 'c':
+        case 'C':
+            return INPUT_HOLD;
+            
+        /* p or P - pause */
+        case 'p':
+        case 'P':
+            return INPUT_PAUSE;
+            
+        /* q or Q - quit */
+        case 'q':
+        case 'Q':
+            return INPUT_QUIT;
+            
+        /* Unknown key */
+        default:
+            return INPUT_INVALID;
+    }
+}
+
 void input_init(void)
 {
     if (input_initialized) {
@@ -76,30 +138,7 @@ InputAction input_get_action(void)
     }
 
     /* Handle regular ASCII keys */
-    switch (ch) {
-        /* Space bar - hard drop */
-        case ' ':
-            return INPUT_HARD_DROP;
-            
-        /* z or Z - rotate counter-clockwise */
-        case 'z':
-        case 'Z':
-            return INPUT_ROTATE_CCW;
-            
-        /* p or P - pause */
-        case 'p':
-        case 'P':
-            return INPUT_PAUSE;
-            
-        /* q or Q - quit */
-        case 'q':
-        case 'Q':
-            return INPUT_QUIT;
-            
-        /* Unknown key */
-        default:
-            return INPUT_INVALID;
-    }
+    return map_key(ch);
 }
 
 int input_has_input(void)
@@ -118,3 +157,133 @@ int input_has_input(void)
     ungetch(ch);
     return 1;
 }
+
+size_t input_decode(const unsigned char *buf, size_t len, InputAction *action)
+{
+    if (buf == NULL || len == 0 || action == NULL) {
+        return 0;
+    }
+
+    if (buf[0] != 0x1B) {
+        *action = map_key(buf[0]);
+        return 1;
+    }
+
+    /* ESC, ESC [ and ESC O may be the start of an arrow key split across reads */
+    if (len == 1 || (len == 2 && (buf[1] == '[' || buf[1] == 'O'))) {
+        return 0;
+    }
+
+    /* Arrow keys: ESC [ x (normal) or ESC O x (application mode) */
+    if (len >= 3 && (buf[1] == '[' || buf[1] == 'O')) {
+        switch (buf[2]) {
+            case 'A':
+                *action = INPUT_ROTATE_CW;
+                return 3;
+            case 'B':
+                *action = INPUT_DOWN;
+                return 3;
+            case 'C':
+                *action = INPUT_RIGHT;
+                return 3;
+            case 'D':
+                *action = INPUT_LEFT;
+                return 3;
+            default:
+                break;
+        }
+    }
+
+    /* Other CSI sequence: skip up to and including its final byte */
+    size_t used = 1;
+    if (len >= 2 && buf[1] == '[') {
+        used = 2;
+        while (used < len && !(buf[used] >= 0x40 && buf[used] <= 0x7E)) {
+            used++;
+        }
+        if (used == len) {
+            /* Final byte not read yet */
+            return 0;
+        }
+        used++;
+    }
+    *action = INPUT_INVALID;
+    return used;
+}
+
+/**
+ * @brief Input thread: read stdin, decode, push timestamped actions
+ */
+static void *input_thread_main(void *arg)
+{
+    InputQueue *queue = arg;
+    struct pollfd pfd = { .fd = STDIN_FILENO, .events = POLLIN };
+    unsigned char buf[64];
+    size_t pending = 0;             /* Incomplete escape sequence kept from the last read */
+    uint64_t pending_since = 0;
+
+    while (!atomic_load(&input_thread_stop_flag)) {
+        if (poll(&pfd, 1, INPUT_THREAD_POLL_MS) <= 0) {
+            /* No continuation in time: a lone ESC or a cut-off sequence, no action */
+            if (pending > 0 && input_queue_now_ns() - pending_since >= INPUT_ESCAPE_TIMEOUT_NS) {
+                pending = 0;
+            }
+            continue;
+        }
+
+        ssize_t n = read(STDIN_FILENO, buf + pending, sizeof(buf) - pending);
+        if (n <= 0) {
+            continue;
+        }
+
+        size_t len = pending + (size_t)n;
+        TimedInput input = { .timestamp_ns = input_queue_now_ns() };
+        size_t pos = 0;
+        while (pos < len) {
+            size_t used = input_decode(buf + pos, len - pos, &input.action);
+            if (used == 0) {
+                break;
+            }
+            pos += used;
+            if (input.action != INPUT_INVALID) {
+                input_queue_push(queue, &input);
+            }
+        }
+
+        /* Keep an incomplete sequence for the next read, unless it fills the buffer */
+        pending = len - pos < sizeof(buf) ? len - pos : 0;
+        if (pending > 0) {
+            memmove(buf, buf + pos, pending);
+            pending_since = input.timestamp_ns;
+        }
+    }
+
+    return NULL;
+}
+
+int input_thread_start(InputQueue *queue)
+{
+    if (queue == NULL || input_thread_running) {
+        return 0;
+    }
+
+    atomic_store(&input_thread_stop_flag, 0);
+
+    if (pthread_create(&input_thread, NULL, input_thread_main, queue) != 0) {
+        return 0;
+    }
+
+    input_thread_running = 1;
+    return 1;
+}
+
+void input_thread_stop(void)
+{
+    if (!input_thread_running) {
+        return;
+    }
+
+    atomic_store(&input_thread_stop_flag, 1);
+    pthread_join(input_thread, NULL);
+    input_thread_running = 0;
+}
@@ -13,6 +13,10 @@
 #ifndef INPUT_H
 #define INPUT_H
 
+#include <stddef.h>
+
+struct InputQueue;
+
 /**
  * @brief Input action types
  * 
@@ -27,6 +31,7 @@ typedef enum {
     INPUT_ROTATE_CW,      /**< Rotate clockwise (↑ arrow) */
     INPUT_ROTATE_CCW,     /**< Rotate counter-clockwise (z/Z key) */
     INPUT_HARD_DROP,      /**< Hard drop (spacebar) */
+    INPUT_HOLD,           /**< Hold piece (c/C key) */
     INPUT_PAUSE,          /**< Pause game (p/P key) */
     INPUT_QUIT,           /**< Quit game (q/Q key) */
     INPUT_INVALID         /**< Invalid/unknown key */
@@ -74,6 +79,7 @@ void input_cleanup(void);
  * - Arrow Up    → INPUT_ROTATE_CW
  * - Space       → INPUT_HARD_DROP
  * - z, Z        → INPUT_ROTATE_CCW
+ * - c, C        → INPUT_HOLD
  * - p, P        → INPUT_PAUSE
  * - q, Q        → INPUT_QUIT
  */
@@ -92,4 +98,46 @@ InputAction input_get_action(void);
  */
 int input_has_input(void);
 
+/**
+ * @brief Decode one action from raw terminal bytes
+ * 
+ * Understands the same keys as input_get_action(). Arrow keys are
+ * accepted in both normal (ESC [ A) and application (ESC O A) cursor
+ * mode; other escape sequences decode to INPUT_INVALID.
+ * 
+ * A key's bytes may arrive split across reads. When @p buf holds only
+ * the start of an escape sequence (ESC, ESC [, ESC O or a CSI sequence
+ * without its final byte), nothing is consumed; the caller keeps the
+ * bytes and decodes again once more have arrived.
+ * 
+ * @param buf Raw bytes read from the terminal
+ * @param len Number of bytes in @p buf
+ * @param action Output for the decoded action
+ * @return Number of bytes consumed, 0 if @p len is 0 or the sequence
+ *         is incomplete
+ */
+size_t input_decode(const unsigned char *buf, size_t len, InputAction *action);
+
+/**
+ * @brief Start the dedicated input thread
+ * 
+ * The thread reads the terminal (stdin) directly, independent of
+ * logic and rendering, and pushes timestamped actions into @p queue.
+ * The game loop drains the queue with input_queue_pop(). While the
+ * thread runs, input_get_action() must not be used.
+ * 
+ * @param queue Initialized queue; the input thread is its only producer
+ * @return 1 if the thread was started, 0 on failure or if already running
+ * 
+ * @warning Requires input_init() so the terminal is in cbreak/noecho mode
+ */
+int input_thread_start(struct InputQueue *queue);
+
+/**
+ * @brief Stop the input thread and wait for it to exit
+ * 
+ * Safe to call when no thread is running.
+ */
+void input_thread_stop(void);
+
 #endif /* INPUT_H */
@@ -0,0 +1,74 @@
+/**
+ * @file input_queue.c
+ * @brief SPSC input queue implementation
+ */
+
+#include "input_queue.h"
+
+#include <assert.h>
+#include <time.h>
+
+void input_queue_init(InputQueue *queue)
+{
+    assert(queue != NULL);
+
+    atomic_init(&queue->head, 0);
+    atomic_init(&queue->tail, 0);
+    atomic_init(&queue->dropped, 0);
+    queue->cached_head = 0;
+    queue->cached_tail = 0;
+}
+
+int input_queue_push(InputQueue *queue, const TimedInput *input)
+{
+    assert(queue != NULL);
+    assert(input != NULL);
+
+    size_t tail = atomic_load_explicit(&queue->tail, memory_order_relaxed);
+
+    if (tail - queue->cached_head >= INPUT_QUEUE_SIZE) {
+        /* Looks full: refresh the view of the consumer's index once */
+        queue->cached_head = atomic_load_explicit(&queue->head, memory_order_acquire);
+        if (tail - queue->cached_head >= INPUT_QUEUE_SIZE) {
+            atomic_fetch_add_explicit(&queue->dropped, 1, memory_order_relaxed);
+            return 0;
+        }
+    }
+
+    queue->slots[tail & (INPUT_QUEUE_SIZE - 1)] = *input;
+    atomic_store_explicit(&queue->tail, tail + 1, memory_order_release);
+    return 1;
+}
+
+int input_queue_pop(InputQueue *queue, TimedInput *input)
+{
+    assert(queue != NULL);
+    assert(input != NULL);
+
+    size_t head = atomic_load_explicit(&queue->head, memory_order_relaxed);
+
+    if (head == queue->cached_tail) {
+        /* Looks empty: refresh the view of the producer's index once */
+        queue->cached_tail = atomic_load_explicit(&queue->tail, memory_order_acquire);
+        if (head == queue->cached_tail) {
+            return 0;
+        }
+    }
+
+    *input = queue->slots[head & (INPUT_QUEUE_SIZE - 1)];
+    atomic_store_explicit(&queue->head, head + 1, memory_order_release);
+    return 1;
+}
+
+unsigned long input_queue_dropped(const InputQueue *queue)
+{
+    assert(queue != NULL);
+    return atomic_load_explicit(&queue->dropped, memory_order_relaxed);
+}
+
+uint64_t input_queue_now_ns(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000ULL + (uint64_t)now.tv_nsec;
+}
@@ -0,0 +1,103 @@
+/**
+ * @file input_queue.h
+ * @brief Wait-free single-producer/single-consumer queue for input events
+ *
+ * Carries timestamped InputActions from the input thread to the game
+ * logic. Push and pop never block or retry: each side owns one index,
+ * publishes it with a release store and caches the other side's index
+ * so the shared cache line is only touched when the cached view runs
+ * out. Producer and consumer fields sit on separate cache lines to
+ * avoid false sharing.
+ *
+ * Exactly one thread may push and exactly one (other) thread may pop.
+ *
+ * @author Tetris CLI Project
+ * @version 1.0
+ */
+
+#ifndef INPUT_QUEUE_H
+#define INPUT_QUEUE_H
+
+#include <stdatomic.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "input.h"
+
+/**
+ * @brief Queue capacity in events (power of two)
+ */
+#define INPUT_QUEUE_SIZE 256
+
+/**
+ * @brief Assumed cache line size for padding
+ */
+#define INPUT_QUEUE_CACHE_LINE 64
+
+/**
+ * @brief An input action with the time it was read
+ */
+typedef struct {
+    InputAction action;         /**< Decoded action */
+    uint64_t timestamp_ns;      /**< CLOCK_MONOTONIC time of the read */
+} TimedInput;
+
+/**
+ * @brief SPSC ring buffer
+ */
+typedef struct InputQueue {
+    /* Consumer side */
+    _Alignas(INPUT_QUEUE_CACHE_LINE) atomic_size_t head;   /**< Next slot to pop */
+    size_t cached_tail;                                     /**< Consumer's view of tail */
+
+    /* Producer side */
+    _Alignas(INPUT_QUEUE_CACHE_LINE) atomic_size_t tail;   /**< Next slot to push */
+    size_t cached_head;                                     /**< Producer's view of head */
+    atomic_ulong dropped;                                   /**< Pushes rejected while full */
+
+    _Alignas(INPUT_QUEUE_CACHE_LINE) TimedInput slots[INPUT_QUEUE_SIZE]; /**< Event storage */
+} InputQueue;
+
+/**
+ * @brief Initializes an empty queue
+ *
+ * @param queue Pointer to queue
+ */
+void input_queue_init(InputQueue *queue);
+
+/**
+ * @brief Appends an event (producer only)
+ *
+ * @param queue Pointer to queue
+ * @param input Event to append
+ * @return 1 if appended, 0 if the queue was full (the event is counted
+ *         in queue->dropped)
+ */
+int input_queue_push(InputQueue *queue, const TimedInput *input);
+
+/**
+ * @brief Removes the oldest event (consumer only)
+ *
+ * @param queue Pointer to queue
+ * @param input Output for the removed event
+ * @return 1 if an event was removed, 0 if the queue was empty
+ */
+int input_queue_pop(InputQueue *queue, TimedInput *input);
+
+/**
+ * @brief Gets the number of events rejected because the queue was full
+ *
+ * May be called from any thread.
+ *
+ * @param queue Pointer to queue
+ * @return Number of dropped events
+ */
+unsigned long input_queue_dropped(const InputQueue *queue);
+
+/**
+ * @brief Reads the monotonic clock in nanoseconds
+ *
+ * @return Current CLOCK_MONOTONIC time in ns
+ */
+uint64_t input_queue_now_ns(void);
+
+#endif /* INPUT_QUEUE_H */
@@ -13,21 +13,21 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <time.h>
+#include <unistd.h>
 #include <ncurses.h>
+#include <sys/ioctl.h>
 #include "tetromino.h"
 #include "game.h"
 #include "renderer.h"
 #include "input.h"
+#include "input_queue.h"
+#include "metrics.h"
+#include "recorder.h"
 
 /**
- * @brief Timing state for game loop
- *
- * Tracks timing information for piece dropping and other time-based events.
+ * @brief Frames between updates of the sampled metrics (about 1 s)
  */
-typedef struct {
-    struct timespec last_drop;     /**< Time of last automatic drop */
-    struct timespec last_input;    /**< Time of last input processing */
-} TimingState;
+#define METRICS_SAMPLE_FRAMES 100
 
 /**
  * @brief Process player input actions
@@ -76,6 +76,12 @@ static void process_input(GameState *game, InputAction action) {
             }
             break;
 
+        case INPUT_HOLD:
+            if (!game->is_paused) {
+                game_hold_piece(game);
+            }
+            break;
+
         case INPUT_PAUSE:
             game->is_paused = !game->is_paused;
             break;
@@ -92,57 +98,10 @@ static void process_input(GameState *game, InputAction action) {
 }
 
 /**
- * @brief Check if it's time for the piece to drop automatically
- *
- * Compares current time with the last drop time and the current level's
- * speed to determine if the piece should drop.
- *
- * @param game Pointer to the game state
- * @param timing Pointer to timing state
- * @return 1 if piece should drop, 0 otherwise
- */
-static int time_to_drop(const GameState *game, TimingState *timing) {
-    struct timespec now;
-    clock_gettime(CLOCK_MONOTONIC, &now);
-
-    int speed_ms = game_get_speed_ms(game->level);
-    struct timespec drop_interval = {
-        .tv_sec = speed_ms / 1000,
-        .tv_nsec = (speed_ms % 1000) * 1000000L
-    };
-
-    struct timespec diff = {
-        .tv_sec = now.tv_sec - timing->last_drop.tv_sec,
-        .tv_nsec = now.tv_nsec - timing->last_drop.tv_nsec
-    };
-
-    /* Normalize nanoseconds if negative */
-    if (diff.tv_nsec < 0) {
-        diff.tv_sec--;
-        diff.tv_nsec += 1000000000L;
-    }
-
-    /* Check if enough time has passed */
-    if (diff.tv_sec > drop_interval.tv_sec ||
-        (diff.tv_sec == drop_interval.tv_sec &&
-         diff.tv_nsec >= drop_interval.tv_nsec)) {
-        timing->last_drop = now;
-        return 1;
-    }
-
-    return 0;
-}
-
-/**
- * @brief Initialize timing state
- *
- * Sets up the initial timing values for the game loop.
- *
- * @param timing Pointer to timing state to initialize
+ * @brief Output tap that queues the terminal output for the recorder
  */
-static void timing_init(TimingState *timing) {
-    clock_gettime(CLOCK_MONOTONIC, &timing->last_drop);
-    clock_gettime(CLOCK_MONOTONIC, &timing->last_input);
+static void record_output(const char *data, size_t length, void *ctx) {
+    recorder_write(ctx, data, length);
 }
 
 /**
@@ -153,61 +112,96 @@ static void timing_init(TimingState *timing) {
  * @return 0 on successful exit
  */
 int main(void) {
-    /* Seed random number generator */
-    srand((unsigned int)time(NULL));
+    /* Optional asciicast recording, e.g. TETRIS_RECORD=game.cast */
+    Recorder *recorder = NULL;
+    const char *record_path = getenv("TETRIS_RECORD");
+    if (record_path != NULL) {
+        struct winsize size = { .ws_row = 24, .ws_col = 80 };
+        ioctl(STDOUT_FILENO, TIOCGWINSZ, &size);
+        recorder = recorder_open(record_path, size.ws_col, size.ws_row);
+        if (recorder != NULL) {
+            renderer_set_output_tap(record_output, recorder);
+        }
+    }
+
+    /* Optional Prometheus endpoint, e.g. TETRIS_METRICS=9464 */
+    const char *metrics_address = getenv("TETRIS_METRICS");
+    if (metrics_address != NULL) {
+        renderer_set_output_counting(1);
+    }
 
     /* Initialize subsystems */
     renderer_init();
     input_init();
 
-    /* Initialize game state */
+    /* Initialize game state (also spawns the first pieces) */
     GameState game;
     game_init(&game);
 
-    /* Set up initial pieces */
-    game_spawn_piece(&game, rand() % TETRO_COUNT);
-    game_set_next_type(&game, rand() % TETRO_COUNT);
+    /* Sample input on a dedicated thread; fall back to polling */
+    static InputQueue input_queue;
+    input_queue_init(&input_queue);
+    int threaded_input = input_thread_start(&input_queue);
 
-    /* Initialize timing */
-    TimingState timing;
-    timing_init(&timing);
+    static Metrics metrics;
+    metrics_init(&metrics);
+    MetricsServer *metrics_server = NULL;
+    if (metrics_address != NULL) {
+        metrics_server = metrics_server_start(&metrics, metrics_address);
+    }
+    unsigned long frame = 0;
 
     /* Main game loop */
     while (game.is_running) {
+        uint64_t frame_start = input_queue_now_ns();
+
         /* Process input (non-blocking) */
-        InputAction action = input_get_action();
-        process_input(&game, action);
-
-        /* Handle game logic when not paused */
-        if (!game.is_paused) {
-            /* Time-based automatic drop */
-            if (time_to_drop(&game, &timing)) {
-                /* Try to move piece down */
-                if (!game_move_current(&game, 0, 1)) {
-                    /* Cannot move down - lock the piece */
-                    game_lock_piece(&game);
-
-                    /* Check for game over */
-                    if (game_check_game_over(&game)) {
-                        game.is_running = 0;
-                    } else {
-                        /* Spawn next piece */
-                        game_spawn_piece(&game, game_get_next_type(&game));
-                        game_set_next_type(&game, rand() % TETRO_COUNT);
-                        /* Reset drop timer for new piece */
-                        clock_gettime(CLOCK_MONOTONIC, &timing.last_drop);
-                    }
-                }
+        if (threaded_input) {
+            /* Everything the input thread queued since the last frame */
+            TimedInput input;
+            while (input_queue_pop(&input_queue, &input)) {
+                process_input(&game, input.action);
+            }
+        } else {
+            process_input(&game, input_get_action());
+        }
+
+        /* Gravity and lock delay on the monotonic clock (pause-aware) */
+        game_advance(&game, input_queue_now_ns());
+
+        /* React to what the engine did this frame */
+        GameEvent event;
+        uint64_t now = input_queue_now_ns();
+        while (game_poll_event(&game, &event)) {
+            renderer_animate_event(&event, now);
+            if (event.type == GAME_EVENT_PIECE_LOCKED) {
+                metrics_add_pieces(&metrics, 1, 0);
+            } else if (event.type == GAME_EVENT_LINES_CLEARED) {
+                metrics_add_pieces(&metrics, 0, (unsigned long)event.clear.lines);
             }
         }
 
-        /* Render game state */
+        /* Render game state; animations run on the frame clock, never block */
+        renderer_advance_animations(now);
         renderer_draw_game(&game);
 
+        /* Frame work (input, logic, render) is one tick; sleep is excluded */
+        if (metrics_server != NULL) {
+            metrics_observe_tick(&metrics, input_queue_now_ns() - frame_start);
+            metrics_set_games_active(&metrics, game.is_running);
+            if (frame++ % METRICS_SAMPLE_FRAMES == 0) {
+                metrics_store_renderer_bytes(&metrics, renderer_bytes_written());
+                metrics_store_inputs_dropped(&metrics, input_queue_dropped(&input_queue));
+            }
+        }
+
         /* Small delay to reduce CPU usage (10ms) */
         nanosleep(&(struct timespec){0, 10000000L}, NULL);
     }
 
+    input_thread_stop();
+    metrics_server_stop(metrics_server);
+
     /* Show game over screen */
     renderer_draw_game_over(game.score);
     getch();  /* Wait for key press */
@@ -215,6 +209,7 @@ int main(void) {
     /* Cleanup */
     renderer_cleanup();
     input_cleanup();
+    recorder_close(recorder);
 
     return 0;
 }
@@ -0,0 +1,446 @@
+/**
+ * @file metrics.c
+ * @brief Metrics counters and Prometheus endpoint implementation
+ */
+
+#include "metrics.h"
+
+#include <assert.h>
+#include <errno.h>
+#include <poll.h>
+#include <pthread.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <sys/un.h>
+
+/**
+ * @brief Size of the buffer a request is read into
+ */
+#define REQUEST_BUFFER_SIZE 1024
+
+/**
+ * @brief Initial size of the response body buffer
+ */
+#define RESPONSE_BUFFER_SIZE 4096
+
+/**
+ * @brief Time a client gets to send its request, in milliseconds
+ */
+#define REQUEST_TIMEOUT_MS 200
+
+const uint64_t METRICS_TICK_BOUNDS_US[METRICS_TICK_BUCKETS] = {
+    50, 100, 250, 500, 1000, 2500, 5000, 10000, 16667, 25000, 50000, 100000
+};
+
+struct MetricsServer {
+    const Metrics *metrics;     /**< Metrics to serve */
+    int listen_fd;              /**< Listening socket */
+    int wake_pipe[2];           /**< Written to by stop to end the thread */
+    pthread_t thread;           /**< Server thread */
+    int port;                   /**< TCP port, 0 for a Unix socket */
+    char path[sizeof(((struct sockaddr_un *)0)->sun_path)]; /**< Unix socket path */
+};
+
+/**
+ * @brief snprintf-style appender that keeps counting past the end
+ */
+typedef struct {
+    char *buffer;       /**< Output buffer */
+    size_t size;        /**< Size of buffer */
+    size_t length;      /**< Length of the full text so far */
+} TextWriter;
+
+static void append(TextWriter *writer, const char *format, ...)
+{
+    va_list args;
+    size_t room = writer->length < writer->size ? writer->size - writer->length : 0;
+    char *out = room > 0 ? writer->buffer + writer->length : NULL;
+
+    va_start(args, format);
+    int n = vsnprintf(out, room, format, args);
+    va_end(args);
+
+    if (n > 0) {
+        writer->length += (size_t)n;
+    }
+}
+
+/**
+ * @brief Appends HELP, TYPE and value lines of a single-valued metric
+ */
+static void append_metric(TextWriter *writer, const char *name, const char *type,
+                          const char *help, unsigned long value)
+{
+    append(writer, "# HELP %s %s\n# TYPE %s %s\n%s %lu\n",
+           name, help, name, type, name, value);
+}
+
+void metrics_init(Metrics *metrics)
+{
+    assert(metrics != NULL);
+
+    atomic_init(&metrics->games_active, 0);
+    atomic_init(&metrics->ticks, 0);
+    for (int i = 0; i <= METRICS_TICK_BUCKETS; i++) {
+        atomic_init(&metrics->tick_buckets[i], 0);
+    }
+    atomic_init(&metrics->tick_ns_sum, 0);
+    atomic_init(&metrics->pieces, 0);
+    atomic_init(&metrics->lines, 0);
+    atomic_init(&metrics->renderer_bytes, 0);
+    atomic_init(&metrics->inputs_dropped, 0);
+}
+
+void metrics_set_games_active(Metrics *metrics, long games)
+{
+    assert(metrics != NULL);
+    atomic_store_explicit(&metrics->games_active, games, memory_order_relaxed);
+}
+
+void metrics_observe_tick(Metrics *metrics, uint64_t duration_ns)
+{
+    assert(metrics != NULL);
+
+    int bucket = 0;
+    while (bucket < METRICS_TICK_BUCKETS &&
+           duration_ns > METRICS_TICK_BOUNDS_US[bucket] * 1000ULL) {
+        bucket++;
+    }
+
+    atomic_fetch_add_explicit(&metrics->tick_buckets[bucket], 1, memory_order_relaxed);
+    atomic_fetch_add_explicit(&metrics->tick_ns_sum, (unsigned long)duration_ns,
+                              memory_order_relaxed);
+    atomic_fetch_add_explicit(&metrics->ticks, 1, memory_order_relaxed);
+}
+
+void metrics_add_pieces(Metrics *metrics, unsigned long pieces, unsigned long lines)
+{
+    assert(metrics != NULL);
+
+    if (pieces > 0) {
+        atomic_fetch_add_explicit(&metrics->pieces, pieces, memory_order_relaxed);
+    }
+    if (lines > 0) {
+        atomic_fetch_add_explicit(&metrics->lines, lines, memory_order_relaxed);
+    }
+}
+
+void metrics_store_renderer_bytes(Metrics *metrics, unsigned long total)
+{
+    assert(metrics != NULL);
+    atomic_store_explicit(&metrics->renderer_bytes, total, memory_order_relaxed);
+}
+
+void metrics_store_inputs_dropped(Metrics *metrics, unsigned long total)
+{
+    assert(metrics != NULL);
+    atomic_store_explicit(&metrics->inputs_dropped, total, memory_order_relaxed);
+}
+
+size_t metrics_format(const Metrics *metrics, char *buffer, size_t size)
+{
+    assert(metrics != NULL);
+
+    TextWriter writer = { buffer, size, 0 };
+    if (size > 0) {
+        buffer[0] = '\0';
+    }
+
+    append(&writer, "# HELP tetris_games_active Games currently running.\n"
+                    "# TYPE tetris_games_active gauge\n"
+                    "tetris_games_active %ld\n",
+           atomic_load_explicit(&metrics->games_active, memory_order_relaxed));
+    append_metric(&writer, "tetris_ticks_total", "counter", "Ticks processed.",
+                  atomic_load_explicit(&metrics->ticks, memory_order_relaxed));
+
+    /* Buckets are stored per range and exported cumulatively */
+    append(&writer, "# HELP tetris_tick_duration_seconds Time spent processing one tick.\n"
+                    "# TYPE tetris_tick_duration_seconds histogram\n");
+    unsigned long cumulative = 0;
+    for (int i = 0; i <= METRICS_TICK_BUCKETS; i++) {
+        cumulative += atomic_load_explicit(&metrics->tick_buckets[i], memory_order_relaxed);
+        if (i < METRICS_TICK_BUCKETS) {
+            append(&writer, "tetris_tick_duration_seconds_bucket{le=\"%g\"} %lu\n",
+                   (double)METRICS_TICK_BOUNDS_US[i] / 1e6, cumulative);
+        } else {
+            append(&writer, "tetris_tick_duration_seconds_bucket{le=\"+Inf\"} %lu\n",
+                   cumulative);
+        }
+    }
+    append(&writer, "tetris_tick_duration_seconds_sum %.9f\n"
+                    "tetris_tick_duration_seconds_count %lu\n",
+           (double)atomic_load_explicit(&metrics->tick_ns_sum, memory_order_relaxed) / 1e9,
+           cumulative);
+
+    append_metric(&writer, "tetris_pieces_total", "counter", "Pieces locked.",
+                  atomic_load_explicit(&metrics->pieces, memory_order_relaxed));
+    append_metric(&writer, "tetris_lines_total", "counter", "Lines cleared.",
+                  atomic_load_explicit(&metrics->lines, memory_order_relaxed));
+    append_metric(&writer, "tetris_renderer_bytes_total", "counter",
+                  "Bytes written to the terminal.",
+                  atomic_load_explicit(&metrics->renderer_bytes, memory_order_relaxed));
+    append_metric(&writer, "tetris_inputs_dropped_total", "counter",
+                  "Input events lost to a full queue.",
+                  atomic_load_explicit(&metrics->inputs_dropped, memory_order_relaxed));
+
+    return writer.length;
+}
+
+/**
+ * @brief Writes a whole buffer to a socket
+ * @param fd Socket
+ * @param data Bytes to send
+ * @param length Number of bytes
+ */
+static void send_all(int fd, const char *data, size_t length)
+{
+    while (length > 0) {
+        ssize_t n = send(fd, data, length, MSG_NOSIGNAL);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            return;
+        }
+        data += n;
+        length -= (size_t)n;
+    }
+}
+
+/**
+ * @brief Reads one request from a client and sends the response
+ * @param server Pointer to server
+ * @param fd Client socket
+ */
+static void handle_client(const MetricsServer *server, int fd)
+{
+    char request[REQUEST_BUFFER_SIZE];
+    size_t length = 0;
+    struct timeval timeout = { 0, REQUEST_TIMEOUT_MS * 1000 };
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+    /* Only the request line matters; stop at the end of the headers */
+    while (length < sizeof(request) - 1) {
+        ssize_t n = recv(fd, request + length, sizeof(request) - 1 - length, 0);
+        if (n <= 0) {
+            break;
+        }
+        length += (size_t)n;
+        request[length] = '\0';
+        if (strstr(request, "\r\n\r\n") != NULL) {
+            break;
+        }
+    }
+    request[length] = '\0';
+
+    char path[64] = "";
+    if (sscanf(request, "GET %63s", path) != 1 ||
+        (strcmp(path, "/metrics") != 0 && strcmp(path, "/") != 0)) {
+        static const char not_found[] =
+            "HTTP/1.0 404 Not Found\r\nContent-Type: text/plain\r\n"
+            "Content-Length: 10\r\nConnection: close\r\n\r\nnot found\n";
+        send_all(fd, not_found, sizeof(not_found) - 1);
+        return;
+    }
+
+    char stack_body[RESPONSE_BUFFER_SIZE];
+    char *body = stack_body;
+    size_t body_length = metrics_format(server->metrics, body, sizeof(stack_body));
+    if (body_length >= sizeof(stack_body)) {
+        body = malloc(body_length + 1);
+        if (body == NULL) {
+            return;
+        }
+        metrics_format(server->metrics, body, body_length + 1);
+    }
+
+    char header[160];
+    int header_length = snprintf(header, sizeof(header),
+        "HTTP/1.0 200 OK\r\nContent-Type: text/plain; version=0.0.4\r\n"
+        "Content-Length: %zu\r\nConnection: close\r\n\r\n", body_length);
+    send_all(fd, header, (size_t)header_length);
+    send_all(fd, body, body_length);
+
+    if (body != stack_body) {
+        free(body);
+    }
+}
+
+/**
+ * @brief Server thread: accepts clients until woken by stop
+ * @param arg Pointer to server
+ * @return NULL
+ */
+static void *server_main(void *arg)
+{
+    MetricsServer *server = arg;
+    struct pollfd fds[2] = {
+        { server->listen_fd, POLLIN, 0 },
+        { server->wake_pipe[0], POLLIN, 0 }
+    };
+
+    for (;;) {
+        if (poll(fds, 2, -1) < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            break;
+        }
+        if (fds[1].revents != 0) {
+            break;
+        }
+        if (fds[0].revents & POLLIN) {
+            int client = accept(server->listen_fd, NULL, NULL);
+            if (client >= 0) {
+                handle_client(server, client);
+                close(client);
+            }
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Opens the listening socket for an address string
+ * @param server Server to fill in (port, path)
+ * @param address "PORT" or "unix:PATH"
+ * @return Socket, or -1 on error
+ */
+static int open_listener(MetricsServer *server, const char *address)
+{
+    int fd;
+
+    if (strncmp(address, "unix:", 5) == 0) {
+        struct sockaddr_un addr;
+        const char *path = address + 5;
+        if (path[0] == '\0' || strlen(path) >= sizeof(addr.sun_path)) {
+            return -1;
+        }
+
+        memset(&addr, 0, sizeof(addr));
+        addr.sun_family = AF_UNIX;
+        strcpy(addr.sun_path, path);
+
+        fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (fd < 0) {
+            return -1;
+        }
+        unlink(path);   /* Stale socket from a previous run */
+        if (bind(fd, (struct sockaddr *)&addr, sizeof(addr)) < 0) {
+            close(fd);
+            return -1;
+        }
+        strcpy(server->path, path);
+    } else {
+        char *end;
+        long port = strtol(address, &end, 10);
+        if (end == address || *end != '\0' || port < 0 || port > 65535) {
+            return -1;
+        }
+
+        struct sockaddr_in addr;
+        memset(&addr, 0, sizeof(addr));
+        addr.sin_family = AF_INET;
+        addr.sin_port = htons((uint16_t)port);
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+        fd = socket(AF_INET, SOCK_STREAM, 0);
+        if (fd < 0) {
+            return -1;
+        }
+        int reuse = 1;
+        setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+        if (bind(fd, (struct sockaddr *)&addr, sizeof(addr)) < 0) {
+            close(fd);
+            return -1;
+        }
+
+        socklen_t length = sizeof(addr);
+        getsockname(fd, (struct sockaddr *)&addr, &length);
+        server->port = ntohs(addr.sin_port);
+    }
+
+    if (listen(fd, 16) < 0) {
+        close(fd);
+        if (server->path[0] != '\0') {
+            unlink(server->path);
+        }
+        return -1;
+    }
+    return fd;
+}
+
+/**
+ * @brief Closes the listening socket and removes a unix socket file
+ * @param server Server whose listener to close
+ */
+static void close_listener(MetricsServer *server)
+{
+    close(server->listen_fd);
+    if (server->path[0] != '\0') {
+        unlink(server->path);
+    }
+}
+
+MetricsServer *metrics_server_start(const Metrics *metrics, const char *address)
+{
+    assert(metrics != NULL);
+    assert(address != NULL);
+
+    MetricsServer *server = calloc(1, sizeof(MetricsServer));
+    if (server == NULL) {
+        return NULL;
+    }
+    server->metrics = metrics;
+
+    server->listen_fd = open_listener(server, address);
+    if (server->listen_fd < 0) {
+        free(server);
+        return NULL;
+    }
+    if (pipe(server->wake_pipe) < 0) {
+        close_listener(server);
+        free(server);
+        return NULL;
+    }
+    if (pthread_create(&server->thread, NULL, server_main, server) != 0) {
+        close(server->wake_pipe[0]);
+        close(server->wake_pipe[1]);
+        close_listener(server);
+        free(server);
+        return NULL;
+    }
+    return server;
+}
+
+int metrics_server_port(const MetricsServer *server)
+{
+    assert(server != NULL);
+    return server->port;
+}
+
+void metrics_server_stop(MetricsServer *server)
+{
+    if (server == NULL) {
+        return;
+    }
+
+    /* Wake the poll() in the server thread */
+    ssize_t written;
+    do {
+        written = write(server->wake_pipe[1], "x", 1);
+    } while (written < 0 && errno == EINTR);
+    pthread_join(server->thread, NULL);
+
+    close(server->wake_pipe[0]);
+    close(server->wake_pipe[1]);
+    close_listener(server);
+    free(server);
+}
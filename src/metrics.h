@@ -0,0 +1,149 @@
+/**
+ * @file metrics.h
+ * @brief Live counters exported in Prometheus text format
+ *
+ * The game loop and the session host update a Metrics block with
+ * relaxed atomic operations only, so recording a value never takes a
+ * lock or waits for a reader. A background server thread formats a
+ * snapshot on each scrape and serves it over HTTP on a local TCP port
+ * or a Unix socket.
+ *
+ * Rates such as ticks/s or pieces/s are not computed here: counters
+ * are exported as monotonic totals and Prometheus derives rates with
+ * rate() over the scrape interval.
+ *
+ * @author Tetris CLI Project
+ * @version 1.0
+ */
+
+#ifndef METRICS_H
+#define METRICS_H
+
+#include <stdatomic.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief Number of finite tick latency buckets (plus one for +Inf)
+ */
+#define METRICS_TICK_BUCKETS 12
+
+/**
+ * @brief Upper bounds of the tick latency buckets in microseconds
+ */
+extern const uint64_t METRICS_TICK_BOUNDS_US[METRICS_TICK_BUCKETS];
+
+/**
+ * @brief Counters and gauges shared between the game loop and the server
+ *
+ * All fields are written with relaxed atomics; a scrape may see
+ * counters from slightly different instants, which Prometheus tolerates.
+ */
+typedef struct {
+    atomic_long games_active;                       /**< Gauge: running games */
+    atomic_ulong ticks;                             /**< Ticks processed */
+    atomic_ulong tick_buckets[METRICS_TICK_BUCKETS + 1]; /**< Tick latency histogram (non-cumulative) */
+    atomic_ulong tick_ns_sum;                       /**< Sum of tick durations */
+    atomic_ulong pieces;                            /**< Pieces locked */
+    atomic_ulong lines;                             /**< Lines cleared */
+    atomic_ulong renderer_bytes;                    /**< Bytes written to the terminal */
+    atomic_ulong inputs_dropped;                    /**< Input events lost to a full queue */
+} Metrics;
+
+/**
+ * @brief Opaque server handle
+ */
+typedef struct MetricsServer MetricsServer;
+
+/**
+ * @brief Zeroes all counters
+ *
+ * @param metrics Pointer to metrics
+ */
+void metrics_init(Metrics *metrics);
+
+/**
+ * @brief Sets the number of running games
+ *
+ * @param metrics Pointer to metrics
+ * @param games Running games
+ */
+void metrics_set_games_active(Metrics *metrics, long games);
+
+/**
+ * @brief Records one tick and its duration
+ *
+ * @param metrics Pointer to metrics
+ * @param duration_ns Tick duration in nanoseconds
+ */
+void metrics_observe_tick(Metrics *metrics, uint64_t duration_ns);
+
+/**
+ * @brief Adds locked pieces and cleared lines
+ *
+ * @param metrics Pointer to metrics
+ * @param pieces Pieces locked since the last call
+ * @param lines Lines cleared since the last call
+ */
+void metrics_add_pieces(Metrics *metrics, unsigned long pieces, unsigned long lines);
+
+/**
+ * @brief Publishes the renderer's running byte total
+ *
+ * @param metrics Pointer to metrics
+ * @param total Bytes written since start
+ */
+void metrics_store_renderer_bytes(Metrics *metrics, unsigned long total);
+
+/**
+ * @brief Publishes the input queue's running drop total
+ *
+ * @param metrics Pointer to metrics
+ * @param total Events dropped since start
+ */
+void metrics_store_inputs_dropped(Metrics *metrics, unsigned long total);
+
+/**
+ * @brief Formats a snapshot in Prometheus text exposition format 0.0.4
+ *
+ * Behaves like snprintf(): output is truncated to @p size bytes and
+ * always NUL-terminated when @p size > 0.
+ *
+ * @param metrics Pointer to metrics
+ * @param buffer Output buffer
+ * @param size Size of @p buffer
+ * @return Length of the full text (excluding the NUL)
+ */
+size_t metrics_format(const Metrics *metrics, char *buffer, size_t size);
+
+/**
+ * @brief Starts the HTTP endpoint on a background thread
+ *
+ * @p address is either a TCP port on 127.0.0.1 ("9464", "0" picks a
+ * free port) or "unix:" followed by a socket path. Every request is
+ * answered with the current snapshot on "/metrics" (and "/"), or 404.
+ *
+ * @param metrics Metrics to serve (must outlive the server)
+ * @param address Listen address
+ * @return Server handle, or NULL if the socket or thread could not be set up
+ */
+MetricsServer *metrics_server_start(const Metrics *metrics, const char *address);
+
+/**
+ * @brief Gets the TCP port the server listens on
+ *
+ * @param server Pointer to server
+ * @return Port number, or 0 for a Unix socket
+ */
+int metrics_server_port(const MetricsServer *server);
+
+/**
+ * @brief Stops the server thread and closes the socket
+ *
+ * A Unix socket file is removed.
+ *
+ * @param server Server to stop (NULL is ignored)
+ */
+void metrics_server_stop(MetricsServer *server);
+
+#endif /* METRICS_H */
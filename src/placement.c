@@ -0,0 +1,309 @@
+/**
+ * @file placement.c
+ * @brief Placement search and skyline cache
+ */
+
+#include "placement.h"
+#include "canon.h"
+
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @brief Search positions: x and y from -BOARD_PAD, every rotation
+ */
+#define SPAN_X (BOARD_WIDTH + BOARD_PAD)
+#define SPAN_Y (BOARD_HEIGHT + BOARD_PAD)
+#define STATES (ROTATION_COUNT * SPAN_X * SPAN_Y)
+
+/**
+ * @brief Bits per column height in a skyline key
+ */
+#define HEIGHT_BITS 5
+
+/**
+ * @brief Highest stack that leaves the spawn rows free
+ *
+ * Below it a piece can rotate and shift freely before it drops, so
+ * raising the whole stack only moves every placement up by as much.
+ */
+#define LOW_STACK (BOARD_HEIGHT - TETRO_MATRIX_SIZE)
+
+/**
+ * @brief Key bit marking heights taken relative to the lowest column
+ */
+#define RELATIVE_KEY (1ULL << 63)
+
+/**
+ * @brief Key of a slot that holds nothing (no skyline packs to it)
+ */
+#define EMPTY_KEY UINT64_MAX
+
+_Static_assert(BOARD_HEIGHT < (1 << HEIGHT_BITS), "Heights must fit the key");
+_Static_assert(BOARD_WIDTH * HEIGHT_BITS + 3 < 63, "Skyline must fit the key");
+
+typedef struct {
+    uint64_t key;
+    unsigned char count;
+    Placement items[PLACEMENT_OPEN_MAX];
+} CacheSlot;
+
+struct PlacementCache {
+    size_t mask;                /**< Slot count - 1 */
+    PlacementCacheStats stats;
+    CacheSlot slots[];
+};
+
+static int state_index(const Tetromino *t)
+{
+    return (t->rotation * SPAN_X + t->x + BOARD_PAD) * SPAN_Y + t->y + BOARD_PAD;
+}
+
+/**
+ * @brief Identifies the cells a piece covers, independent of rotation
+ * 
+ * The board row and column of the shape's top left filled row and
+ * column, then the filled rows shifted to start there; rotations with
+ * equal cells give equal keys.
+ */
+static uint32_t cells_key(const Tetromino *t)
+{
+    const unsigned char *masks = tetromino_get_row_masks(t->type, t->rotation);
+    unsigned int all = masks[0] | masks[1] | masks[2] | masks[3];
+    int left = __builtin_ctz(all);
+    int first = 0;
+    while (masks[first] == 0) {
+        first++;
+    }
+    
+    uint32_t key = (uint32_t)(t->y + first + BOARD_PAD) << 24
+                 | (uint32_t)(t->x + left + BOARD_PAD) << 16;
+    for (int row = first; row < TETRO_MATRIX_SIZE; row++) {
+        key |= (uint32_t)(masks[row] >> left) << (4 * (row - first));
+    }
+    return key;
+}
+
+static int compare_placements(const void *a, const void *b)
+{
+    const Placement *p = a;
+    const Placement *q = b;
+    if (p->rotation != q->rotation) {
+        return p->rotation - q->rotation;
+    }
+    if (p->x != q->x) {
+        return p->x - q->x;
+    }
+    return p->y - q->y;
+}
+
+int placement_enumerate(const GameState *game, TetrominoType type, PlacementList *out)
+{
+    assert(game != NULL && out != NULL);
+    assert(tetromino_type_is_valid(type));
+    
+    static const int moves[5][3] = {
+        { -1, 0, 0 }, { 1, 0, 0 }, { 0, 1, 0 }, { 0, 0, 1 }, { 0, 0, -1 }
+    };
+    Tetromino queue[STATES];
+    unsigned char seen[STATES];
+    uint32_t keys[PLACEMENT_MAX];
+    size_t head = 0, tail = 0;
+    
+    out->count = 0;
+    Tetromino spawn = tetromino_create(type);
+    if (!game_is_valid_position(game, &spawn)) {
+        return 0;
+    }
+    memset(seen, 0, sizeof(seen));
+    seen[state_index(&spawn)] = 1;
+    queue[tail++] = spawn;
+    
+    while (head < tail) {
+        Tetromino t = queue[head++];
+        
+        Tetromino below = t;
+        below.y++;
+        if (!game_is_valid_position(game, &below)) {
+            uint32_t key = cells_key(&t);
+            int known = 0;
+            for (int i = 0; i < out->count && !known; i++) {
+                known = keys[i] == key;
+            }
+            if (!known) {
+                keys[out->count] = key;
+                out->items[out->count++] = (Placement){
+                    (signed char)t.x, (signed char)t.y, (signed char)t.rotation
+                };
+            }
+        }
+        
+        for (int m = 0; m < 5; m++) {
+            Tetromino next = t;
+            next.x += moves[m][0];
+            next.y += moves[m][1];
+            next.rotation = (next.rotation + moves[m][2] + ROTATION_COUNT) % ROTATION_COUNT;
+            /* Valid positions always lie in the searched range */
+            if (!game_is_valid_position(game, &next)) {
+                continue;
+            }
+            int index = state_index(&next);
+            if (!seen[index]) {
+                seen[index] = 1;
+                queue[tail++] = next;
+            }
+        }
+    }
+    
+    qsort(out->items, (size_t)out->count, sizeof(Placement), compare_placements);
+    return out->count;
+}
+
+/**
+ * @brief Lowest and highest column
+ */
+static void height_range(const Board *board, int *low, int *high)
+{
+    *low = BOARD_HEIGHT;
+    *high = 0;
+    for (int x = 0; x < BOARD_WIDTH; x++) {
+        int height = board->features.heights[x];
+        *low = height < *low ? height : *low;
+        *high = height > *high ? height : *high;
+    }
+}
+
+uint64_t placement_skyline_key(const Board *board, TetrominoType type)
+{
+    assert(board != NULL);
+    
+    int low, high;
+    height_range(board, &low, &high);
+    int base = high <= LOW_STACK ? low : 0;
+    
+    uint64_t key = (uint64_t)type;
+    for (int x = 0; x < BOARD_WIDTH; x++) {
+        key = (key << HEIGHT_BITS) | (uint64_t)(board->features.heights[x] - base);
+    }
+    return high <= LOW_STACK ? key | RELATIVE_KEY : key;
+}
+
+/**
+ * @brief Key of the mirrored skyline with the mirrored piece type
+ */
+static uint64_t mirror_key(uint64_t key)
+{
+    uint64_t mirrored = key & RELATIVE_KEY;
+    uint64_t type = (key >> (BOARD_WIDTH * HEIGHT_BITS)) & 7u;
+    
+    mirrored |= (uint64_t)canon_mirror_type((TetrominoType)type) << (BOARD_WIDTH * HEIGHT_BITS);
+    for (int x = 0; x < BOARD_WIDTH; x++) {
+        uint64_t height = (key >> (x * HEIGHT_BITS)) & ((1u << HEIGHT_BITS) - 1);
+        mirrored |= height << ((BOARD_WIDTH - 1 - x) * HEIGHT_BITS);
+    }
+    return mirrored;
+}
+
+/**
+ * @brief Mirrors placements of @p type in place and restores the order
+ */
+static void mirror_placements(Placement *items, int count, TetrominoType type)
+{
+    for (int i = 0; i < count; i++) {
+        Tetromino t = { type, items[i].x, items[i].y, items[i].rotation };
+        Tetromino m = canon_mirror_piece(&t);
+        items[i] = (Placement){ (signed char)m.x, (signed char)m.y, (signed char)m.rotation };
+    }
+    qsort(items, (size_t)count, sizeof(Placement), compare_placements);
+}
+
+PlacementCache *placement_cache_create(size_t slots)
+{
+    size_t count = 1;
+    while (count < (slots != 0 ? slots : PLACEMENT_CACHE_SLOTS)) {
+        count <<= 1;
+    }
+    
+    PlacementCache *cache = malloc(sizeof(*cache) + count * sizeof(CacheSlot));
+    if (cache == NULL) {
+        return NULL;
+    }
+    cache->mask = count - 1;
+    memset(&cache->stats, 0, sizeof(cache->stats));
+    for (size_t i = 0; i < count; i++) {
+        cache->slots[i].key = EMPTY_KEY;
+    }
+    return cache;
+}
+
+void placement_cache_destroy(PlacementCache *cache)
+{
+    free(cache);
+}
+
+int placement_find(PlacementCache *cache, const GameState *game, TetrominoType type,
+                   PlacementList *out)
+{
+    assert(game != NULL && out != NULL);
+    
+    if (cache == NULL) {
+        return placement_enumerate(game, type, out);
+    }
+    if (game->board.features.holes != 0) {
+        cache->stats.fallbacks++;
+        return placement_enumerate(game, type, out);
+    }
+    
+    uint64_t key = placement_skyline_key(&game->board, type);
+    
+    /* A low stack and its mirror share one entry in canonical orientation */
+    int mirrored = 0;
+    if (key & RELATIVE_KEY) {
+        uint64_t mirror = mirror_key(key);
+        if (mirror < key) {
+            key = mirror;
+            mirrored = 1;
+        }
+    }
+    /* Fibonacci hashing spreads the low height bits over the slots */
+    CacheSlot *slot = &cache->slots[(key * 0x9E3779B97F4A7C15ULL >> 32) & cache->mask];
+    
+    /* Low stacks are stored as if the lowest column were empty */
+    int low, high;
+    height_range(&game->board, &low, &high);
+    int lift = key & RELATIVE_KEY ? low : 0;
+    
+    if (slot->key == key) {
+        cache->stats.hits++;
+        out->count = slot->count;
+        for (int i = 0; i < slot->count; i++) {
+            out->items[i] = slot->items[i];
+            out->items[i].y = (signed char)(out->items[i].y - lift);
+        }
+        if (mirrored) {
+            mirror_placements(out->items, out->count, canon_mirror_type(type));
+        }
+        return out->count;
+    }
+    
+    cache->stats.misses++;
+    placement_enumerate(game, type, out);
+    assert(out->count <= PLACEMENT_OPEN_MAX);
+    slot->key = key;
+    slot->count = (unsigned char)out->count;
+    for (int i = 0; i < out->count; i++) {
+        slot->items[i] = out->items[i];
+        slot->items[i].y = (signed char)(slot->items[i].y + lift);
+    }
+    if (mirrored) {
+        mirror_placements(slot->items, slot->count, type);
+    }
+    return out->count;
+}
+
+void placement_cache_stats(const PlacementCache *cache, PlacementCacheStats *stats)
+{
+    assert(cache != NULL && stats != NULL);
+    *stats = cache->stats;
+}
@@ -0,0 +1,158 @@
+/**
+ * @file placement.h
+ * @brief Reachable piece placements and a skyline-keyed cache
+ *
+ * placement_enumerate() finds every position where a piece can come to
+ * rest, by a breadth-first search over (x, y, rotation) from the spawn
+ * position with the moves the engine allows: shift, soft drop and
+ * rotation. Placements covering the same cells are reported once,
+ * sorted by rotation, column and row.
+ *
+ * On a board without overhangs (Board::features reports no holes) the
+ * board is fully described by its column heights, so the placements
+ * only depend on the heights and the piece type. PlacementCache keys on
+ * exactly that, packed into 64 bits, and answers repeated skylines
+ * without running the search. While the stack leaves the spawn rows
+ * free, heights are taken relative to the lowest column, so a skyline
+ * raised by garbage or lowered by a clear hits the same entry, and a
+ * skyline and its mirror image share one entry in canonical
+ * orientation (see canon.h). Boards with overhangs always take the
+ * full search.
+ *
+ * A cache must only be used by one thread at a time; give every worker
+ * its own.
+ *
+ * @author Tetris CLI Project
+ * @version 1.0
+ */
+
+#ifndef PLACEMENT_H
+#define PLACEMENT_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "game.h"
+
+/**
+ * @brief Upper bound of placements for one piece on any board
+ *
+ * One per position the search can visit.
+ */
+#define PLACEMENT_MAX (ROTATION_COUNT * (BOARD_WIDTH + BOARD_PAD) * (BOARD_HEIGHT + BOARD_PAD))
+
+/**
+ * @brief Upper bound of placements on a board without overhangs
+ *
+ * Every rotation and column lands at exactly one height.
+ */
+#define PLACEMENT_OPEN_MAX (ROTATION_COUNT * BOARD_WIDTH)
+
+/**
+ * @brief Default number of cache slots (power of two)
+ */
+#define PLACEMENT_CACHE_SLOTS 4096
+
+/**
+ * @brief Resting position of a piece
+ */
+typedef struct {
+    signed char x;              /**< Tetromino::x */
+    signed char y;              /**< Tetromino::y */
+    signed char rotation;       /**< Tetromino::rotation */
+} Placement;
+
+/**
+ * @brief Placements of one piece, sorted by rotation, x and y
+ */
+typedef struct {
+    int count;                          /**< Number of placements */
+    Placement items[PLACEMENT_MAX];     /**< The placements */
+} PlacementList;
+
+/**
+ * @brief Cache counters, cumulative since placement_cache_create()
+ */
+typedef struct {
+    unsigned long hits;         /**< Open boards answered from the cache */
+    unsigned long misses;       /**< Open boards searched and stored */
+    unsigned long fallbacks;    /**< Boards with overhangs, searched without the cache */
+} PlacementCacheStats;
+
+/**
+ * @brief Opaque cache handle
+ */
+typedef struct PlacementCache PlacementCache;
+
+/**
+ * @brief Finds all reachable resting positions of a piece
+ *
+ * Searches from the spawn position of @p type on the board of
+ * @p game; the game's current piece is ignored.
+ *
+ * @param game Game whose board is searched
+ * @param type Piece type
+ * @param out Output placements
+ * @return Number of placements (0 if the piece cannot spawn)
+ */
+int placement_enumerate(const GameState *game, TetrominoType type, PlacementList *out);
+
+/**
+ * @brief Packs the column heights and the piece type into a cache key
+ *
+ * Five bits per column height and three for the type. When no column
+ * reaches the spawn rows, the heights are stored above the lowest
+ * column and the top bit is set. Only meaningful for boards without
+ * overhangs.
+ *
+ * @param board Pointer to Board
+ * @param type Piece type
+ * @return Skyline key
+ */
+uint64_t placement_skyline_key(const Board *board, TetrominoType type);
+
+/**
+ * @brief Creates a direct-mapped cache
+ *
+ * A new skyline overwrites whatever occupied its slot.
+ *
+ * @param slots Number of slots, rounded up to a power of two
+ *              (0 = PLACEMENT_CACHE_SLOTS)
+ * @return New cache, or NULL if allocation failed
+ */
+PlacementCache *placement_cache_create(size_t slots);
+
+/**
+ * @brief Frees the cache
+ *
+ * @param cache Cache to destroy (NULL is ignored)
+ */
+void placement_cache_destroy(PlacementCache *cache);
+
+/**
+ * @brief Gets the placements of a piece, from the cache when possible
+ *
+ * Open boards are looked up by placement_skyline_key() and searched
+ * only on a miss; boards with overhangs fall back to
+ * placement_enumerate(). The result is the same either way.
+ *
+ * To branch over hold, call it again for game_get_hold_alternative()
+ * while game_can_hold() allows the swap.
+ *
+ * @param cache Pointer to cache (NULL = always search)
+ * @param game Game whose board is searched
+ * @param type Piece type
+ * @param out Output placements
+ * @return Number of placements
+ */
+int placement_find(PlacementCache *cache, const GameState *game, TetrominoType type,
+                   PlacementList *out);
+
+/**
+ * @brief Reads the cache counters
+ *
+ * @param cache Pointer to cache
+ * @param stats Output counters
+ */
+void placement_cache_stats(const PlacementCache *cache, PlacementCacheStats *stats);
+
+#endif /* PLACEMENT_H */
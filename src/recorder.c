@@ -0,0 +1,334 @@
+/**
+ * @file recorder.c
+ * @brief asciicast v2 recorder implementation
+ */
+
+#include "recorder.h"
+
+#include <assert.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/**
+ * @brief Assumed cache line size for padding
+ */
+#define RECORDER_CACHE_LINE 64
+
+/**
+ * @brief Written in place of bytes that are not valid UTF-8
+ */
+#define REPLACEMENT_CHARACTER "\xEF\xBF\xBD"
+
+/**
+ * @brief Prefix of every chunk in the ring
+ */
+typedef struct {
+    uint64_t time_ns;           /**< Time since recorder_open() */
+    uint32_t length;            /**< Payload bytes that follow */
+} ChunkHeader;
+
+struct Recorder {
+    /* Consumer side */
+    _Alignas(RECORDER_CACHE_LINE) atomic_size_t head;  /**< Next byte to read */
+    size_t cached_tail;                                 /**< Writer's view of tail */
+
+    /* Producer side */
+    _Alignas(RECORDER_CACHE_LINE) atomic_size_t tail;  /**< Next byte to write */
+    size_t cached_head;                                 /**< Producer's view of head */
+    atomic_ulong dropped_chunks;
+    atomic_ulong dropped_bytes;
+
+    /* Writer thread */
+    _Alignas(RECORDER_CACHE_LINE) atomic_int closing;
+    atomic_ulong events;
+    atomic_ulong bytes;
+    pthread_t thread;
+    FILE *file;
+    int failed;                 /**< 1 after a failed file write */
+    uint64_t start_ns;
+    unsigned char carry[4];     /**< Incomplete UTF-8 sequence of the last chunk */
+    size_t carry_length;
+    unsigned char *chunk;       /**< Carry plus the chunk being encoded */
+
+    unsigned char ring[RECORDER_QUEUE_SIZE];
+};
+
+static uint64_t now_ns(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000ULL + (uint64_t)now.tv_nsec;
+}
+
+/**
+ * @brief Copies into the ring at a free-running index, wrapping around
+ */
+static void ring_put(Recorder *recorder, size_t index, const void *data, size_t length)
+{
+    size_t offset = index & (RECORDER_QUEUE_SIZE - 1);
+    size_t first = RECORDER_QUEUE_SIZE - offset;
+    if (first > length) {
+        first = length;
+    }
+    memcpy(recorder->ring + offset, data, first);
+    memcpy(recorder->ring, (const unsigned char *)data + first, length - first);
+}
+
+/**
+ * @brief Copies out of the ring at a free-running index, wrapping around
+ */
+static void ring_get(const Recorder *recorder, size_t index, void *data, size_t length)
+{
+    size_t offset = index & (RECORDER_QUEUE_SIZE - 1);
+    size_t first = RECORDER_QUEUE_SIZE - offset;
+    if (first > length) {
+        first = length;
+    }
+    memcpy(data, recorder->ring + offset, first);
+    memcpy((unsigned char *)data + first, recorder->ring, length - first);
+}
+
+int recorder_write(Recorder *recorder, const void *data, size_t length)
+{
+    assert(recorder != NULL);
+    assert(data != NULL || length == 0);
+
+    size_t needed = sizeof(ChunkHeader) + length;
+    size_t tail = atomic_load_explicit(&recorder->tail, memory_order_relaxed);
+
+    if (tail + needed - recorder->cached_head > RECORDER_QUEUE_SIZE) {
+        /* Looks full: refresh the view of the writer's index once */
+        recorder->cached_head = atomic_load_explicit(&recorder->head, memory_order_acquire);
+        if (tail + needed - recorder->cached_head > RECORDER_QUEUE_SIZE) {
+            atomic_fetch_add_explicit(&recorder->dropped_chunks, 1, memory_order_relaxed);
+            atomic_fetch_add_explicit(&recorder->dropped_bytes, length, memory_order_relaxed);
+            return 0;
+        }
+    }
+
+    ChunkHeader header = { now_ns() - recorder->start_ns, (uint32_t)length };
+    ring_put(recorder, tail, &header, sizeof(header));
+    ring_put(recorder, tail + sizeof(header), data, length);
+    atomic_store_explicit(&recorder->tail, tail + needed, memory_order_release);
+    return 1;
+}
+
+/**
+ * @brief Length of the longest prefix that does not end inside a UTF-8
+ *        sequence
+ *
+ * Chunks are cut wherever the terminal output was read, which may be in
+ * the middle of a multi-byte character; JSON strings must not be.
+ */
+static size_t complete_utf8(const unsigned char *data, size_t length)
+{
+    for (size_t back = 1; back <= 3 && back <= length; back++) {
+        unsigned char byte = data[length - back];
+        if ((byte & 0xC0) != 0x80) {
+            size_t need = (byte & 0xE0) == 0xC0 ? 2 : (byte & 0xF0) == 0xE0 ? 3
+                        : (byte & 0xF8) == 0xF0 ? 4 : 1;
+            return need > back ? length - back : length;
+        }
+    }
+    return length;
+}
+
+/**
+ * @brief Length of the valid UTF-8 sequence at @p data, 0 if invalid
+ */
+static size_t utf8_sequence(const unsigned char *data, size_t available)
+{
+    unsigned char lead = data[0];
+    size_t need = (lead & 0xE0) == 0xC0 ? 2 : (lead & 0xF0) == 0xE0 ? 3
+                : (lead & 0xF8) == 0xF0 ? 4 : 0;
+    if (need == 0 || need > available) {
+        return 0;
+    }
+    for (size_t i = 1; i < need; i++) {
+        if ((data[i] & 0xC0) != 0x80) {
+            return 0;
+        }
+    }
+    return need;
+}
+
+/**
+ * @brief Writes one output event line
+ *
+ * JSON strings must be valid UTF-8, so stray bytes (the narrow ncurses
+ * library prints some as meta sequences) become U+FFFD.
+ */
+static void write_event(Recorder *recorder, uint64_t time_ns,
+                        const unsigned char *data, size_t length)
+{
+    FILE *file = recorder->file;
+
+    fprintf(file, "[%llu.%06llu, \"o\", \"",
+            (unsigned long long)(time_ns / 1000000000ULL),
+            (unsigned long long)(time_ns % 1000000000ULL / 1000ULL));
+    for (size_t i = 0; i < length; i++) {
+        unsigned char byte = data[i];
+        switch (byte) {
+        case '"':  fputs("\\\"", file); break;
+        case '\\': fputs("\\\\", file); break;
+        case '\n': fputs("\\n", file); break;
+        case '\r': fputs("\\r", file); break;
+        case '\t': fputs("\\t", file); break;
+        default:
+            if (byte < 0x20 || byte == 0x7F) {
+                fprintf(file, "\\u%04x", byte);
+            } else if (byte < 0x80) {
+                putc(byte, file);
+            } else {
+                size_t valid = utf8_sequence(data + i, length - i);
+                if (valid > 0) {
+                    fwrite(data + i, 1, valid, file);
+                    i += valid - 1;
+                } else {
+                    fputs(REPLACEMENT_CHARACTER, file);
+                }
+            }
+            break;
+        }
+    }
+    fputs("\"]\n", file);
+
+    atomic_fetch_add_explicit(&recorder->events, 1, memory_order_relaxed);
+    atomic_fetch_add_explicit(&recorder->bytes, length, memory_order_relaxed);
+}
+
+/**
+ * @brief Encodes one queued chunk
+ * @return 0 if the ring was empty
+ */
+static int drain_one(Recorder *recorder)
+{
+    size_t head = atomic_load_explicit(&recorder->head, memory_order_relaxed);
+
+    if (head == recorder->cached_tail) {
+        recorder->cached_tail = atomic_load_explicit(&recorder->tail, memory_order_acquire);
+        if (head == recorder->cached_tail) {
+            return 0;
+        }
+    }
+
+    ChunkHeader header;
+    ring_get(recorder, head, &header, sizeof(header));
+    memcpy(recorder->chunk, recorder->carry, recorder->carry_length);
+    ring_get(recorder, head + sizeof(header), recorder->chunk + recorder->carry_length,
+             header.length);
+    atomic_store_explicit(&recorder->head, head + sizeof(header) + header.length,
+                          memory_order_release);
+
+    size_t total = recorder->carry_length + header.length;
+    size_t complete = complete_utf8(recorder->chunk, total);
+    recorder->carry_length = total - complete;
+    memcpy(recorder->carry, recorder->chunk + complete, recorder->carry_length);
+
+    if (complete > 0) {
+        write_event(recorder, header.time_ns, recorder->chunk, complete);
+    }
+    return 1;
+}
+
+static void *writer_main(void *arg)
+{
+    Recorder *recorder = arg;
+
+    for (;;) {
+        if (drain_one(recorder)) {
+            continue;
+        }
+        /* Read the flag before the final check so nothing queued before close is lost */
+        if (atomic_load_explicit(&recorder->closing, memory_order_acquire)) {
+            while (drain_one(recorder)) {
+            }
+            break;
+        }
+        if (fflush(recorder->file) != 0) {
+            recorder->failed = 1;
+        }
+        struct timespec pause = { 0, RECORDER_POLL_NS };
+        nanosleep(&pause, NULL);
+    }
+    return NULL;
+}
+
+Recorder *recorder_open(const char *path, int width, int height)
+{
+    assert(path != NULL);
+
+    Recorder *recorder = calloc(1, sizeof(*recorder));
+    if (recorder == NULL) {
+        return NULL;
+    }
+    recorder->chunk = malloc(RECORDER_QUEUE_SIZE + sizeof(recorder->carry));
+    recorder->file = fopen(path, "w");
+    if (recorder->chunk == NULL || recorder->file == NULL) {
+        if (recorder->file != NULL) {
+            fclose(recorder->file);
+        }
+        free(recorder->chunk);
+        free(recorder);
+        return NULL;
+    }
+
+    atomic_init(&recorder->head, 0);
+    atomic_init(&recorder->tail, 0);
+    atomic_init(&recorder->dropped_chunks, 0);
+    atomic_init(&recorder->dropped_bytes, 0);
+    atomic_init(&recorder->closing, 0);
+    atomic_init(&recorder->events, 0);
+    atomic_init(&recorder->bytes, 0);
+    recorder->start_ns = now_ns();
+
+    fprintf(recorder->file, "{\"version\": 2, \"width\": %d, \"height\": %d, \"timestamp\": %lld}\n",
+            width, height, (long long)time(NULL));
+
+    if (pthread_create(&recorder->thread, NULL, writer_main, recorder) != 0) {
+        fclose(recorder->file);
+        free(recorder->chunk);
+        free(recorder);
+        return NULL;
+    }
+    return recorder;
+}
+
+int recorder_close(Recorder *recorder)
+{
+    if (recorder == NULL) {
+        return 0;
+    }
+
+    atomic_store_explicit(&recorder->closing, 1, memory_order_release);
+    pthread_join(recorder->thread, NULL);
+
+    /* A sequence still cut off at the end is written as it is */
+    if (recorder->carry_length > 0) {
+        write_event(recorder, now_ns() - recorder->start_ns,
+                    recorder->carry, recorder->carry_length);
+    }
+
+    int failed = recorder->failed;
+    if (fclose(recorder->file) != 0) {
+        failed = 1;
+    }
+    free(recorder->chunk);
+    free(recorder);
+    return failed ? -1 : 0;
+}
+
+void recorder_stats(const Recorder *recorder, RecorderStats *stats)
+{
+    assert(recorder != NULL && stats != NULL);
+
+    stats->events = atomic_load_explicit(&recorder->events, memory_order_relaxed);
+    stats->bytes = atomic_load_explicit(&recorder->bytes, memory_order_relaxed);
+    stats->dropped_chunks = atomic_load_explicit(&recorder->dropped_chunks, memory_order_relaxed);
+    stats->dropped_bytes = atomic_load_explicit(&recorder->dropped_bytes, memory_order_relaxed);
+}
@@ -0,0 +1,91 @@
+/**
+ * @file recorder.h
+ * @brief Terminal output recorder writing asciicast v2 files
+ *
+ * Captures the bytes the renderer sends to the terminal and stores them
+ * as timestamped output events in an asciicast v2 file, which tools
+ * such as asciinema can play back. ncurses only sends what changed on
+ * screen, so every event is already a frame delta.
+ *
+ * recorder_write() only copies the bytes into a bounded lock-free ring
+ * buffer; JSON encoding and file I/O happen on a background writer
+ * thread. When the ring is full the chunk is dropped and counted, so a
+ * slow disk never stalls the frame.
+ *
+ * Exactly one thread may call recorder_write().
+ *
+ * @author Tetris CLI Project
+ * @version 1.0
+ */
+
+#ifndef RECORDER_H
+#define RECORDER_H
+
+#include <stddef.h>
+
+/**
+ * @brief Ring buffer capacity in bytes (power of two)
+ */
+#define RECORDER_QUEUE_SIZE (1u << 20)
+
+/**
+ * @brief Writer thread sleep while the ring is empty, in nanoseconds
+ */
+#define RECORDER_POLL_NS 2000000L
+
+/**
+ * @brief Recorder counters
+ */
+typedef struct {
+    unsigned long events;           /**< Output events written to the file */
+    unsigned long bytes;            /**< Terminal bytes written to the file */
+    unsigned long dropped_chunks;   /**< Chunks rejected while the ring was full */
+    unsigned long dropped_bytes;    /**< Bytes in the rejected chunks */
+} RecorderStats;
+
+/**
+ * @brief Opaque recorder handle
+ */
+typedef struct Recorder Recorder;
+
+/**
+ * @brief Creates the file, writes the header and starts the writer thread
+ *
+ * @param path Output file (truncated if it exists)
+ * @param width Terminal width in columns for the header
+ * @param height Terminal height in rows for the header
+ * @return New recorder, or NULL if the file or thread could not be created
+ */
+Recorder *recorder_open(const char *path, int width, int height);
+
+/**
+ * @brief Queues terminal output stamped with the current time
+ *
+ * Never blocks and makes no system call besides reading the clock.
+ *
+ * @param recorder Pointer to recorder
+ * @param data Bytes sent to the terminal
+ * @param length Number of bytes
+ * @return 1 if queued, 0 if dropped because the ring was full
+ */
+int recorder_write(Recorder *recorder, const void *data, size_t length);
+
+/**
+ * @brief Writes everything still queued, stops the thread and closes the file
+ *
+ * @param recorder Recorder to close (NULL is ignored)
+ * @return 0 on success, -1 if writing the file failed
+ */
+int recorder_close(Recorder *recorder);
+
+/**
+ * @brief Reads the counters
+ *
+ * May be called from any thread while recording.
+ *
+ * @param recorder Pointer to recorder
+ * @param stats Output counters
+ */
+void recorder_stats(const Recorder *recorder, RecorderStats *stats);
+
+#endif /* RECORDER_H */
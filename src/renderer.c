@@ -5,14 +5,71 @@
 
 #include "renderer.h"
 
+#include <errno.h>
 #include <ncurses.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
+#include <termios.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
 
 /**
  * @brief Internal flag to track initialization state
  */
 static int renderer_initialized = 0;
 
+/**
+ * @brief Screen of the plain (untapped) output, NULL if initscr() was used
+ */
+static SCREEN *plain_screen = NULL;
+
+/**
+ * @brief Cached layout, recomputed when the terminal size changes
+ */
+static RendererLayout layout;
+
+/**
+ * @brief Animation state, advanced by the caller's frame loop
+ */
+static RendererAnimation animation;
+
+/**
+ * @brief Color pair for wiped rows and flashing cells
+ */
+#define FLASH_COLOR_PAIR 9
+
+/**
+ * @brief Piece letters for the collapsed status line, by TetrominoType
+ */
+static const char TETRO_LETTERS[TETRO_COUNT + 1] = "IOTSZJL";
+
+/**
+ * @brief Read size of the output thread
+ */
+#define TAP_BUFFER_SIZE 65536
+
+/**
+ * @brief Output tap state (see renderer_set_output_tap())
+ */
+static RendererOutputFn tap_fn = NULL;
+static void *tap_ctx = NULL;
+static int count_output = 0;
+static int tap_active = 0;
+static int tap_read_fd = -1;
+static FILE *tap_out = NULL;
+static pthread_t tap_thread;
+static SCREEN *tap_screen = NULL;
+static struct termios tap_saved_modes;
+static int tap_modes_saved = 0;
+
+/**
+ * @brief Bytes the output thread forwarded to the terminal
+ */
+static atomic_ulong output_bytes;
+
 /**
  * @brief ncurses color pair for each tetromino type
  */
@@ -49,14 +106,139 @@ static const char CELL_CHAR[] = "██";
  */
 static const char EMPTY_CELL[] = "  ";
 
+void renderer_set_output_tap(RendererOutputFn fn, void *ctx)
+{
+    tap_fn = fn;
+    tap_ctx = ctx;
+}
+
+void renderer_set_output_counting(int enable)
+{
+    count_output = enable != 0;
+}
+
+/**
+ * @brief Output thread: forwards the pipe to the terminal and the tap
+ */
+static void *tap_main(void *arg)
+{
+    (void)arg;
+    static char buffer[TAP_BUFFER_SIZE];
+
+    for (;;) {
+        ssize_t n = read(tap_read_fd, buffer, sizeof(buffer));
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            break;
+        }
+        for (ssize_t done = 0; done < n; ) {
+            ssize_t written = write(STDOUT_FILENO, buffer + done, (size_t)(n - done));
+            if (written < 0 && errno != EINTR) {
+                break;
+            }
+            done += written > 0 ? written : 0;
+        }
+        atomic_fetch_add_explicit(&output_bytes, (unsigned long)n, memory_order_relaxed);
+        if (tap_fn != NULL) {
+            tap_fn(buffer, (size_t)n, tap_ctx);
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Starts ncurses on a pipe that the output thread drains
+ * @return 1 on success, 0 to fall back to plain initscr()
+ */
+static int tap_start(void)
+{
+    int fds[2];
+    if (pipe(fds) != 0) {
+        return 0;
+    }
+    tap_out = fdopen(fds[1], "w");
+    tap_read_fd = fds[0];
+    if (tap_out == NULL) {
+        close(fds[0]);
+        close(fds[1]);
+        return 0;
+    }
+
+    /* ncurses cannot query the size through the pipe, so pass it in the environment */
+    struct winsize size;
+    char rows[16], cols[16];
+    int size_from_env = getenv("LINES") == NULL && getenv("COLUMNS") == NULL &&
+        ioctl(STDOUT_FILENO, TIOCGWINSZ, &size) == 0 && size.ws_row > 0 && size.ws_col > 0;
+    if (size_from_env) {
+        snprintf(rows, sizeof(rows), "%d", size.ws_row);
+        snprintf(cols, sizeof(cols), "%d", size.ws_col);
+        setenv("LINES", rows, 1);
+        setenv("COLUMNS", cols, 1);
+    }
+    tap_screen = newterm(NULL, tap_out, stdin);
+    if (size_from_env) {
+        unsetenv("LINES");
+        unsetenv("COLUMNS");
+    }
+    if (tap_screen == NULL || pthread_create(&tap_thread, NULL, tap_main, NULL) != 0) {
+        if (tap_screen != NULL) {
+            delscreen(tap_screen);
+            tap_screen = NULL;
+        }
+        fclose(tap_out);
+        close(tap_read_fd);
+        return 0;
+    }
+
+    /* Nor can it set the terminal modes */
+    struct termios modes;
+    if (tcgetattr(STDIN_FILENO, &tap_saved_modes) == 0) {
+        tap_modes_saved = 1;
+        modes = tap_saved_modes;
+        modes.c_lflag &= ~(tcflag_t)(ICANON | ECHO);
+        modes.c_cc[VMIN] = 1;
+        modes.c_cc[VTIME] = 0;
+        tcsetattr(STDIN_FILENO, TCSANOW, &modes);
+    }
+    return 1;
+}
+
+/**
+ * @brief Shuts the pipe, waits for the output thread and restores modes
+ */
+static void tap_stop(void)
+{
+    delscreen(tap_screen);
+    fclose(tap_out);
+    pthread_join(tap_thread, NULL);
+    close(tap_read_fd);
+
+    if (tap_modes_saved) {
+        tcsetattr(STDIN_FILENO, TCSANOW, &tap_saved_modes);
+        tap_modes_saved = 0;
+    }
+    tap_screen = NULL;
+    tap_out = NULL;
+    tap_read_fd = -1;
+}
+
 void renderer_init(void)
 {
     if (renderer_initialized) {
         return;
     }
 
-    /* Initialize ncurses */
-    initscr();
+    /* Initialize ncurses, through the output pipe if tapped or counted */
+    tap_active = (tap_fn != NULL || count_output) && tap_start();
+    if (!tap_active) {
+        /* An own screen instead of initscr(), so every init starts fresh */
+        plain_screen = newterm(NULL, stdout, stdin);
+        if (plain_screen == NULL) {
+            initscr();
+        }
+    }
     
     /* Enable colors */
     if (has_colors()) {
@@ -70,6 +252,7 @@ void renderer_init(void)
         
         /* Default color pair for empty cells */
         init_pair(8, COLOR_WHITE, COLOR_BLACK);
+        init_pair(FLASH_COLOR_PAIR, COLOR_BLACK, COLOR_WHITE);
     }
     
     /* Don't show cursor */
@@ -85,6 +268,7 @@ void renderer_init(void)
     /* Clear screen */
     clear();
     
+    renderer_compute_layout(COLS, LINES, &layout);
     renderer_initialized = 1;
 }
 
@@ -100,9 +284,67 @@ void renderer_cleanup(void)
     /* End ncurses mode */
     endwin();
     
+    if (tap_active) {
+        tap_stop();
+        tap_active = 0;
+    } else if (plain_screen != NULL) {
+        delscreen(plain_screen);
+        plain_screen = NULL;
+    }
+    
     renderer_initialized = 0;
 }
 
+unsigned long renderer_bytes_written(void)
+{
+    return atomic_load_explicit(&output_bytes, memory_order_relaxed);
+}
+
+int renderer_is_active(void)
+{
+    return renderer_initialized;
+}
+
+void renderer_compute_layout(int cols, int rows, RendererLayout *out)
+{
+    int full_width = BOARD_WIDTH_CHARS + SIDEBAR_GAP + HOLD_BOX_OFFSET + PREVIEW_BOX_WIDTH;
+    int width, height;
+
+    memset(out, 0, sizeof(*out));
+    out->cols = cols;
+    out->rows = rows;
+    out->status_y = -1;
+
+    if (cols < BOARD_WIDTH_CHARS || rows < BOARD_HEIGHT_CHARS) {
+        return;
+    }
+    out->fits = 1;
+
+    if (cols >= full_width) {
+        out->sidebar = 1;
+        out->show_controls = rows >= CONTROLS_ROW + CONTROLS_HEIGHT;
+        width = full_width;
+        height = out->show_controls ? CONTROLS_ROW + CONTROLS_HEIGHT : BOARD_HEIGHT_CHARS;
+    } else {
+        /* Collapsed: score and previews in one line under the board, if there is room */
+        width = BOARD_WIDTH_CHARS;
+        height = rows > BOARD_HEIGHT_CHARS ? BOARD_HEIGHT_CHARS + 1 : BOARD_HEIGHT_CHARS;
+    }
+
+    out->board_x = (cols - width) / 2;
+    out->board_y = (rows - height) / 2;
+    if (out->sidebar) {
+        out->sidebar_x = out->board_x + BOARD_WIDTH_CHARS + SIDEBAR_GAP;
+    } else if (height > BOARD_HEIGHT_CHARS) {
+        out->status_y = out->board_y + BOARD_HEIGHT_CHARS;
+    }
+}
+
+const RendererLayout *renderer_get_layout(void)
+{
+    return &layout;
+}
+
 /**
  * @brief Draw a single cell
  */
@@ -128,14 +370,89 @@ static int get_cell_color_pair(Cell cell)
     return 8; /* Default black */
 }
 
+void renderer_animate_event(const GameEvent *event, uint64_t now_ns)
+{
+    if (event == NULL) {
+        return;
+    }
+    
+    if (event->type == GAME_EVENT_PIECE_LOCKED) {
+        animation.lock_active = 1;
+        animation.lock_start_ns = now_ns;
+        memcpy(animation.lock_x, event->lock.cell_x, sizeof(animation.lock_x));
+        memcpy(animation.lock_y, event->lock.cell_y, sizeof(animation.lock_y));
+    } else if (event->type == GAME_EVENT_LINES_CLEARED && event->clear.rows_mask != 0) {
+        /* The rows above moved down, the flash would land on other cells */
+        animation.lock_active = 0;
+        animation.clear_rows = event->clear.rows_mask;
+        animation.clear_step = 0;
+        animation.clear_start_ns = now_ns;
+    }
+}
+
+int renderer_advance_animations(uint64_t now_ns)
+{
+    if (animation.clear_rows != 0) {
+        uint64_t elapsed = now_ns - animation.clear_start_ns;
+        if (elapsed >= RENDERER_CLEAR_ANIM_NS) {
+            animation.clear_rows = 0;
+            animation.clear_step = 0;
+        } else {
+            /* Wipe from both sides towards the middle */
+            animation.clear_step = (int)(elapsed * (BOARD_WIDTH / 2 + 1) / RENDERER_CLEAR_ANIM_NS);
+        }
+    }
+    
+    if (animation.lock_active && now_ns - animation.lock_start_ns >= RENDERER_LOCK_ANIM_NS) {
+        animation.lock_active = 0;
+    }
+    
+    return animation.clear_rows != 0 || animation.lock_active;
+}
+
+const RendererAnimation *renderer_get_animation(void)
+{
+    return &animation;
+}
+
+/**
+ * @brief Paints the running animations over the board cells
+ * 
+ * Only the wiped rows and the flashing cells are touched.
+ */
+static void draw_animations(const Board *board, int start_x, int start_y)
+{
+    for (int y = 0; y < BOARD_HEIGHT && animation.clear_rows != 0; y++) {
+        if (animation.clear_rows & (1 << y)) {
+            for (int x = animation.clear_step; x < BOARD_WIDTH - animation.clear_step; x++) {
+                draw_cell(start_x + 1 + x * BOARD_CELL_WIDTH, start_y + y, FLASH_COLOR_PAIR, 0);
+            }
+        }
+    }
+    
+    if (animation.lock_active) {
+        for (int i = 0; i < 4; i++) {
+            int x = animation.lock_x[i];
+            int y = animation.lock_y[i];
+            if (x >= 0 && x < BOARD_WIDTH && y >= 0 && y < BOARD_HEIGHT && board->cells[y][x] != 0) {
+                draw_cell(start_x + 1 + x * BOARD_CELL_WIDTH, start_y + y, FLASH_COLOR_PAIR, 1);
+            }
+        }
+    }
+}
+
 void renderer_draw_board(const Board *board, const Tetromino *current)
 {
     if (!renderer_initialized || board == NULL) {
         return;
     }
     
-    int start_x = BOARD_DISPLAY_X;
-    int start_y = BOARD_DISPLAY_Y;
+    if (!layout.fits) {
+        return;
+    }
+    
+    int start_x = layout.board_x;
+    int start_y = layout.board_y + 1;
     
     /* Draw top border */
     mvprintw(start_y - 1, start_x, "┌");
@@ -160,6 +477,8 @@ void renderer_draw_board(const Board *board, const Tetromino *current)
         mvprintw(start_y + y, start_x + 1 + BOARD_WIDTH * BOARD_CELL_WIDTH, "│");
     }
     
+    draw_animations(board, start_x, start_y);
+    
     /* Draw current piece if provided */
     if (current != NULL) {
         const int (*shape)[TETRO_MATRIX_SIZE] = tetromino_get_shape(current->type, current->rotation);
@@ -192,18 +511,18 @@ void renderer_draw_board(const Board *board, const Tetromino *current)
     printw("┘");
 }
 
-void renderer_draw_next_piece(TetrominoType next_type)
+/**
+ * @brief Draw a labelled 4x4 preview box with a centered piece
+ * 
+ * An invalid type (e.g. an empty hold slot) draws just the empty box.
+ */
+static void draw_preview(int box_x, int box_y, const char *label,
+                         TetrominoType type)
 {
-    if (!renderer_initialized) {
-        return;
-    }
+    int color_pair = tetromino_get_color(type);
     
-    int box_x = SIDEBAR_X;
-    int box_y = 3;
-    int color_pair = tetromino_get_color(next_type);
-    
-    /* Draw "NEXT" label */
-    mvprintw(1, box_x + 6, "NEXT");
+    /* Draw label */
+    mvprintw(box_y - 2, box_x + 6, "%s", label);
     
     /* Draw preview box border */
     mvprintw(box_y, box_x, "┌────────┐");
@@ -213,8 +532,8 @@ void renderer_draw_next_piece(TetrominoType next_type)
     }
     mvprintw(box_y + 5, box_x, "└────────┘");
     
-    /* Get shape for next piece */
-    const int (*shape)[TETRO_MATRIX_SIZE] = tetromino_get_shape(next_type, 0);
+    /* Get shape for the piece */
+    const int (*shape)[TETRO_MATRIX_SIZE] = tetromino_get_shape(type, 0);
     if (shape == NULL || color_pair < 0) {
         return;
     }
@@ -251,14 +570,33 @@ void renderer_draw_next_piece(TetrominoType next_type)
     }
 }
 
+void renderer_draw_next_piece(TetrominoType next_type)
+{
+    if (!renderer_initialized || !layout.sidebar) {
+        return;
+    }
+    
+    draw_preview(layout.sidebar_x, layout.board_y + PREVIEW_ROW, "NEXT", next_type);
+}
+
+void renderer_draw_hold_piece(TetrominoType hold_type)
+{
+    if (!renderer_initialized || !layout.sidebar) {
+        return;
+    }
+    
+    draw_preview(layout.sidebar_x + HOLD_BOX_OFFSET, layout.board_y + PREVIEW_ROW,
+                 "HOLD", hold_type);
+}
+
 void renderer_draw_score(int score, int level, int lines)
 {
-    if (!renderer_initialized) {
+    if (!renderer_initialized || !layout.sidebar) {
         return;
     }
     
-    int start_x = SIDEBAR_X;
-    int start_y = 10;
+    int start_x = layout.sidebar_x;
+    int start_y = layout.board_y + SCORE_ROW;
     
     /* SCORE */
     mvprintw(start_y, start_x, "SCORE");
@@ -275,12 +613,12 @@ void renderer_draw_score(int score, int level, int lines)
 
 void renderer_draw_controls(void)
 {
-    if (!renderer_initialized) {
+    if (!renderer_initialized || !layout.show_controls) {
         return;
     }
     
-    int start_x = SIDEBAR_X;
-    int start_y = 19;
+    int start_x = layout.sidebar_x;
+    int start_y = layout.board_y + CONTROLS_ROW;
     
     mvprintw(start_y, start_x, "CONTROLS");
     mvprintw(start_y + 1, start_x, "←→↓  Move");
@@ -288,7 +626,24 @@ void renderer_draw_controls(void)
     mvprintw(start_y + 3, start_x, "Space Drop");
     mvprintw(start_y + 4, start_x, "Z    Rotate↺");
     mvprintw(start_y + 5, start_x, "P    Pause");
-    mvprintw(start_y + 6, start_x, "Q    Quit");
+    mvprintw(start_y + 6, start_x, "C    Hold");
+    mvprintw(start_y + 7, start_x, "Q    Quit");
+}
+
+/**
+ * @brief Draw the one-line summary that replaces a collapsed sidebar
+ */
+static void draw_status_line(const GameState *game)
+{
+    if (layout.status_y < 0) {
+        return;
+    }
+    
+    char next = tetromino_type_is_valid(game->next.type) ? TETRO_LETTERS[game->next.type] : '-';
+    char hold = tetromino_type_is_valid(game->hold) ? TETRO_LETTERS[game->hold] : '-';
+    mvprintw(layout.status_y, layout.board_x, "%-*.*s", BOARD_WIDTH_CHARS, BOARD_WIDTH_CHARS, "");
+    mvprintw(layout.status_y, layout.board_x, "%d L%d N:%c H:%c",
+             game->score, game->level, next, hold);
 }
 
 void renderer_draw_sidebar(const GameState *game)
@@ -297,7 +652,13 @@ void renderer_draw_sidebar(const GameState *game)
         return;
     }
     
+    if (!layout.sidebar) {
+        draw_status_line(game);
+        return;
+    }
+    
     renderer_draw_next_piece(game->next.type);
+    renderer_draw_hold_piece(game->hold);
     renderer_draw_score(game->score, game->level, game->lines);
     renderer_draw_controls();
 }
@@ -308,8 +669,26 @@ void renderer_draw_game(const GameState *game)
         return;
     }
     
-    /* Clear screen only on full redraw - for now just redraw everything */
-    clear();
+    /* ncurses cannot see resizes through the output pipe; check the terminal */
+    struct winsize size;
+    if (tap_active && ioctl(STDOUT_FILENO, TIOCGWINSZ, &size) == 0 && size.ws_row > 0 &&
+        size.ws_col > 0 && (size.ws_row != LINES || size.ws_col != COLS)) {
+        resizeterm(size.ws_row, size.ws_col);
+    }
+    
+    /* After a resize: new layout and one full repaint; otherwise ncurses diffs */
+    if (layout.cols != COLS || layout.rows != LINES) {
+        renderer_compute_layout(COLS, LINES, &layout);
+        clear();
+    } else {
+        erase();
+    }
+    
+    if (!layout.fits) {
+        mvprintw(0, 0, "Terminal too small (%dx%d needed)", BOARD_WIDTH_CHARS, BOARD_HEIGHT_CHARS);
+        refresh();
+        return;
+    }
     
     /* Draw main components */
     renderer_draw_board(&game->board, &game->current);
@@ -332,8 +711,8 @@ void renderer_draw_pause(void)
         return;
     }
     
-    int center_x = BOARD_DISPLAY_X + BOARD_WIDTH_CHARS / 2 - 4;
-    int center_y = BOARD_DISPLAY_Y + BOARD_HEIGHT / 2;
+    int center_x = layout.board_x + BOARD_WIDTH_CHARS / 2 - 4;
+    int center_y = layout.board_y + 1 + BOARD_HEIGHT / 2;
     
     /* Draw overlay box */
     attron(A_REVERSE);
@@ -349,8 +728,8 @@ void renderer_draw_game_over(int score)
         return;
     }
     
-    int center_x = BOARD_DISPLAY_X + BOARD_WIDTH_CHARS / 2 - 6;
-    int center_y = BOARD_DISPLAY_Y + BOARD_HEIGHT / 2 - 1;
+    int center_x = layout.board_x + BOARD_WIDTH_CHARS / 2 - 6;
+    int center_y = layout.board_y + BOARD_HEIGHT / 2;
     
     /* Draw overlay box with game over message */
     attron(A_REVERSE);
@@ -13,17 +13,100 @@
 #ifndef RENDERER_H
 #define RENDERER_H
 
+#include <stddef.h>
+#include <stdint.h>
 #include "tetromino.h"
 #include "game.h"
 
 /* Layout constants */
-#define BOARD_DISPLAY_X     2       /**< Board start column on screen */
-#define BOARD_DISPLAY_Y     1       /**< Board start row on screen */
+#define BOARD_DISPLAY_X     2       /**< Board column in the reference layout (no centering) */
+#define BOARD_DISPLAY_Y     1       /**< Board row in the reference layout (no centering) */
 #define BOARD_CELL_WIDTH    2       /**< Width of each cell in characters */
 #define BOARD_WIDTH_CHARS   (BOARD_WIDTH * BOARD_CELL_WIDTH + 2)  /**< Board width + borders */
 #define BOARD_HEIGHT_CHARS  (BOARD_HEIGHT + 2)  /**< Board height + borders */
-#define SIDEBAR_X           (BOARD_WIDTH_CHARS + 4)  /**< Sidebar start column */
+#define SIDEBAR_X           (BOARD_WIDTH_CHARS + 4)  /**< Sidebar column in the reference layout */
 #define SIDEBAR_WIDTH       20      /**< Sidebar width in characters */
+#define HOLD_BOX_OFFSET     12      /**< Hold preview column relative to SIDEBAR_X */
+#define PREVIEW_BOX_WIDTH   10      /**< Width of the next/hold preview boxes */
+#define SIDEBAR_GAP         2       /**< Columns between board border and sidebar */
+#define PREVIEW_ROW         3       /**< Preview boxes, rows below the board's top border */
+#define SCORE_ROW           10      /**< Score block, rows below the board's top border */
+#define CONTROLS_ROW        19      /**< Controls help, rows below the board's top border */
+#define CONTROLS_HEIGHT     8       /**< Rows of the controls help */
+
+/**
+ * @brief Screen positions for the current terminal size
+ *
+ * Computed once per terminal size by renderer_compute_layout() and
+ * cached by the renderer; every draw function reads its positions from
+ * here. The board is centred. On terminals too narrow for the sidebar
+ * it collapses into one status line under the board, and the controls
+ * help is left out when it does not fit below the score.
+ */
+typedef struct {
+    int cols;                   /**< Terminal width the layout is for */
+    int rows;                   /**< Terminal height the layout is for */
+    int fits;                   /**< 0 if not even the board fits */
+    int board_x;                /**< Column of the board's left border */
+    int board_y;                /**< Row of the board's top border */
+    int sidebar;                /**< 1 = full sidebar, 0 = collapsed */
+    int sidebar_x;              /**< Sidebar column (full sidebar only) */
+    int show_controls;          /**< 1 if the controls help fits */
+    int status_y;               /**< Row of the collapsed status line, -1 = none */
+} RendererLayout;
+
+/* Animation timing */
+#define RENDERER_CLEAR_ANIM_NS  200000000ULL    /**< Duration of the line-clear wipe */
+#define RENDERER_LOCK_ANIM_NS   80000000ULL     /**< Duration of the lock flash */
+
+/**
+ * @brief Running animations
+ *
+ * Animations are timed state, not delays: renderer_animate_event()
+ * starts them from engine events, renderer_advance_animations() moves
+ * them on once per frame and renderer_draw_board() paints them over the
+ * affected rows and cells only. The engine is never held back, so the
+ * next piece is already falling while the wipe runs.
+ */
+typedef struct {
+    int clear_rows;             /**< Rows being wiped (bit r = board row r), 0 = none */
+    int clear_step;             /**< Cells wiped away from each side so far */
+    int lock_active;            /**< 1 while the lock flash runs */
+    int lock_x[4];    /**< Board columns of the flashing cells */
+    int lock_y[4];    /**< Board rows of the flashing cells */
+    uint64_t clear_start_ns;    /**< Start of the wipe */
+    uint64_t lock_start_ns;     /**< Start of the lock flash */
+} RendererAnimation;
+
+/**
+ * @brief Computes the layout for a terminal size
+ *
+ * Pure function; does not need an initialized renderer.
+ *
+ * @param cols Terminal width in columns
+ * @param rows Terminal height in rows
+ * @param layout Output layout
+ */
+void renderer_compute_layout(int cols, int rows, RendererLayout *layout);
+
+/**
+ * @brief Gets the cached layout
+ *
+ * @return Layout of the last frame (zeroed before renderer_init())
+ */
+const RendererLayout *renderer_get_layout(void);
+
+/**
+ * @brief Receives a copy of the renderer's terminal output
+ *
+ * Called on the renderer's output thread, never on the thread that
+ * draws, with the bytes in the order they reach the terminal.
+ *
+ * @param data Bytes written to the terminal
+ * @param length Number of bytes
+ * @param ctx Context passed to renderer_set_output_tap()
+ */
+typedef void (*RendererOutputFn)(const char *data, size_t length, void *ctx);
 
 /**
  * @brief Initialize the renderer
@@ -55,12 +138,97 @@ void renderer_init(void);
  */
 void renderer_cleanup(void);
 
+/**
+ * @brief Installs a tap on the terminal output
+ *
+ * Takes effect at the next renderer_init(). ncurses then writes into a
+ * pipe, and a small output thread copies everything to the terminal
+ * and passes it to @p fn. The drawing thread only pays for the pipe
+ * write. Because ncurses no longer owns the terminal, the renderer sets
+ * the terminal modes itself, passes the screen size at init and checks
+ * for resizes in renderer_draw_game(). Forwarded bytes count in
+ * renderer_bytes_written().
+ *
+ * @param fn Receiver, or NULL to remove the tap
+ * @param ctx Context passed to @p fn
+ */
+void renderer_set_output_tap(RendererOutputFn fn, void *ctx);
+
+/**
+ * @brief Routes the terminal output through the output thread to count it
+ *
+ * Takes effect at the next renderer_init(). ncurses writes to the
+ * terminal file descriptor directly, bypassing stdio, so its output can
+ * only be counted on the pipe the output thread drains: the same path
+ * as renderer_set_output_tap(), without a receiver.
+ *
+ * @param enable 1 to count the output, 0 for plain ncurses output
+ */
+void renderer_set_output_counting(int enable);
+
+/**
+ * @brief Gets the number of bytes the renderer sent to the terminal
+ *
+ * Counts what the output thread forwarded since the program started, so
+ * only while a tap or counting is active (see
+ * renderer_set_output_counting()). Safe to call from any thread.
+ *
+ * @return Bytes written to the terminal
+ */
+unsigned long renderer_bytes_written(void);
+
+/**
+ * @brief Checks whether the renderer owns the terminal
+ *
+ * @return 1 between renderer_init() and renderer_cleanup(), 0 otherwise
+ */
+int renderer_is_active(void);
+
+/**
+ * @brief Starts the animation belonging to an engine event
+ *
+ * GAME_EVENT_PIECE_LOCKED flashes the locked cells,
+ * GAME_EVENT_LINES_CLEARED wipes the cleared rows (from ClearInfo's
+ * rows_mask) and ends the lock flash, whose cells have moved. Other
+ * events are ignored. Works without an initialized renderer.
+ *
+ * @param event Event from game_poll_event()
+ * @param now_ns Current time in nanoseconds (any monotonic clock)
+ */
+void renderer_animate_event(const GameEvent *event, uint64_t now_ns);
+
+/**
+ * @brief Moves the running animations to a point in time
+ *
+ * Call once per frame before drawing, with the same clock as
+ * renderer_animate_event().
+ *
+ * @param now_ns Current time in nanoseconds
+ * @return 1 while any animation is still running, 0 otherwise
+ */
+int renderer_advance_animations(uint64_t now_ns);
+
+/**
+ * @brief Gets the animation state
+ * @return Pointer to the renderer's animation state
+ */
+const RendererAnimation *renderer_get_animation(void);
+
 /**
  * @brief Draw the complete game screen
  * 
  * Renders all game elements: board with current piece, sidebar
  * with next piece, score, level, lines, and controls.
  * 
+ * If the terminal size changed since the last frame, the layout is
+ * recomputed and the whole screen is repainted once; otherwise ncurses
+ * only sends what changed. The input thread reads stdin directly, so
+ * getch() never reports KEY_RESIZE. Without the output pipe, ncurses
+ * picks up the new size inside refresh()/doupdate() after SIGWINCH and
+ * the layout follows on the next frame. With the pipe (tap or output
+ * counting), ncurses sees no terminal on its output, so this function
+ * queries TIOCGWINSZ on stdout itself and calls resizeterm().
+ * 
  * @param game Pointer to the current game state
  * 
  * @note This is the main rendering function - call this every frame
@@ -79,6 +247,7 @@ void renderer_draw_game(const GameState *game);
  * @note Each cell is rendered as 2 characters wide
  * @note Empty cells show as spaces with black background
  * @note Filled cells show as "██" with tetromino color
+ * @note Running animations are painted between the board and the piece
  */
 void renderer_draw_board(const Board *board, const Tetromino *current);
 
@@ -102,6 +271,16 @@ void renderer_draw_sidebar(const GameState *game);
  */
 void renderer_draw_next_piece(TetrominoType next_type);
 
+/**
+ * @brief Draw the hold piece preview
+ * 
+ * Renders a 4x4 box next to the next piece preview showing the
+ * held tetromino. An empty slot (TETRO_COUNT) draws an empty box.
+ * 
+ * @param hold_type The held tetromino type, or TETRO_COUNT if empty
+ */
+void renderer_draw_hold_piece(TetrominoType hold_type);
+
 /**
  * @brief Draw the score display
  * 
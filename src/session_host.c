@@ -0,0 +1,421 @@
+/**
+ * @file session_host.c
+ * @brief Headless multi-session host implementation
+ */
+
+#include "session_host.h"
+
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/**
+ * @brief Initial capacity of the slab table
+ */
+#define INITIAL_SLABS 16
+
+struct SessionHost {
+    Session **slabs;            /**< Slab table; slabs never move */
+    size_t slab_count;          /**< Allocated slabs */
+    size_t slab_capacity;       /**< Capacity of the slab table */
+    SessionId *free_ids;        /**< Stack of free slots */
+    size_t free_count;          /**< Entries on the free stack */
+    size_t live;                /**< Live sessions */
+    ThreadPool *pool;           /**< Pool for batches (may be NULL) */
+    SessionDriverFn driver;     /**< Input driver */
+    void *driver_ctx;           /**< Driver context */
+    uint64_t tick_ns;           /**< Tick length */
+    int restart_on_game_over;   /**< Restart finished games */
+    Metrics *metrics;           /**< Exported counters (may be NULL) */
+    uint64_t samples[SESSION_TICK_SAMPLES]; /**< Ring of tick durations */
+    size_t sample_count;        /**< Valid entries in samples */
+    size_t sample_next;         /**< Next write position in samples */
+    unsigned long overruns;     /**< Paced ticks longer than tick_ns */
+};
+
+/**
+ * @brief Reads the monotonic clock in nanoseconds
+ * @return Current time
+ */
+static uint64_t now_ns(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000ULL + (uint64_t)now.tv_nsec;
+}
+
+/**
+ * @brief SplitMix64 step on a caller-owned state
+ * @param state Random state to advance
+ * @return Next random value
+ */
+static uint64_t splitmix64(uint64_t *state)
+{
+    uint64_t z = (*state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+/**
+ * @brief Starts (or restarts) the game of a session
+ * @param session Session to start
+ */
+static void start_game(Session *session)
+{
+    /* Derive a fresh seed per restart so consecutive games differ */
+    uint64_t seed = session->seed + session->games_finished * 0x9E3779B97F4A7C15ULL;
+    game_init_seeded(&session->game, seed);
+    session->game_time_ns = 0;
+    game_advance(&session->game, 0);
+}
+
+/**
+ * @brief Outcome counters of one batch
+ */
+typedef struct {
+    unsigned long pieces;       /**< Pieces locked */
+    unsigned long lines;        /**< Lines cleared */
+} BatchCounts;
+
+/**
+ * @brief Advances one session by one tick
+ * @param host Pointer to host
+ * @param session Session to advance
+ * @param counts Batch counters to add this session's outcome to
+ */
+static void tick_session(const SessionHost *host, Session *session, BatchCounts *counts)
+{
+    GameState *game = &session->game;
+
+    if (!game->is_running) {
+        if (!host->restart_on_game_over) {
+            return;
+        }
+        start_game(session);
+    }
+
+    InputAction action = host->driver(game, &session->script_state, host->driver_ctx);
+    game_apply_actions(game, &action, 1);
+
+    session->game_time_ns += host->tick_ns;
+    game_advance(game, session->game_time_ns);
+
+    /* Drain events so the queue never overflows and count outcomes */
+    GameEvent event;
+    while (game_poll_event(game, &event)) {
+        if (event.type == GAME_EVENT_PIECE_LOCKED) {
+            session->pieces++;
+            counts->pieces++;
+        } else if (event.type == GAME_EVENT_LINES_CLEARED) {
+            counts->lines += (unsigned long)event.clear.lines;
+        } else if (event.type == GAME_EVENT_GAME_OVER) {
+            session->games_finished++;
+        }
+    }
+}
+
+/**
+ * @brief Range function: advances all sessions of slabs [begin, end)
+ * @param ctx Pointer to host
+ * @param begin First slab
+ * @param end One past the last slab
+ */
+static void tick_slabs(void *ctx, size_t begin, size_t end)
+{
+    const SessionHost *host = ctx;
+    BatchCounts counts = { 0, 0 };
+
+    for (size_t s = begin; s < end; s++) {
+        Session *slab = host->slabs[s];
+        for (size_t i = 0; i < SESSION_SLAB_SIZE; i++) {
+            if (slab[i].in_use) {
+                tick_session(host, &slab[i], &counts);
+            }
+        }
+    }
+
+    /* One atomic update per batch instead of one per piece */
+    if (host->metrics != NULL) {
+        metrics_add_pieces(host->metrics, counts.pieces, counts.lines);
+    }
+}
+
+/**
+ * @brief Allocates one more slab and pushes its slots onto the free list
+ * @param host Pointer to host
+ * @return 1 on success, 0 if allocation failed
+ */
+static int grow(SessionHost *host)
+{
+    if (host->slab_count == host->slab_capacity) {
+        size_t capacity = host->slab_capacity * 2;
+        Session **slabs = realloc(host->slabs, capacity * sizeof(Session *));
+        if (slabs == NULL) {
+            return 0;
+        }
+        host->slabs = slabs;
+
+        SessionId *free_ids = realloc(host->free_ids,
+                                      capacity * SESSION_SLAB_SIZE * sizeof(SessionId));
+        if (free_ids == NULL) {
+            return 0;
+        }
+        host->free_ids = free_ids;
+        host->slab_capacity = capacity;
+    }
+
+    /* Slab size is a multiple of the cache line, as aligned_alloc requires */
+    Session *slab = aligned_alloc(64, SESSION_SLAB_SIZE * sizeof(Session));
+    if (slab == NULL) {
+        return 0;
+    }
+    memset(slab, 0, SESSION_SLAB_SIZE * sizeof(Session));
+
+    SessionId base = (SessionId)(host->slab_count * SESSION_SLAB_SIZE);
+    host->slabs[host->slab_count++] = slab;
+
+    /* Push in reverse so the lowest slot is handed out first */
+    for (size_t i = SESSION_SLAB_SIZE; i > 0; i--) {
+        host->free_ids[host->free_count++] = base + (SessionId)(i - 1);
+    }
+    return 1;
+}
+
+/**
+ * @brief Maps a handle to its slot without checking liveness
+ * @param host Pointer to host
+ * @param id Session handle
+ * @return Pointer to the slot, or NULL if @p id is out of range
+ */
+static Session *slot(const SessionHost *host, SessionId id)
+{
+    size_t s = id / SESSION_SLAB_SIZE;
+    if (id == SESSION_INVALID || s >= host->slab_count) {
+        return NULL;
+    }
+    return &host->slabs[s][id % SESSION_SLAB_SIZE];
+}
+
+static int compare_u64(const void *a, const void *b)
+{
+    uint64_t x = *(const uint64_t *)a;
+    uint64_t y = *(const uint64_t *)b;
+    return (x > y) - (x < y);
+}
+
+SessionHost *session_host_create(const SessionHostConfig *config)
+{
+    SessionHost *host = calloc(1, sizeof(SessionHost));
+    if (host == NULL) {
+        return NULL;
+    }
+
+    host->slabs = malloc(INITIAL_SLABS * sizeof(Session *));
+    host->free_ids = malloc(INITIAL_SLABS * SESSION_SLAB_SIZE * sizeof(SessionId));
+    if (host->slabs == NULL || host->free_ids == NULL) {
+        session_host_destroy(host);
+        return NULL;
+    }
+    host->slab_capacity = INITIAL_SLABS;
+
+    host->driver = session_script_driver;
+    host->tick_ns = SESSION_DEFAULT_TICK_NS;
+    host->restart_on_game_over = 1;
+    if (config != NULL) {
+        host->pool = config->pool;
+        host->driver_ctx = config->driver_ctx;
+        host->restart_on_game_over = config->restart_on_game_over;
+        host->metrics = config->metrics;
+        if (config->driver != NULL) {
+            host->driver = config->driver;
+        }
+        if (config->tick_ns > 0) {
+            host->tick_ns = config->tick_ns;
+        }
+    }
+    return host;
+}
+
+void session_host_destroy(SessionHost *host)
+{
+    if (host == NULL) {
+        return;
+    }
+    for (size_t s = 0; s < host->slab_count; s++) {
+        free(host->slabs[s]);
+    }
+    free(host->slabs);
+    free(host->free_ids);
+    free(host);
+}
+
+SessionId session_host_create_session(SessionHost *host, uint64_t seed)
+{
+    assert(host != NULL);
+
+    if (host->free_count == 0 && !grow(host)) {
+        return SESSION_INVALID;
+    }
+
+    SessionId id = host->free_ids[--host->free_count];
+    Session *session = slot(host, id);
+
+    memset(session, 0, sizeof(Session));
+    session->seed = seed;
+    session->script_state = seed ^ 0xD1B54A32D192ED03ULL;
+    session->in_use = 1;
+    start_game(session);
+
+    host->live++;
+    return id;
+}
+
+void session_host_destroy_session(SessionHost *host, SessionId id)
+{
+    assert(host != NULL);
+
+    Session *session = slot(host, id);
+    if (session == NULL || !session->in_use) {
+        return;
+    }
+    session->in_use = 0;
+    host->free_ids[host->free_count++] = id;
+    host->live--;
+}
+
+const Session *session_host_get(const SessionHost *host, SessionId id)
+{
+    assert(host != NULL);
+
+    const Session *session = slot(host, id);
+    return (session != NULL && session->in_use) ? session : NULL;
+}
+
+size_t session_host_count(const SessionHost *host)
+{
+    assert(host != NULL);
+    return host->live;
+}
+
+uint64_t session_host_tick(SessionHost *host)
+{
+    assert(host != NULL);
+
+    uint64_t start = now_ns();
+    if (host->pool != NULL) {
+        /* One slab per chunk: each batch is a contiguous run of sessions */
+        threadpool_parallel_for(host->pool, host->slab_count, 1, tick_slabs, host);
+    } else {
+        tick_slabs(host, 0, host->slab_count);
+    }
+    uint64_t elapsed = now_ns() - start;
+
+    if (host->metrics != NULL) {
+        metrics_observe_tick(host->metrics, elapsed);
+        metrics_set_games_active(host->metrics, (long)host->live);
+    }
+
+    host->samples[host->sample_next] = elapsed;
+    host->sample_next = (host->sample_next + 1) % SESSION_TICK_SAMPLES;
+    if (host->sample_count < SESSION_TICK_SAMPLES) {
+        host->sample_count++;
+    }
+    return elapsed;
+}
+
+void session_host_run(SessionHost *host, unsigned long ticks)
+{
+    assert(host != NULL);
+
+    uint64_t deadline = now_ns();
+    for (unsigned long t = 0; t < ticks; t++) {
+        struct timespec wake = {
+            .tv_sec = (time_t)(deadline / 1000000000ULL),
+            .tv_nsec = (long)(deadline % 1000000000ULL)
+        };
+        clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &wake, NULL);
+
+        if (session_host_tick(host) > host->tick_ns) {
+            host->overruns++;
+        }
+
+        deadline += host->tick_ns;
+        uint64_t now = now_ns();
+        if (now > deadline) {
+            /* Late: continue from now instead of bursting to catch up */
+            deadline = now;
+        }
+    }
+}
+
+void session_host_tick_stats(const SessionHost *host, SessionTickStats *stats)
+{
+    assert(host != NULL);
+    assert(stats != NULL);
+
+    memset(stats, 0, sizeof(SessionTickStats));
+    stats->overruns = host->overruns;
+    stats->samples = host->sample_count;
+    if (host->sample_count == 0) {
+        return;
+    }
+
+    uint64_t sorted[SESSION_TICK_SAMPLES];
+    size_t n = host->sample_count;
+    memcpy(sorted, host->samples, n * sizeof(uint64_t));
+    qsort(sorted, n, sizeof(uint64_t), compare_u64);
+
+    stats->p50 = sorted[(n - 1) * 50 / 100];
+    stats->p90 = sorted[(n - 1) * 90 / 100];
+    stats->p99 = sorted[(n - 1) * 99 / 100];
+    stats->max = sorted[n - 1];
+}
+
+void session_host_reset_stats(SessionHost *host)
+{
+    assert(host != NULL);
+
+    host->sample_count = 0;
+    host->sample_next = 0;
+    host->overruns = 0;
+}
+
+void session_host_totals(const SessionHost *host, SessionTotals *totals)
+{
+    assert(host != NULL);
+    assert(totals != NULL);
+
+    memset(totals, 0, sizeof(SessionTotals));
+    for (size_t s = 0; s < host->slab_count; s++) {
+        const Session *slab = host->slabs[s];
+        for (size_t i = 0; i < SESSION_SLAB_SIZE; i++) {
+            if (!slab[i].in_use) {
+                continue;
+            }
+            totals->sessions++;
+            totals->pieces += slab[i].pieces;
+            totals->lines += (uint64_t)slab[i].game.lines;
+            totals->games_finished += slab[i].games_finished;
+        }
+    }
+}
+
+InputAction session_script_driver(const GameState *game,
+                                   uint64_t *script_state, void *ctx)
+{
+    (void)game;
+    (void)ctx;
+
+    uint64_t r = splitmix64(script_state);
+
+    /* Roughly one hard drop every eight ticks, random moves otherwise */
+    if ((r & 7) == 0) {
+        return INPUT_HARD_DROP;
+    }
+    static const InputAction moves[] = {
+        INPUT_LEFT, INPUT_RIGHT, INPUT_ROTATE_CW, INPUT_ROTATE_CCW, INPUT_NONE
+    };
+    return moves[(r >> 3) % (sizeof(moves) / sizeof(moves[0]))];
+}
@@ -0,0 +1,238 @@
+/**
+ * @file session_host.h
+ * @brief Headless multi-session host for load testing
+ *
+ * Hosts many independent games in one process, each driven by a
+ * scripted or bot input function instead of a keyboard. Sessions live
+ * in fixed-size slabs that are allocated on demand and never moved, so
+ * session handles stay valid and the games of one slab are contiguous
+ * in memory. Freed slots go onto a free list and are reused before a
+ * new slab is allocated.
+ *
+ * A tick advances every live session by one input action and moves its
+ * game clock on by one tick for gravity and lock delay (game_advance()
+ * on simulated time, so results do not depend on how fast the host
+ * runs). Ticks are split into
+ * batches of whole slabs and scheduled on a ThreadPool, so each worker
+ * walks contiguous memory. The duration of every tick is recorded and
+ * can be summarized as percentiles.
+ *
+ * Sessions are created and destroyed only between ticks, from the
+ * thread that owns the host.
+ *
+ * @author Tetris CLI Project
+ * @version 1.0
+ */
+
+#ifndef SESSION_HOST_H
+#define SESSION_HOST_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "game.h"
+#include "input.h"
+#include "metrics.h"
+#include "threadpool.h"
+
+/**
+ * @brief Sessions per slab (one batch of a tick)
+ */
+#define SESSION_SLAB_SIZE 64
+
+/**
+ * @brief Number of recent tick durations kept for percentiles
+ */
+#define SESSION_TICK_SAMPLES 4096
+
+/**
+ * @brief Default tick length (60 Hz)
+ */
+#define SESSION_DEFAULT_TICK_NS 16666667ULL
+
+/**
+ * @brief Handle of a hosted session
+ */
+typedef uint32_t SessionId;
+
+/**
+ * @brief Returned by session_host_create_session() on failure
+ */
+#define SESSION_INVALID UINT32_MAX
+
+/**
+ * @brief Input driver called once per session and tick
+ *
+ * Called concurrently for different sessions, so it must not write
+ * shared state; per-session state belongs in @p script_state.
+ *
+ * @param game Game of the session (read-only)
+ * @param script_state Per-session driver state, seeded at creation
+ * @param ctx User context from the host configuration
+ * @return Action to apply this tick (INPUT_NONE for none)
+ */
+typedef InputAction (*SessionDriverFn)(const GameState *game,
+                                       uint64_t *script_state, void *ctx);
+
+/**
+ * @brief Host configuration
+ */
+typedef struct {
+    ThreadPool *pool;           /**< Pool for batches, NULL = run on the caller */
+    SessionDriverFn driver;     /**< Input driver, NULL = session_script_driver */
+    void *driver_ctx;           /**< Context passed to @c driver */
+    uint64_t tick_ns;           /**< Tick length, 0 = SESSION_DEFAULT_TICK_NS */
+    int restart_on_game_over;   /**< 1 = reseed and restart finished games */
+    Metrics *metrics;           /**< Counters to update per tick, NULL = none */
+} SessionHostConfig;
+
+/**
+ * @brief One hosted game
+ */
+typedef struct {
+    GameState game;             /**< Engine state */
+    uint64_t seed;              /**< Seed the session was created with */
+    uint64_t script_state;      /**< Driver state */
+    uint64_t game_time_ns;      /**< Simulated game time, tick_ns per tick */
+    uint32_t in_use;            /**< 1 if the slot holds a live session */
+    uint64_t pieces;            /**< Pieces locked over all games */
+    uint64_t games_finished;    /**< Games that ended in game over */
+} Session;
+
+/**
+ * @brief Tick duration summary in nanoseconds
+ */
+typedef struct {
+    size_t samples;             /**< Number of ticks summarized */
+    uint64_t p50;               /**< Median */
+    uint64_t p90;               /**< 90th percentile */
+    uint64_t p99;               /**< 99th percentile */
+    uint64_t max;               /**< Slowest tick */
+    unsigned long overruns;     /**< Paced ticks that exceeded tick_ns */
+} SessionTickStats;
+
+/**
+ * @brief Aggregate counters over all live sessions
+ */
+typedef struct {
+    size_t sessions;            /**< Live sessions */
+    uint64_t pieces;            /**< Pieces locked */
+    uint64_t lines;             /**< Lines cleared in the running games */
+    uint64_t games_finished;    /**< Games that ended in game over */
+} SessionTotals;
+
+/**
+ * @brief Opaque host handle
+ */
+typedef struct SessionHost SessionHost;
+
+/**
+ * @brief Creates an empty host
+ *
+ * @param config Configuration, or NULL for defaults (serial, scripted input)
+ * @return New host, or NULL if allocation failed
+ */
+SessionHost *session_host_create(const SessionHostConfig *config);
+
+/**
+ * @brief Frees the host and all of its sessions
+ *
+ * @param host Host to destroy (NULL is ignored)
+ */
+void session_host_destroy(SessionHost *host);
+
+/**
+ * @brief Starts a new seeded game
+ *
+ * @param host Pointer to host
+ * @param seed Seed for the game and the driver state
+ * @return Handle of the session, or SESSION_INVALID if allocation failed
+ */
+SessionId session_host_create_session(SessionHost *host, uint64_t seed);
+
+/**
+ * @brief Ends a session and returns its slot to the free list
+ *
+ * @param host Pointer to host
+ * @param id Session to end (unknown or already freed ids are ignored)
+ */
+void session_host_destroy_session(SessionHost *host, SessionId id);
+
+/**
+ * @brief Looks up a live session
+ *
+ * @param host Pointer to host
+ * @param id Session handle
+ * @return Pointer to the session, or NULL if @p id is not live
+ */
+const Session *session_host_get(const SessionHost *host, SessionId id);
+
+/**
+ * @brief Gets the number of live sessions
+ *
+ * @param host Pointer to host
+ * @return Live session count
+ */
+size_t session_host_count(const SessionHost *host);
+
+/**
+ * @brief Advances every live session by one tick
+ *
+ * Runs as fast as possible; the duration is recorded for
+ * session_host_tick_stats().
+ *
+ * @param host Pointer to host
+ * @return Duration of the tick in nanoseconds
+ */
+uint64_t session_host_tick(SessionHost *host);
+
+/**
+ * @brief Runs ticks on the fixed tick schedule
+ *
+ * Each tick starts at an absolute deadline tick_ns after the previous
+ * one; a tick that takes longer than tick_ns counts as an overrun and
+ * the schedule continues from the late deadline.
+ *
+ * @param host Pointer to host
+ * @param ticks Number of ticks to run
+ */
+void session_host_run(SessionHost *host, unsigned long ticks);
+
+/**
+ * @brief Summarizes the recorded tick durations
+ *
+ * @param host Pointer to host
+ * @param stats Output summary
+ */
+void session_host_tick_stats(const SessionHost *host, SessionTickStats *stats);
+
+/**
+ * @brief Clears the recorded tick durations and overruns
+ *
+ * @param host Pointer to host
+ */
+void session_host_reset_stats(SessionHost *host);
+
+/**
+ * @brief Sums counters over all live sessions
+ *
+ * @param host Pointer to host
+ * @param totals Output counters
+ */
+void session_host_totals(const SessionHost *host, SessionTotals *totals);
+
+/**
+ * @brief Default scripted driver
+ *
+ * Plays random shifts and rotations from a per-session SplitMix64
+ * stream and hard-drops every few ticks, so games lock pieces at a
+ * steady rate without any search.
+ *
+ * @param game Game of the session
+ * @param script_state Per-session random state
+ * @param ctx Unused
+ * @return Next action
+ */
+InputAction session_script_driver(const GameState *game,
+                                  uint64_t *script_state, void *ctx);
+
+#endif /* SESSION_HOST_H */
@@ -0,0 +1,451 @@
+/**
+ * @file spectator.c
+ * @brief Tiled multi-board view implementation
+ */
+
+#include "spectator.h"
+
+#include <assert.h>
+#include <ncurses.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "glyphs.h"
+#include "renderer.h"
+
+/**
+ * @brief Shadow value of a glyph whose screen content is unknown
+ */
+#define GLYPH_UNKNOWN 0xFFFF
+
+/**
+ * @brief Color pair of empty cells (see renderer_init())
+ */
+#define EMPTY_PAIR 8
+
+/**
+ * @brief Everything besides the board cells that a tile shows
+ *
+ * Together with the revision counter this tells whether a board can be
+ * skipped. The extra fields catch a game that was re-initialized in
+ * place, which restarts its revision count.
+ */
+typedef struct {
+    unsigned int revision;
+    int score;
+    int is_running;
+    int type;
+    int rotation;
+    int x;
+    int y;
+} TileKey;
+
+/**
+ * @brief Screen state of one tile
+ */
+typedef struct {
+    const GameState *source;    /**< Game drawn last frame */
+    TileKey key;                /**< Its key at that time */
+    int valid;                  /**< 0 = redraw everything */
+    int label_score;            /**< Score shown in the label */
+    int label_running;          /**< Running flag shown in the label */
+    uint16_t glyphs[BOARD_HEIGHT][BOARD_WIDTH]; /**< Glyphs as on screen */
+} Tile;
+
+/**
+ * @brief Board cells covered by one glyph and its width on screen
+ */
+typedef struct {
+    int cell_cols;
+    int cell_rows;
+    int width;
+} GlyphShape;
+
+static const GlyphShape GLYPH_SHAPES[] = {
+    [SPECTATOR_GLYPHS_WIDE]    = { 1, 1, 2 },
+    [SPECTATOR_GLYPHS_COMPACT] = { 1, 1, 1 },
+    [SPECTATOR_GLYPHS_HALF]    = { 1, GLYPHS_HALF_ROWS, 1 },
+    [SPECTATOR_GLYPHS_BRAILLE] = { GLYPHS_BRAILLE_COLS, GLYPHS_BRAILLE_ROWS, 1 }
+};
+
+struct SpectatorView {
+    size_t capacity;
+    SpectatorGlyphs glyphs;
+    int cols;
+    int rows;
+    int grid_cols;              /**< Tiles per row */
+    size_t visible;
+    size_t last_count;          /**< Board count of the previous frame */
+    int full_redraw;
+    SpectatorStats stats;
+    Tile tiles[];
+};
+
+/**
+ * @brief Glyphs per board row
+ */
+static int glyph_cols(SpectatorGlyphs glyphs)
+{
+    int per = GLYPH_SHAPES[glyphs].cell_cols;
+    return (BOARD_WIDTH + per - 1) / per;
+}
+
+/**
+ * @brief Glyph rows per board
+ */
+static int glyph_rows(SpectatorGlyphs glyphs)
+{
+    int per = GLYPH_SHAPES[glyphs].cell_rows;
+    return (BOARD_HEIGHT + per - 1) / per;
+}
+
+/**
+ * @brief Width of a tile's box without the gap
+ */
+static int box_width(SpectatorGlyphs glyphs)
+{
+    return glyph_cols(glyphs) * GLYPH_SHAPES[glyphs].width + 2;
+}
+
+/**
+ * @brief Height of a tile including its label
+ */
+static int tile_height(SpectatorGlyphs glyphs)
+{
+    return glyph_rows(glyphs) + 3;
+}
+
+static void invalidate_tiles(SpectatorView *view)
+{
+    for (size_t i = 0; i < view->capacity; i++) {
+        view->tiles[i].valid = 0;
+        view->tiles[i].source = NULL;
+    }
+    view->full_redraw = 1;
+}
+
+SpectatorView *spectator_create(size_t capacity, SpectatorGlyphs glyphs)
+{
+    SpectatorView *view = calloc(1, sizeof(*view) + capacity * sizeof(Tile));
+    if (view == NULL) {
+        return NULL;
+    }
+    view->capacity = capacity;
+    view->glyphs = glyphs;
+    invalidate_tiles(view);
+    return view;
+}
+
+void spectator_destroy(SpectatorView *view)
+{
+    free(view);
+}
+
+void spectator_layout(SpectatorView *view, int cols, int rows)
+{
+    assert(view != NULL);
+
+    int width, height;
+    spectator_tile_size(view, &width, &height);
+    int grid_cols = cols >= width - SPECTATOR_TILE_GAP
+        ? (cols + SPECTATOR_TILE_GAP) / width : 0;
+    int grid_rows = rows >= height ? rows / height : 0;
+
+    size_t fit = (size_t)grid_cols * (size_t)grid_rows;
+    view->cols = cols;
+    view->rows = rows;
+    view->grid_cols = grid_cols;
+    view->visible = fit < view->capacity ? fit : view->capacity;
+    invalidate_tiles(view);
+}
+
+void spectator_set_glyphs(SpectatorView *view, SpectatorGlyphs glyphs)
+{
+    assert(view != NULL);
+    view->glyphs = glyphs;
+    spectator_layout(view, view->cols, view->rows);
+}
+
+void spectator_tile_size(const SpectatorView *view, int *width, int *height)
+{
+    assert(view != NULL);
+    *width = box_width(view->glyphs) + SPECTATOR_TILE_GAP;
+    *height = tile_height(view->glyphs);
+}
+
+size_t spectator_visible(const SpectatorView *view)
+{
+    assert(view != NULL);
+    return view->visible;
+}
+
+int spectator_tile_origin(const SpectatorView *view, size_t index, int *x, int *y)
+{
+    assert(view != NULL);
+
+    if (index >= view->visible) {
+        return 0;
+    }
+    int width, height;
+    spectator_tile_size(view, &width, &height);
+    *x = (int)(index % (size_t)view->grid_cols) * width;
+    *y = (int)(index / (size_t)view->grid_cols) * height;
+    return 1;
+}
+
+void spectator_invalidate(SpectatorView *view)
+{
+    assert(view != NULL);
+    invalidate_tiles(view);
+}
+
+void spectator_stats(const SpectatorView *view, SpectatorStats *stats)
+{
+    assert(view != NULL && stats != NULL);
+    *stats = view->stats;
+}
+
+static TileKey make_key(const GameState *game)
+{
+    TileKey key;
+    memset(&key, 0, sizeof(key));
+    if (game != NULL) {
+        key.revision = game->revision;
+        key.score = game->score;
+        key.is_running = game->is_running;
+        key.type = (int)game->current.type;
+        key.rotation = game->current.rotation;
+        key.x = game->current.x;
+        key.y = game->current.y;
+    }
+    return key;
+}
+
+/**
+ * @brief Board cells with the falling piece on top
+ */
+static void compose(const GameState *game, unsigned char out[BOARD_HEIGHT][BOARD_WIDTH])
+{
+    if (game == NULL) {
+        memset(out, 0, sizeof(unsigned char) * BOARD_HEIGHT * BOARD_WIDTH);
+        return;
+    }
+
+    for (int y = 0; y < BOARD_HEIGHT; y++) {
+        for (int x = 0; x < BOARD_WIDTH; x++) {
+            out[y][x] = (unsigned char)game->board.cells[y][x];
+        }
+    }
+
+    if (!game->is_running) {
+        return;
+    }
+    const int (*shape)[TETRO_MATRIX_SIZE] = tetromino_get_shape(game->current.type,
+                                                               game->current.rotation);
+    if (shape == NULL) {
+        return;
+    }
+    unsigned char color = (unsigned char)tetromino_get_color(game->current.type);
+    for (int row = 0; row < TETRO_MATRIX_SIZE; row++) {
+        for (int col = 0; col < TETRO_MATRIX_SIZE; col++) {
+            int bx = game->current.x + col;
+            int by = game->current.y + row;
+            if (shape[row][col] && bx >= 0 && bx < BOARD_WIDTH &&
+                by >= 0 && by < BOARD_HEIGHT) {
+                out[by][bx] = color;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Turns a board into the glyphs of the current mode
+ *
+ * Single-cell modes keep the cell color; packed modes keep only the
+ * fill mask, so a color change under a packed glyph costs nothing.
+ */
+static void encode(SpectatorGlyphs mode, const GameState *game,
+                   uint16_t out[BOARD_HEIGHT][BOARD_WIDTH])
+{
+    unsigned char cells[BOARD_HEIGHT][BOARD_WIDTH];
+    compose(game, cells);
+
+    const GlyphShape *shape = &GLYPH_SHAPES[mode];
+    if (shape->cell_cols == 1 && shape->cell_rows == 1) {
+        for (int y = 0; y < BOARD_HEIGHT; y++) {
+            for (int x = 0; x < BOARD_WIDTH; x++) {
+                out[y][x] = cells[y][x];
+            }
+        }
+        return;
+    }
+
+    /* Row bitmasks, padded so the last glyph row may overhang */
+    uint32_t rows[BOARD_HEIGHT + GLYPHS_BRAILLE_ROWS] = { 0 };
+    for (int y = 0; y < BOARD_HEIGHT; y++) {
+        for (int x = 0; x < BOARD_WIDTH; x++) {
+            rows[y] |= (uint32_t)(cells[y][x] != 0) << x;
+        }
+    }
+
+    int cols = glyph_cols(mode);
+    int glyph_rows_n = glyph_rows(mode);
+    for (int gy = 0; gy < glyph_rows_n; gy++) {
+        const uint32_t *band = &rows[gy * shape->cell_rows];
+        for (int gx = 0; gx < cols; gx++) {
+            int x = gx * shape->cell_cols;
+            out[gy][gx] = (uint16_t)(mode == SPECTATOR_GLYPHS_HALF
+                ? glyphs_half_mask(band[0], band[1], x)
+                : glyphs_braille_mask(band, x));
+        }
+    }
+}
+
+/**
+ * @brief Draws a tile's empty box
+ */
+static void draw_frame(const SpectatorView *view, int x, int y)
+{
+    int inner = box_width(view->glyphs) - 2;
+    int height = glyph_rows(view->glyphs);
+
+    mvaddstr(y + 1, x, "┌");
+    for (int i = 0; i < inner; i++) {
+        addstr("─");
+    }
+    addstr("┐");
+    for (int row = 0; row < height; row++) {
+        mvaddstr(y + 2 + row, x, "│");
+        mvaddstr(y + 2 + row, x + 1 + inner, "│");
+    }
+    mvaddstr(y + 2 + height, x, "└");
+    for (int i = 0; i < inner; i++) {
+        addstr("─");
+    }
+    addstr("┘");
+}
+
+static void draw_label(const SpectatorView *view, int x, int y, size_t index,
+                       const GameState *game)
+{
+    char label[64];
+    int width = box_width(view->glyphs);
+
+    if (game == NULL) {
+        snprintf(label, sizeof(label), "#%zu", index);
+    } else {
+        snprintf(label, sizeof(label), "#%zu %d%s", index, game->score,
+                 game->is_running ? "" : " over");
+    }
+    mvprintw(y, x, "%-*.*s", width, width, label);
+}
+
+static void draw_glyph(const SpectatorView *view, int x, int y, unsigned int glyph_value)
+{
+    int pair = EMPTY_PAIR;
+    const char *glyph;
+    switch (view->glyphs) {
+    case SPECTATOR_GLYPHS_HALF:
+        glyph = glyphs_half(glyph_value);
+        break;
+    case SPECTATOR_GLYPHS_BRAILLE:
+        glyph = glyphs_braille(glyph_value);
+        break;
+    case SPECTATOR_GLYPHS_COMPACT:
+        pair = glyph_value != 0 ? (int)glyph_value : EMPTY_PAIR;
+        glyph = glyph_value != 0 ? "█" : " ";
+        break;
+    default:
+        pair = glyph_value != 0 ? (int)glyph_value : EMPTY_PAIR;
+        glyph = glyph_value != 0 ? "██" : "  ";
+        break;
+    }
+    attron(COLOR_PAIR(pair));
+    mvaddstr(y, x, glyph);
+    attroff(COLOR_PAIR(pair));
+}
+
+void spectator_draw(SpectatorView *view, const GameState *const *games, size_t count)
+{
+    assert(view != NULL);
+    assert(games != NULL || count == 0);
+
+    int active = renderer_is_active();
+    int width = GLYPH_SHAPES[view->glyphs].width;
+    int cols = glyph_cols(view->glyphs);
+    int rows = glyph_rows(view->glyphs);
+    size_t shown = count < view->visible ? count : view->visible;
+
+    /* Tiles of boards that went away must be wiped */
+    if (count != view->last_count) {
+        invalidate_tiles(view);
+        view->last_count = count;
+    }
+
+    if (view->full_redraw) {
+        if (active) {
+            erase();
+            for (size_t i = 0; i < shown; i++) {
+                int x, y;
+                spectator_tile_origin(view, i, &x, &y);
+                draw_frame(view, x, y);
+            }
+        }
+        view->full_redraw = 0;
+    }
+
+    for (size_t i = 0; i < shown; i++) {
+        const GameState *game = games[i];
+        Tile *tile = &view->tiles[i];
+        TileKey key = make_key(game);
+
+        if (tile->valid && tile->source == game &&
+            memcmp(&tile->key, &key, sizeof(key)) == 0) {
+            view->stats.boards_skipped++;
+            continue;
+        }
+
+        int x, y;
+        spectator_tile_origin(view, i, &x, &y);
+
+        uint16_t glyphs[BOARD_HEIGHT][BOARD_WIDTH];
+        encode(view->glyphs, game, glyphs);
+
+        if (!tile->valid) {
+            memset(tile->glyphs, 0xFF, sizeof(tile->glyphs));   /* GLYPH_UNKNOWN */
+        }
+        for (int row = 0; row < rows; row++) {
+            for (int col = 0; col < cols; col++) {
+                if (tile->glyphs[row][col] == glyphs[row][col]) {
+                    continue;
+                }
+                tile->glyphs[row][col] = glyphs[row][col];
+                view->stats.glyphs_drawn++;
+                if (active) {
+                    draw_glyph(view, x + 1 + col * width, y + 2 + row, glyphs[row][col]);
+                }
+            }
+        }
+
+        int score = game != NULL ? game->score : 0;
+        int running = game != NULL ? game->is_running : 1;
+        if (!tile->valid || tile->source != game ||
+            tile->label_score != score || tile->label_running != running) {
+            if (active) {
+                draw_label(view, x, y, i, game);
+            }
+            tile->label_score = score;
+            tile->label_running = running;
+        }
+
+        tile->source = game;
+        tile->key = key;
+        tile->valid = 1;
+        view->stats.boards_drawn++;
+    }
+
+    if (active) {
+        refresh();
+    }
+    view->stats.frames++;
+}
@@ -0,0 +1,164 @@
+/**
+ * @file spectator.h
+ * @brief Tiled multi-board view for watching many games at once
+ *
+ * Draws a grid of small boards, one tile per game, into the ncurses
+ * screen set up by renderer_init(). Each tile is a labelled box with
+ * the board and the falling piece; the sidebar of the single-game view
+ * is left out.
+ *
+ * The view keeps a shadow copy of every visible board as it is on
+ * screen. A board whose GameState::revision and visible fields did not
+ * change since the last frame is skipped without looking at its cells;
+ * a changed board is compared glyph by glyph and only the differing
+ * glyphs are sent to ncurses. Frame cost therefore follows the number
+ * of changed cells, not the number of boards.
+ *
+ * The packed glyph modes (half blocks, braille) put 2 or 8 cells into
+ * one character; they show shapes only, without piece colors.
+ *
+ * Without an active renderer the view still tracks changes and counts
+ * them, but draws nothing, so it can run headless.
+ *
+ * @author Tetris CLI Project
+ * @version 1.0
+ */
+
+#ifndef SPECTATOR_H
+#define SPECTATOR_H
+
+#include <stddef.h>
+#include "game.h"
+
+/**
+ * @brief Cell glyph modes
+ */
+typedef enum {
+    SPECTATOR_GLYPHS_WIDE,      /**< Two columns per cell, like the game view */
+    SPECTATOR_GLYPHS_COMPACT,   /**< One column per cell */
+    SPECTATOR_GLYPHS_HALF,      /**< Half blocks, 1x2 cells per character */
+    SPECTATOR_GLYPHS_BRAILLE    /**< Braille, 2x4 cells per character */
+} SpectatorGlyphs;
+
+/**
+ * @brief Columns between two tiles
+ */
+#define SPECTATOR_TILE_GAP 1
+
+/**
+ * @brief Drawing counters, cumulative since spectator_create()
+ */
+typedef struct {
+    unsigned long frames;           /**< Calls to spectator_draw() */
+    unsigned long boards_drawn;     /**< Boards that were compared glyph by glyph */
+    unsigned long boards_skipped;   /**< Boards skipped as unchanged */
+    unsigned long glyphs_drawn;     /**< Characters sent to the screen (one per cell
+                                         in wide and compact mode) */
+} SpectatorStats;
+
+/**
+ * @brief Opaque view handle
+ */
+typedef struct SpectatorView SpectatorView;
+
+/**
+ * @brief Creates a view for up to @p capacity boards
+ *
+ * Nothing is visible until spectator_layout() has been called.
+ *
+ * @param capacity Maximum number of boards
+ * @param glyphs Cell glyph mode
+ * @return New view, or NULL if allocation failed
+ */
+SpectatorView *spectator_create(size_t capacity, SpectatorGlyphs glyphs);
+
+/**
+ * @brief Frees the view
+ *
+ * @param view View to destroy (NULL is ignored)
+ */
+void spectator_destroy(SpectatorView *view);
+
+/**
+ * @brief Fits the tile grid into a terminal of the given size
+ *
+ * Tiles are placed row-major; boards that do not fit are not shown.
+ * Forces a full redraw on the next frame.
+ *
+ * @param view Pointer to view
+ * @param cols Terminal width in columns
+ * @param rows Terminal height in rows
+ */
+void spectator_layout(SpectatorView *view, int cols, int rows);
+
+/**
+ * @brief Switches the cell glyph mode and redoes the layout
+ *
+ * @param view Pointer to view
+ * @param glyphs New glyph mode
+ */
+void spectator_set_glyphs(SpectatorView *view, SpectatorGlyphs glyphs);
+
+/**
+ * @brief Gets the screen size of one tile in the current glyph mode
+ *
+ * A tile is the label row, the bordered board and the gap to the next
+ * tile on the right.
+ *
+ * @param view Pointer to view
+ * @param width Output columns including SPECTATOR_TILE_GAP
+ * @param height Output rows
+ */
+void spectator_tile_size(const SpectatorView *view, int *width, int *height);
+
+/**
+ * @brief Gets the number of boards that fit the current layout
+ *
+ * @param view Pointer to view
+ * @return Visible tile count (at most the capacity)
+ */
+size_t spectator_visible(const SpectatorView *view);
+
+/**
+ * @brief Gets the screen position of a tile
+ *
+ * @param view Pointer to view
+ * @param index Tile index
+ * @param x Output column of the tile's top-left corner
+ * @param y Output row of the tile's top-left corner
+ * @return 1 if the tile is visible, 0 otherwise
+ */
+int spectator_tile_origin(const SpectatorView *view, size_t index, int *x, int *y);
+
+/**
+ * @brief Draws one frame
+ *
+ * Board @c i goes to tile @c i; NULL entries show an empty board.
+ * Updates only what changed since the previous frame and refreshes the
+ * screen once.
+ *
+ * @param view Pointer to view
+ * @param games Games to show
+ * @param count Number of entries in @p games
+ */
+void spectator_draw(SpectatorView *view, const GameState *const *games, size_t count);
+
+/**
+ * @brief Forces a full redraw on the next frame
+ *
+ * Needed after something else drew over the screen, or after a board
+ * was modified without going through the game_* functions.
+ *
+ * @param view Pointer to view
+ */
+void spectator_invalidate(SpectatorView *view);
+
+/**
+ * @brief Reads the drawing counters
+ *
+ * @param view Pointer to view
+ * @param stats Output counters
+ */
+void spectator_stats(const SpectatorView *view, SpectatorStats *stats);
+
+#endif /* SPECTATOR_H */
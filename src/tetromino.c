@@ -219,6 +219,17 @@ static const int (*const shape_table[TETRO_COUNT][ROTATION_COUNT])[TETRO_MATRIX_
     [TETRO_L] = { shape_L[0], shape_L[1], shape_L[2], shape_L[3] }
 };
 
+/* The shapes as bit masks per matrix row (bit c = column c) */
+static const unsigned char row_mask_table[TETRO_COUNT][ROTATION_COUNT][TETRO_MATRIX_SIZE] = {
+    [TETRO_I] = { { 0x0, 0xF, 0x0, 0x0 }, { 0x4, 0x4, 0x4, 0x4 }, { 0x0, 0xF, 0x0, 0x0 }, { 0x4, 0x4, 0x4, 0x4 } },
+    [TETRO_O] = { { 0x6, 0x6, 0x0, 0x0 }, { 0x6, 0x6, 0x0, 0x0 }, { 0x6, 0x6, 0x0, 0x0 }, { 0x6, 0x6, 0x0, 0x0 } },
+    [TETRO_T] = { { 0x2, 0x7, 0x0, 0x0 }, { 0x2, 0x6, 0x2, 0x0 }, { 0x0, 0x7, 0x2, 0x0 }, { 0x2, 0x3, 0x2, 0x0 } },
+    [TETRO_S] = { { 0x6, 0x3, 0x0, 0x0 }, { 0x2, 0x6, 0x4, 0x0 }, { 0x6, 0x3, 0x0, 0x0 }, { 0x2, 0x6, 0x4, 0x0 } },
+    [TETRO_Z] = { { 0x3, 0x6, 0x0, 0x0 }, { 0x4, 0x6, 0x2, 0x0 }, { 0x3, 0x6, 0x0, 0x0 }, { 0x4, 0x6, 0x2, 0x0 } },
+    [TETRO_J] = { { 0x1, 0x7, 0x0, 0x0 }, { 0x6, 0x2, 0x2, 0x0 }, { 0x0, 0x7, 0x4, 0x0 }, { 0x2, 0x2, 0x3, 0x0 } },
+    [TETRO_L] = { { 0x4, 0x7, 0x0, 0x0 }, { 0x2, 0x2, 0x6, 0x0 }, { 0x0, 0x7, 0x1, 0x0 }, { 0x3, 0x2, 0x2, 0x0 } }
+};
+
 /* Color table */
 static const int color_table[TETRO_COUNT] = {
     [TETRO_I] = COLOR_I,
@@ -263,6 +274,14 @@ const int (*tetromino_get_shape(TetrominoType type, int rotation))[TETRO_MATRIX_
     return shape_table[type][rotation];
 }
 
+const unsigned char *tetromino_get_row_masks(TetrominoType type, int rotation)
+{
+    if (!tetromino_type_is_valid(type) || !tetromino_rotation_is_valid(rotation)) {
+        return NULL;
+    }
+    return row_mask_table[type][rotation];
+}
+
 int tetromino_get_color(TetrominoType type)
 {
     if (!tetromino_type_is_valid(type)) {
@@ -108,6 +108,18 @@ int tetromino_rotate_counter_clockwise(int rotation);
  */
 const int (*tetromino_get_shape(TetrominoType type, int rotation))[TETRO_MATRIX_SIZE];
 
+/**
+ * @brief Gets the shape as one bit mask per matrix row
+ * 
+ * Bit c of entry r is set where the shape matrix has a 1 at row r,
+ * column c; collision tests shift these onto board row masks.
+ * 
+ * @param type Tetromino type
+ * @param rotation Rotation state (0-3)
+ * @return Pointer to TETRO_MATRIX_SIZE row masks, or NULL if invalid parameters
+ */
+const unsigned char *tetromino_get_row_masks(TetrominoType type, int rotation);
+
 /**
  * @brief Gets the ncurses color pair for a tetromino type
  * 
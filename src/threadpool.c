@@ -0,0 +1,555 @@
+/**
+ * @file threadpool.c
+ * @brief Work-stealing thread pool implementation
+ */
+
+#define _GNU_SOURCE
+
+#include "threadpool.h"
+
+#include <assert.h>
+#include <limits.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+
+/**
+ * @brief Idle rounds (with sched_yield) before a thread goes to sleep
+ */
+#define SPIN_ROUNDS 64
+
+/**
+ * @brief Sleep bound for threads waiting on a group, in nanoseconds
+ */
+#define WAIT_TIMEOUT_NS 1000000L
+
+/**
+ * @brief A queued unit of work
+ */
+typedef struct Task {
+    ThreadPoolFn fn;            /**< Task function */
+    void *arg;                  /**< Argument for fn */
+    ThreadPoolGroup *group;     /**< Group to notify on completion */
+    struct Task *next;          /**< Link in the injection queue */
+} Task;
+
+/**
+ * @brief Chase-Lev work-stealing deque with fixed capacity
+ *
+ * The owner pushes and takes at @c bottom, thieves steal at @c top.
+ * Orderings follow Lê et al., "Correct and Efficient Work-Stealing for
+ * Weak Memory Models" (PPoPP 2013), with the fences folded into
+ * seq_cst accesses.
+ */
+typedef struct {
+    atomic_long top;                                /**< Steal end */
+    atomic_long bottom;                             /**< Owner end */
+    _Atomic(Task *) buffer[THREADPOOL_DEQUE_SIZE];  /**< Circular task slots */
+} Deque;
+
+/**
+ * @brief Per-worker state, padded to its own cache lines
+ */
+typedef struct {
+    _Alignas(64) Deque deque;   /**< Worker's own tasks */
+    pthread_t thread;           /**< Worker thread */
+    ThreadPool *pool;           /**< Owning pool */
+    int index;                  /**< Worker index */
+} Worker;
+
+struct ThreadPool {
+    Worker *workers;                /**< Worker array */
+    int num_workers;                /**< Number of workers */
+    int pin_threads;                /**< Pin workers to CPUs */
+    pthread_mutex_t inject_lock;    /**< Protects the injection queue */
+    Task *inject_head;              /**< Oldest externally submitted task */
+    Task *inject_tail;              /**< Newest externally submitted task */
+    atomic_int inject_count;        /**< Tasks in the injection queue */
+    _Alignas(64) atomic_int epoch;  /**< Futex word bumped on new work */
+    atomic_int sleepers;            /**< Workers sleeping on epoch */
+    atomic_int shutdown;            /**< 1 once destroy started */
+};
+
+/**
+ * @brief Pool and index of the calling worker thread
+ */
+static _Thread_local ThreadPool *tls_pool = NULL;
+static _Thread_local int tls_worker = -1;
+
+/**
+ * @brief Per-thread state for random victim selection
+ */
+static _Thread_local uint32_t tls_rand = 0;
+
+static void futex_wait(atomic_int *word, int expected, long timeout_ns)
+{
+    struct timespec timeout = { 0, timeout_ns };
+    syscall(SYS_futex, (int *)word, FUTEX_WAIT_PRIVATE, expected,
+            timeout_ns > 0 ? &timeout : NULL, NULL, 0);
+}
+
+static void futex_wake(atomic_int *word, int count)
+{
+    syscall(SYS_futex, (int *)word, FUTEX_WAKE_PRIVATE, count, NULL, NULL, 0);
+}
+
+/**
+ * @brief Pushes a task at the bottom (owner only)
+ * @return 1 on success, 0 if the deque is full
+ */
+static int deque_push(Deque *d, Task *task)
+{
+    long b = atomic_load_explicit(&d->bottom, memory_order_relaxed);
+    long t = atomic_load_explicit(&d->top, memory_order_acquire);
+
+    if (b - t >= THREADPOOL_DEQUE_SIZE) {
+        return 0;
+    }
+    atomic_store_explicit(&d->buffer[b & (THREADPOOL_DEQUE_SIZE - 1)], task,
+                          memory_order_relaxed);
+    atomic_store_explicit(&d->bottom, b + 1, memory_order_release);
+    return 1;
+}
+
+/**
+ * @brief Takes the newest task from the bottom (owner only)
+ * @return Task, or NULL if empty or lost the race for the last task
+ */
+static Task *deque_take(Deque *d)
+{
+    long b = atomic_load_explicit(&d->bottom, memory_order_relaxed) - 1;
+    atomic_store_explicit(&d->bottom, b, memory_order_seq_cst);
+    long t = atomic_load_explicit(&d->top, memory_order_seq_cst);
+
+    if (t > b) {
+        atomic_store_explicit(&d->bottom, b + 1, memory_order_relaxed);
+        return NULL;
+    }
+
+    Task *task = atomic_load_explicit(&d->buffer[b & (THREADPOOL_DEQUE_SIZE - 1)],
+                                      memory_order_relaxed);
+    if (t == b) {
+        /* Last task: race against thieves */
+        if (!atomic_compare_exchange_strong_explicit(&d->top, &t, t + 1,
+                                                     memory_order_seq_cst,
+                                                     memory_order_relaxed)) {
+            task = NULL;
+        }
+        atomic_store_explicit(&d->bottom, b + 1, memory_order_relaxed);
+    }
+    return task;
+}
+
+/**
+ * @brief Steals the oldest task from the top (any thread)
+ * @return Task, or NULL if empty or another thread won the race
+ */
+static Task *deque_steal(Deque *d)
+{
+    long t = atomic_load_explicit(&d->top, memory_order_seq_cst);
+    long b = atomic_load_explicit(&d->bottom, memory_order_seq_cst);
+
+    if (t >= b) {
+        return NULL;
+    }
+
+    Task *task = atomic_load_explicit(&d->buffer[t & (THREADPOOL_DEQUE_SIZE - 1)],
+                                      memory_order_relaxed);
+    if (!atomic_compare_exchange_strong_explicit(&d->top, &t, t + 1,
+                                                 memory_order_seq_cst,
+                                                 memory_order_relaxed)) {
+        return NULL;
+    }
+    return task;
+}
+
+static Task *inject_pop(ThreadPool *pool)
+{
+    if (atomic_load_explicit(&pool->inject_count, memory_order_acquire) == 0) {
+        return NULL;
+    }
+
+    pthread_mutex_lock(&pool->inject_lock);
+    Task *task = pool->inject_head;
+    if (task != NULL) {
+        pool->inject_head = task->next;
+        if (pool->inject_head == NULL) {
+            pool->inject_tail = NULL;
+        }
+        atomic_fetch_sub(&pool->inject_count, 1);
+    }
+    pthread_mutex_unlock(&pool->inject_lock);
+    return task;
+}
+
+static void inject_push(ThreadPool *pool, Task *task)
+{
+    task->next = NULL;
+    pthread_mutex_lock(&pool->inject_lock);
+    if (pool->inject_tail != NULL) {
+        pool->inject_tail->next = task;
+    } else {
+        pool->inject_head = task;
+    }
+    pool->inject_tail = task;
+    atomic_fetch_add(&pool->inject_count, 1);
+    pthread_mutex_unlock(&pool->inject_lock);
+}
+
+static uint32_t next_victim_seed(void)
+{
+    if (tls_rand == 0) {
+        tls_rand = (uint32_t)(uintptr_t)&tls_rand | 1u;
+    }
+    tls_rand ^= tls_rand << 13;
+    tls_rand ^= tls_rand >> 17;
+    tls_rand ^= tls_rand << 5;
+    return tls_rand;
+}
+
+/**
+ * @brief Finds work: own deque, then injection queue, then steal
+ *
+ * @param pool Pointer to pool
+ * @param self Index of the calling worker, or -1 for outside threads
+ * @return Task to run, or NULL if none was found
+ */
+static Task *find_task(ThreadPool *pool, int self)
+{
+    Task *task = NULL;
+
+    if (self >= 0) {
+        task = deque_take(&pool->workers[self].deque);
+        if (task != NULL) {
+            return task;
+        }
+    }
+
+    task = inject_pop(pool);
+    if (task != NULL) {
+        return task;
+    }
+
+    int n = pool->num_workers;
+    int start = (int)(next_victim_seed() % (uint32_t)n);
+    for (int i = 0; i < n; i++) {
+        int victim = (start + i) % n;
+        if (victim == self) {
+            continue;
+        }
+        task = deque_steal(&pool->workers[victim].deque);
+        if (task != NULL) {
+            return task;
+        }
+    }
+    return NULL;
+}
+
+static void run_task(Task *task)
+{
+    ThreadPoolGroup *group = task->group;
+    task->fn(task->arg);
+    free(task);
+
+    if (atomic_fetch_sub_explicit(&group->pending, 1, memory_order_acq_rel) == 1) {
+        futex_wake(&group->pending, INT_MAX);
+    }
+}
+
+static void notify_workers(ThreadPool *pool)
+{
+    atomic_fetch_add(&pool->epoch, 1);
+    if (atomic_load(&pool->sleepers) > 0) {
+        futex_wake(&pool->epoch, 1);
+    }
+}
+
+static void pin_to_cpu(int index)
+{
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    if (cpus <= 0) {
+        return;
+    }
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET((int)(index % cpus), &set);
+    pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+}
+
+static void *worker_main(void *arg)
+{
+    Worker *self = arg;
+    ThreadPool *pool = self->pool;
+
+    tls_pool = pool;
+    tls_worker = self->index;
+
+    if (pool->pin_threads) {
+        pin_to_cpu(self->index);
+    }
+
+    int idle = 0;
+    while (!atomic_load(&pool->shutdown)) {
+        Task *task = find_task(pool, self->index);
+        if (task != NULL) {
+            run_task(task);
+            idle = 0;
+            continue;
+        }
+
+        if (++idle < SPIN_ROUNDS) {
+            sched_yield();
+            continue;
+        }
+
+        /* Announce sleep, then re-check so a concurrent spawn is not lost */
+        int epoch = atomic_load(&pool->epoch);
+        atomic_fetch_add(&pool->sleepers, 1);
+        task = find_task(pool, self->index);
+        if (task == NULL && !atomic_load(&pool->shutdown)) {
+            futex_wait(&pool->epoch, epoch, 0);
+        }
+        atomic_fetch_sub(&pool->sleepers, 1);
+
+        if (task != NULL) {
+            run_task(task);
+        }
+        idle = 0;
+    }
+
+    tls_pool = NULL;
+    tls_worker = -1;
+    return NULL;
+}
+
+ThreadPool *threadpool_create(const ThreadPoolConfig *config)
+{
+    int num_threads = (config != NULL) ? config->num_threads : 0;
+    if (num_threads <= 0) {
+        long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        num_threads = (cpus > 0) ? (int)cpus : 1;
+    }
+    if (num_threads > THREADPOOL_MAX_THREADS) {
+        num_threads = THREADPOOL_MAX_THREADS;
+    }
+
+    ThreadPool *pool = calloc(1, sizeof(*pool));
+    if (pool == NULL) {
+        return NULL;
+    }
+
+    pool->workers = aligned_alloc(64, sizeof(Worker) * (size_t)num_threads);
+    if (pool->workers == NULL) {
+        free(pool);
+        return NULL;
+    }
+
+    pool->num_workers = num_threads;
+    pool->pin_threads = (config != NULL) ? config->pin_threads : 0;
+    pthread_mutex_init(&pool->inject_lock, NULL);
+    atomic_init(&pool->inject_count, 0);
+    atomic_init(&pool->epoch, 0);
+    atomic_init(&pool->sleepers, 0);
+    atomic_init(&pool->shutdown, 0);
+
+    for (int i = 0; i < num_threads; i++) {
+        Worker *w = &pool->workers[i];
+        atomic_init(&w->deque.top, 0);
+        atomic_init(&w->deque.bottom, 0);
+        w->pool = pool;
+        w->index = i;
+    }
+
+    for (int i = 0; i < num_threads; i++) {
+        if (pthread_create(&pool->workers[i].thread, NULL, worker_main,
+                           &pool->workers[i]) != 0) {
+            /* Stop the workers that did start */
+            pool->num_workers = i;
+            threadpool_destroy(pool);
+            return NULL;
+        }
+    }
+
+    return pool;
+}
+
+void threadpool_destroy(ThreadPool *pool)
+{
+    if (pool == NULL) {
+        return;
+    }
+
+    atomic_store(&pool->shutdown, 1);
+    atomic_fetch_add(&pool->epoch, 1);
+    futex_wake(&pool->epoch, INT_MAX);
+
+    for (int i = 0; i < pool->num_workers; i++) {
+        pthread_join(pool->workers[i].thread, NULL);
+    }
+
+    /* Discard anything still queued */
+    for (int i = 0; i < pool->num_workers; i++) {
+        Task *task;
+        while ((task = deque_steal(&pool->workers[i].deque)) != NULL) {
+            free(task);
+        }
+    }
+    Task *task;
+    while ((task = inject_pop(pool)) != NULL) {
+        free(task);
+    }
+
+    pthread_mutex_destroy(&pool->inject_lock);
+    free(pool->workers);
+    free(pool);
+}
+
+int threadpool_size(const ThreadPool *pool)
+{
+    assert(pool != NULL);
+    return pool->num_workers;
+}
+
+int threadpool_current_worker(void)
+{
+    return tls_worker;
+}
+
+void threadpool_group_init(ThreadPoolGroup *group)
+{
+    assert(group != NULL);
+    atomic_init(&group->pending, 0);
+}
+
+int threadpool_spawn(ThreadPool *pool, ThreadPoolGroup *group,
+                     ThreadPoolFn fn, void *arg)
+{
+    assert(pool != NULL);
+    assert(group != NULL);
+    assert(fn != NULL);
+
+    Task *task = malloc(sizeof(*task));
+    if (task == NULL) {
+        return 0;
+    }
+    task->fn = fn;
+    task->arg = arg;
+    task->group = group;
+    task->next = NULL;
+    atomic_fetch_add_explicit(&group->pending, 1, memory_order_relaxed);
+
+    if (tls_pool == pool) {
+        if (!deque_push(&pool->workers[tls_worker].deque, task)) {
+            /* Deque full: running inline keeps memory bounded */
+            run_task(task);
+            return 1;
+        }
+    } else {
+        inject_push(pool, task);
+    }
+
+    notify_workers(pool);
+    return 1;
+}
+
+void threadpool_wait(ThreadPool *pool, ThreadPoolGroup *group)
+{
+    assert(pool != NULL);
+    assert(group != NULL);
+
+    int self = (tls_pool == pool) ? tls_worker : -1;
+    int idle = 0;
+
+    for (;;) {
+        int pending = atomic_load_explicit(&group->pending, memory_order_acquire);
+        if (pending == 0) {
+            return;
+        }
+
+        Task *task = find_task(pool, self);
+        if (task != NULL) {
+            run_task(task);
+            idle = 0;
+            continue;
+        }
+
+        if (++idle < SPIN_ROUNDS) {
+            sched_yield();
+            continue;
+        }
+
+        /* Bounded sleep: new stealable work does not wake group waiters */
+        futex_wait(&group->pending, pending, WAIT_TIMEOUT_NS);
+    }
+}
+
+/**
+ * @brief Sub-range handed to a parallel_for task
+ */
+typedef struct {
+    ThreadPool *pool;
+    ThreadPoolGroup *group;
+    ThreadPoolRangeFn fn;
+    void *ctx;
+    size_t begin;
+    size_t end;
+    size_t grain;
+} RangeTask;
+
+static void range_task_run(void *arg);
+
+/**
+ * @brief Splits a range, spawning right halves, and runs the rest
+ */
+static void run_range(ThreadPool *pool, ThreadPoolGroup *group,
+                      ThreadPoolRangeFn fn, void *ctx,
+                      size_t begin, size_t end, size_t grain)
+{
+    while (end - begin > grain) {
+        size_t mid = begin + (end - begin) / 2;
+
+        RangeTask *right = malloc(sizeof(*right));
+        if (right == NULL) {
+            break;
+        }
+        *right = (RangeTask){ pool, group, fn, ctx, mid, end, grain };
+        if (!threadpool_spawn(pool, group, range_task_run, right)) {
+            free(right);
+            break;
+        }
+        end = mid;
+    }
+    fn(ctx, begin, end);
+}
+
+static void range_task_run(void *arg)
+{
+    RangeTask range = *(RangeTask *)arg;
+    free(arg);
+    run_range(range.pool, range.group, range.fn, range.ctx,
+              range.begin, range.end, range.grain);
+}
+
+void threadpool_parallel_for(ThreadPool *pool, size_t count, size_t grain,
+                             ThreadPoolRangeFn fn, void *ctx)
+{
+    assert(pool != NULL);
+    assert(fn != NULL);
+
+    if (count == 0) {
+        return;
+    }
+    if (grain == 0) {
+        grain = 1;
+    }
+
+    ThreadPoolGroup group;
+    threadpool_group_init(&group);
+    run_range(pool, &group, fn, ctx, 0, count, grain);
+    threadpool_wait(pool, &group);
+}
@@ -0,0 +1,159 @@
+/**
+ * @file threadpool.h
+ * @brief Work-stealing thread pool for parallel tools
+ *
+ * One shared task scheduler for batch simulation, bot search and
+ * replay verification. Each worker owns a Chase-Lev deque: it pushes
+ * and pops tasks at the bottom (LIFO, cache-warm) while idle workers
+ * steal from the top (FIFO, oldest and usually largest tasks).
+ * Tasks submitted from threads outside the pool go through a shared
+ * injection queue. Idle workers spin briefly, then sleep on a futex
+ * until new work is submitted.
+ *
+ * Fork/join is expressed with task groups: spawn any number of tasks
+ * into a group and wait for it. A waiting thread executes pending
+ * tasks itself instead of blocking, so nested fork/join inside tasks
+ * does not starve the pool.
+ *
+ * @author Tetris CLI Project
+ * @version 1.0
+ */
+
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <stddef.h>
+#include <stdatomic.h>
+
+/**
+ * @brief Capacity of each worker's deque (power of two)
+ *
+ * When a worker's deque is full, spawn runs the task inline.
+ */
+#define THREADPOOL_DEQUE_SIZE 1024
+
+/**
+ * @brief Upper bound for the number of workers
+ */
+#define THREADPOOL_MAX_THREADS 64
+
+/**
+ * @brief Task function
+ * @param arg User argument passed to threadpool_spawn()
+ */
+typedef void (*ThreadPoolFn)(void *arg);
+
+/**
+ * @brief Range function for threadpool_parallel_for()
+ * @param ctx User context
+ * @param begin First index of the chunk
+ * @param end One past the last index of the chunk
+ */
+typedef void (*ThreadPoolRangeFn)(void *ctx, size_t begin, size_t end);
+
+/**
+ * @brief Pool configuration
+ */
+typedef struct {
+    int num_threads;    /**< Worker count, 0 = number of online CPUs */
+    int pin_threads;    /**< 1 = pin worker i to CPU i (mod CPU count) */
+} ThreadPoolConfig;
+
+/**
+ * @brief Opaque pool handle
+ */
+typedef struct ThreadPool ThreadPool;
+
+/**
+ * @brief Group of tasks that can be waited for together
+ *
+ * Initialize with threadpool_group_init() before the first spawn.
+ * A group may be reused after threadpool_wait() returned.
+ */
+typedef struct {
+    atomic_int pending;     /**< Number of spawned, unfinished tasks */
+} ThreadPoolGroup;
+
+/**
+ * @brief Creates a pool and starts its workers
+ *
+ * @param config Configuration, or NULL for defaults (all CPUs, no pinning)
+ * @return New pool, or NULL if allocation or thread creation failed
+ */
+ThreadPool *threadpool_create(const ThreadPoolConfig *config);
+
+/**
+ * @brief Stops all workers and frees the pool
+ *
+ * All groups must have been waited for; tasks still queued are
+ * discarded without running.
+ *
+ * @param pool Pool to destroy (NULL is ignored)
+ */
+void threadpool_destroy(ThreadPool *pool);
+
+/**
+ * @brief Gets the number of workers
+ *
+ * @param pool Pointer to pool
+ * @return Number of worker threads
+ */
+int threadpool_size(const ThreadPool *pool);
+
+/**
+ * @brief Gets the index of the calling worker
+ *
+ * @return Worker index (0 to size-1), or -1 if called from outside a pool
+ */
+int threadpool_current_worker(void);
+
+/**
+ * @brief Initializes a task group
+ *
+ * @param group Pointer to group
+ */
+void threadpool_group_init(ThreadPoolGroup *group);
+
+/**
+ * @brief Submits a task to the pool
+ *
+ * Called from a worker, the task goes onto that worker's own deque;
+ * from any other thread it goes to the injection queue.
+ *
+ * @param pool Pointer to pool
+ * @param group Group the task belongs to
+ * @param fn Task function
+ * @param arg Argument for @p fn
+ * @return 1 if the task was queued or run inline, 0 if allocation failed
+ */
+int threadpool_spawn(ThreadPool *pool, ThreadPoolGroup *group,
+                     ThreadPoolFn fn, void *arg);
+
+/**
+ * @brief Waits until all tasks of a group have finished
+ *
+ * The calling thread runs pending tasks while it waits and only
+ * sleeps when there is nothing left to steal.
+ *
+ * @param pool Pointer to pool
+ * @param group Group to wait for
+ */
+void threadpool_wait(ThreadPool *pool, ThreadPoolGroup *group);
+
+/**
+ * @brief Runs @p fn over [0, count) in parallel chunks
+ *
+ * The range is split recursively until chunks are at most @p grain
+ * indices long; halves are spawned so idle workers can steal them.
+ * Returns when the whole range has been processed.
+ *
+ * @param pool Pointer to pool
+ * @param count Number of indices
+ * @param grain Maximum chunk size (0 is treated as 1)
+ * @param fn Range function
+ * @param ctx User context passed to @p fn
+ */
+void threadpool_parallel_for(ThreadPool *pool, size_t count, size_t grain,
+                             ThreadPoolRangeFn fn, void *ctx);
+
+#endif /* THREADPOOL_H */
@@ -0,0 +1,270 @@
+/**
+ * @file test_book.c
+ * @brief Unit tests for the opening book
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "minunit.h"
+#include "../src/book.h"
+#include "../src/canon.h"
+
+#define MANY_POSITIONS 5000
+
+static char path[64];
+
+/* Helper: Per-process book file */
+static const char *book_path(void)
+{
+    snprintf(path, sizeof(path), "/tmp/tetris_book_%d.bin", (int)getpid());
+    return path;
+}
+
+/* Helper: Seeded game with a lopsided stack and the given queue */
+static void make_position(GameState *game, unsigned int seed, TetrominoType current)
+{
+    game_init_seeded(game, seed);
+    for (int y = BOARD_HEIGHT - 3; y < BOARD_HEIGHT; y++) {
+        for (int x = 0; x < BOARD_WIDTH; x++) {
+            seed = seed * 1103515245u + 12345u;
+            game->board.cells[y][x] = x < 6 && (seed >> 16) % 4 != 0 ? COLOR_I : 0;
+        }
+    }
+    game_board_sync(&game->board);
+    game->current = tetromino_create(current);
+}
+
+/* Test: Recorded placements come back for their positions */
+mu_test(test_write_and_lookup)
+{
+    static GameState a, b;
+    make_position(&a, 1, TETRO_T);
+    make_position(&b, 2, TETRO_I);
+    Placement pa = { 4, 10, 2 };
+    Placement pb = { 0, 12, 1 };
+
+    BookBuilder *builder = book_builder_create();
+    mu_assert("builder created", builder != NULL);
+    mu_assert("add a", book_builder_add(builder, &a, &pa));
+    mu_assert("add b", book_builder_add(builder, &b, &pb));
+    mu_assert_eq_int(2, (int)book_builder_write(builder, book_path()));
+    book_builder_destroy(builder);
+
+    OpeningBook *book = book_open(path);
+    mu_assert("book opened", book != NULL);
+    mu_assert_eq_int(2, (int)book_size(book));
+
+    Placement out;
+    mu_assert("a found", book_lookup(book, &a, &out));
+    mu_assert("a placement", out.x == 4 && out.y == 10 && out.rotation == 2);
+    mu_assert("b found", book_lookup(book, &b, &out));
+    mu_assert("b placement", out.x == 0 && out.y == 12 && out.rotation == 1);
+
+    book_close(book);
+    unlink(path);
+}
+
+/* Test: The queue is part of the key */
+mu_test(test_queue_in_key)
+{
+    static GameState game, other;
+    make_position(&game, 3, TETRO_L);
+    other = game;
+    other.next = tetromino_create(game.next.type == TETRO_O ? TETRO_I : TETRO_O);
+    mu_assert("next changes key", book_key(&game, NULL) != book_key(&other, NULL));
+    other = game;
+    other.hold = TETRO_S;
+    mu_assert("hold changes key", book_key(&game, NULL) != book_key(&other, NULL));
+    other = game;
+    other.current = tetromino_create(TETRO_J);
+    mu_assert("current changes key", book_key(&game, NULL) != book_key(&other, NULL));
+}
+
+/* Test: The mirror image of a recorded position finds the mirrored move */
+mu_test(test_mirrored_lookup)
+{
+    static GameState game, mirror;
+    make_position(&game, 4, TETRO_J);
+    game.next = tetromino_create(TETRO_S);
+    game.hold = TETRO_Z;
+    Placement placement = { 6, 14, 1 };
+
+    BookBuilder *builder = book_builder_create();
+    book_builder_add(builder, &game, &placement);
+    book_builder_write(builder, book_path());
+    book_builder_destroy(builder);
+
+    canon_mirror_board(&game.board, &mirror.board);
+    mirror.current = tetromino_create(TETRO_L);
+    mirror.next = tetromino_create(TETRO_Z);
+    mirror.hold = TETRO_S;
+    int flipped_game, flipped_mirror;
+    mu_assert("same key", book_key(&game, &flipped_game) == book_key(&mirror, &flipped_mirror));
+    mu_assert("exactly one side mirrored", flipped_game != flipped_mirror);
+
+    OpeningBook *book = book_open(path);
+    Placement out;
+    mu_assert("mirror found", book_lookup(book, &mirror, &out));
+    Tetromino expected = canon_mirror_piece(&(Tetromino){ TETRO_J, 6, 14, 1 });
+    mu_assert_eq_int(expected.x, out.x);
+    mu_assert_eq_int(expected.y, out.y);
+    mu_assert_eq_int(expected.rotation, out.rotation);
+    mu_assert("original found", book_lookup(book, &game, &out));
+    mu_assert("original placement", out.x == 6 && out.y == 14 && out.rotation == 1);
+
+    book_close(book);
+    unlink(path);
+}
+
+/* Test: Unknown positions miss; duplicates keep the first placement */
+mu_test(test_missing_and_duplicates)
+{
+    static GameState game, unknown;
+    make_position(&game, 5, TETRO_O);
+    make_position(&unknown, 6, TETRO_O);
+    Placement first = { 2, 15, 0 };
+    Placement second = { 7, 15, 0 };
+
+    BookBuilder *builder = book_builder_create();
+    book_builder_add(builder, &game, &first);
+    book_builder_add(builder, &game, &second);
+    mu_assert_eq_int(1, (int)book_builder_write(builder, book_path()));
+    book_builder_destroy(builder);
+
+    OpeningBook *book = book_open(path);
+    Placement out;
+    mu_assert("unknown misses", !book_lookup(book, &unknown, &out));
+    mu_assert("known hits", book_lookup(book, &game, &out));
+    mu_assert_eq_int(2, out.x);
+
+    book_close(book);
+    unlink(path);
+}
+
+/* Test: The first placement survives many duplicates mixed with other keys */
+mu_test(test_first_duplicate_wins)
+{
+    static GameState game, other;
+    make_position(&game, 9, TETRO_L);
+    Placement first = { 1, 15, 3 };
+
+    BookBuilder *builder = book_builder_create();
+    mu_assert("add first", book_builder_add(builder, &game, &first));
+    for (int i = 1; i < MANY_POSITIONS; i++) {
+        make_position(&other, 200000u + (unsigned int)i, (TetrominoType)(i % TETRO_COUNT));
+        Placement filler = { (signed char)(i % 8), 10, (signed char)(i % 3) };
+        Placement later = { (signed char)(2 + i % 6), 14, (signed char)(i % 3) };
+        mu_assert("add other", book_builder_add(builder, &other, &filler));
+        mu_assert("add duplicate", book_builder_add(builder, &game, &later));
+    }
+    long written = book_builder_write(builder, book_path());
+    book_builder_destroy(builder);
+    mu_assert("duplicates collapsed", written > 0 && written <= MANY_POSITIONS);
+
+    OpeningBook *book = book_open(path);
+    Placement out;
+    mu_assert("position found", book_lookup(book, &game, &out));
+    mu_assert("first placement kept", out.x == 1 && out.y == 15 && out.rotation == 3);
+    book_close(book);
+    unlink(path);
+}
+
+/* Test: An empty book opens and misses everything */
+mu_test(test_empty_book)
+{
+    static GameState game;
+    make_position(&game, 7, TETRO_T);
+
+    BookBuilder *builder = book_builder_create();
+    mu_assert_eq_int(0, (int)book_builder_write(builder, book_path()));
+    book_builder_destroy(builder);
+
+    OpeningBook *book = book_open(path);
+    mu_assert("empty book opened", book != NULL);
+    mu_assert_eq_int(0, (int)book_size(book));
+    Placement out;
+    mu_assert("empty book misses", !book_lookup(book, &game, &out));
+    book_close(book);
+    unlink(path);
+}
+
+/* Test: Files that are not books are rejected */
+mu_test(test_rejects_bad_files)
+{
+    mu_assert("missing file", book_open("/nonexistent/tetris.book") == NULL);
+
+    FILE *file = fopen(book_path(), "wb");
+    fputs("NOTABOOK and some more bytes to fill a header", file);
+    fclose(file);
+    mu_assert("bad magic", book_open(path) == NULL);
+
+    /* A valid book cut off in the middle of an entry */
+    static GameState game;
+    make_position(&game, 8, TETRO_T);
+    BookBuilder *builder = book_builder_create();
+    book_builder_add(builder, &game, &(Placement){ 3, 15, 0 });
+    book_builder_write(builder, path);
+    book_builder_destroy(builder);
+    mu_assert("truncated", truncate(path, 24 + 8) == 0);
+    mu_assert("truncated book rejected", book_open(path) == NULL);
+    unlink(path);
+}
+
+/* Test: Interpolation search finds every key of a large book */
+mu_test(test_many_positions)
+{
+    static GameState game;
+    BookBuilder *builder = book_builder_create();
+    for (int i = 0; i < MANY_POSITIONS; i++) {
+        make_position(&game, 100u + (unsigned int)i, (TetrominoType)(i % TETRO_COUNT));
+        Placement placement = { (signed char)(i % 8), (signed char)(i % 16), (signed char)(i % 4) };
+        mu_assert("add", book_builder_add(builder, &game, &placement));
+    }
+    long written = book_builder_write(builder, book_path());
+    book_builder_destroy(builder);
+    mu_assert("most positions distinct", written > MANY_POSITIONS * 9 / 10);
+
+    OpeningBook *book = book_open(path);
+    int found = 0;
+    for (int i = 0; i < MANY_POSITIONS; i++) {
+        make_position(&game, 100u + (unsigned int)i, (TetrominoType)(i % TETRO_COUNT));
+        Placement out;
+        found += book_lookup(book, &game, &out);
+        make_position(&game, 100000u + (unsigned int)i, TETRO_I);
+        game.hold = TETRO_T;
+        mu_assert("absent position misses", !book_lookup(book, &game, &out));
+    }
+    mu_assert_eq_int(MANY_POSITIONS, found);
+
+    book_close(book);
+    unlink(path);
+}
+
+static void run_all_tests(void)
+{
+    printf("\nRunning Opening Book Module Tests...\n");
+    printf("====================================\n\n");
+
+    mu_run_test(test_write_and_lookup);
+    mu_run_test(test_queue_in_key);
+    mu_run_test(test_mirrored_lookup);
+    mu_run_test(test_missing_and_duplicates);
+    mu_run_test(test_first_duplicate_wins);
+    mu_run_test(test_empty_book);
+    mu_run_test(test_rejects_bad_files);
+    mu_run_test(test_many_positions);
+}
+
+int main(void)
+{
+    run_all_tests();
+    mu_print_summary();
+
+    if (mu_tests_failed == 0) {
+        printf("\nAll tests passed!\n");
+    }
+
+    return mu_return_status();
+}
@@ -0,0 +1,219 @@
+/**
+ * @file test_canon.c
+ * @brief Unit tests for mirror canonicalization
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "minunit.h"
+#include "../src/canon.h"
+
+/* Board cells of a piece as (x, y) pairs */
+static int piece_cells(const Tetromino *t, int cells[4][2])
+{
+    const unsigned char *masks = tetromino_get_row_masks(t->type, t->rotation);
+    int count = 0;
+    for (int row = 0; row < TETRO_MATRIX_SIZE; row++) {
+        for (int col = 0; col < TETRO_MATRIX_SIZE; col++) {
+            if (masks[row] & (1u << col)) {
+                cells[count][0] = t->x + col;
+                cells[count][1] = t->y + row;
+                count++;
+            }
+        }
+    }
+    return count;
+}
+
+static int has_cell(int cells[4][2], int x, int y)
+{
+    for (int i = 0; i < 4; i++) {
+        if (cells[i][0] == x && cells[i][1] == y) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/* Random rubble without any symmetry */
+static void fill_random(Board *board, unsigned int seed)
+{
+    for (int y = 0; y < BOARD_HEIGHT; y++) {
+        for (int x = 0; x < BOARD_WIDTH; x++) {
+            seed = seed * 1103515245u + 12345u;
+            board->cells[y][x] = y > 8 && (seed >> 16) % 3 != 0 ? (int)((seed >> 20) % 7) + 1 : 0;
+        }
+    }
+    game_board_sync(board);
+}
+
+/* Test: Types and colors swap in pairs */
+mu_test(test_mirror_types)
+{
+    mu_assert_eq_int(TETRO_Z, canon_mirror_type(TETRO_S));
+    mu_assert_eq_int(TETRO_S, canon_mirror_type(TETRO_Z));
+    mu_assert_eq_int(TETRO_L, canon_mirror_type(TETRO_J));
+    mu_assert_eq_int(TETRO_J, canon_mirror_type(TETRO_L));
+    mu_assert_eq_int(TETRO_T, canon_mirror_type(TETRO_T));
+    mu_assert_eq_int(0, canon_mirror_color(0));
+    for (int type = 0; type < TETRO_COUNT; type++) {
+        mu_assert_eq_int(tetromino_get_color(canon_mirror_type((TetrominoType)type)),
+                         canon_mirror_color(tetromino_get_color((TetrominoType)type)));
+    }
+}
+
+/* Test: Row reversal for every pattern */
+mu_test(test_mirror_rows)
+{
+    for (unsigned int pattern = 0; pattern < (1u << BOARD_WIDTH); pattern++) {
+        unsigned int expected = 0;
+        for (int x = 0; x < BOARD_WIDTH; x++) {
+            expected |= ((pattern >> x) & 1u) << (BOARD_WIDTH - 1 - x);
+        }
+        mu_assert_eq_int((int)expected, (int)canon_mirror_row(pattern));
+    }
+}
+
+/* Test: Mirrored pieces cover the mirrored cells */
+mu_test(test_mirror_pieces)
+{
+    GameState game;
+    game_init_seeded(&game, 1);
+
+    for (int type = 0; type < TETRO_COUNT; type++) {
+        for (int rotation = 0; rotation < ROTATION_COUNT; rotation++) {
+            for (int x = -BOARD_PAD; x < BOARD_WIDTH; x++) {
+                Tetromino t = { (TetrominoType)type, x, 5, rotation };
+                if (!game_is_valid_position(&game, &t)) {
+                    continue;
+                }
+                Tetromino m = canon_mirror_piece(&t);
+                mu_assert("Mirror must be valid", game_is_valid_position(&game, &m));
+
+                int cells[4][2], mirrored[4][2];
+                piece_cells(&t, cells);
+                piece_cells(&m, mirrored);
+                for (int i = 0; i < 4; i++) {
+                    mu_assert("Cells must mirror",
+                              has_cell(mirrored, BOARD_WIDTH - 1 - cells[i][0], cells[i][1]));
+                }
+
+                Tetromino back = canon_mirror_piece(&m);
+                int again[4][2];
+                piece_cells(&back, again);
+                for (int i = 0; i < 4; i++) {
+                    mu_assert("Mirroring twice restores the cells",
+                              has_cell(again, cells[i][0], cells[i][1]));
+                }
+            }
+        }
+    }
+}
+
+/* Test: Mirrored boards swap colors, reverse heights and mirror back */
+mu_test(test_mirror_board)
+{
+    static Board board, mirrored, back;
+    fill_random(&board, 97);
+    canon_mirror_board(&board, &mirrored);
+    canon_mirror_board(&mirrored, &back);
+
+    mu_assert("Mirroring twice restores the board",
+              memcmp(board.cells, back.cells, sizeof(board.cells)) == 0);
+    for (int x = 0; x < BOARD_WIDTH; x++) {
+        mu_assert_eq_int(board.features.heights[x],
+                         mirrored.features.heights[BOARD_WIDTH - 1 - x]);
+        mu_assert_eq_int(canon_mirror_color(board.cells[BOARD_HEIGHT - 1][x]),
+                         mirrored.cells[BOARD_HEIGHT - 1][BOARD_WIDTH - 1 - x]);
+    }
+    mu_assert_eq_int(board.features.holes, mirrored.features.holes);
+}
+
+/* Test: Exactly one orientation of an asymmetric board is canonical */
+mu_test(test_board_order)
+{
+    static Board board, mirrored;
+    fill_random(&board, 5);
+    canon_mirror_board(&board, &mirrored);
+
+    mu_assert("Orders must be opposite",
+              canon_board_order(&board) == -canon_board_order(&mirrored));
+    mu_assert("Random rubble is not symmetric", canon_board_order(&board) != 0);
+
+    memset(board.cells, 0, sizeof(board.cells));
+    board.cells[BOARD_HEIGHT - 1][0] = 1;
+    board.cells[BOARD_HEIGHT - 1][9] = 1;
+    game_board_sync(&board);
+    mu_assert_eq_int(0, canon_board_order(&board));
+}
+
+/* Test: A state and its mirror canonicalize to the same position */
+mu_test(test_canon_state)
+{
+    static GameState game, mirrored, a, b;
+    game_init_seeded(&game, 7);
+    fill_random(&game.board, 11);
+    game.current = tetromino_create(TETRO_S);
+    game.next = tetromino_create(TETRO_J);
+    game.hold = TETRO_T;
+    game.bag = (1u << TETRO_S) | (1u << TETRO_J) | (1u << TETRO_I);
+
+    mirrored = game;
+    canon_mirror_board(&game.board, &mirrored.board);
+    mirrored.current = canon_mirror_piece(&game.current);
+    mirrored.next = tetromino_create(TETRO_L);
+    mirrored.bag = (1u << TETRO_Z) | (1u << TETRO_L) | (1u << TETRO_I);
+
+    int flipped_a = canon_state(&game, &a);
+    int flipped_b = canon_state(&mirrored, &b);
+    mu_assert("Exactly one of the two is mirrored", flipped_a != flipped_b);
+    mu_assert("Boards must match", memcmp(a.board.cells, b.board.cells, sizeof(a.board.cells)) == 0);
+    mu_assert_eq_int(a.current.type, b.current.type);
+    mu_assert_eq_int(a.current.x, b.current.x);
+    mu_assert_eq_int(a.current.rotation, b.current.rotation);
+    mu_assert_eq_int(a.next.type, b.next.type);
+    mu_assert_eq_int(a.hold, b.hold);
+    mu_assert_eq_int((int)a.bag, (int)b.bag);
+}
+
+/* Test: On a symmetric board the piece types pick the orientation */
+mu_test(test_canon_state_symmetric)
+{
+    static GameState game, out;
+    game_init_seeded(&game, 1);
+    game.current = tetromino_create(TETRO_Z);
+    game.next = tetromino_create(TETRO_O);
+    game.hold = TETRO_COUNT;
+
+    /* S sorts before Z, so the mirror is canonical */
+    mu_assert_eq_int(1, canon_state(&game, &out));
+    mu_assert_eq_int(TETRO_S, out.current.type);
+    mu_assert_eq_int(TETRO_COUNT, out.hold);
+    mu_assert_eq_int(0, canon_state(&out, &game));
+}
+
+static void run_all_tests(void)
+{
+    printf("\nRunning Canonicalization Module Tests...\n");
+    printf("========================================\n\n");
+
+    mu_run_test(test_mirror_types);
+    mu_run_test(test_mirror_rows);
+    mu_run_test(test_mirror_pieces);
+    mu_run_test(test_mirror_board);
+    mu_run_test(test_board_order);
+    mu_run_test(test_canon_state);
+    mu_run_test(test_canon_state_symmetric);
+}
+
+int main(void)
+{
+    run_all_tests();
+    mu_print_summary();
+
+    if (mu_tests_failed == 0) {
+        printf("\nAll tests passed!\n");
+    }
+
+    return mu_return_status();
+}
@@ -0,0 +1,383 @@
+/**
+ * @file test_coro.c
+ * @brief Unit tests for the coroutine scheduler
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "minunit.h"
+#include "../src/coro.h"
+#include "../src/game.h"
+#include "../src/input.h"
+
+/* Shared log for ordering tests */
+static char order_log[64];
+static size_t order_len;
+
+/* Helper: Appends its letter three times, yielding in between */
+static void yielding_body(void *arg)
+{
+    for (int i = 0; i < 3; i++) {
+        order_log[order_len++] = *(const char *)arg;
+        coro_yield();
+    }
+}
+
+/* Helper: Sleeps for the given number of milliseconds, then logs */
+typedef struct {
+    char letter;
+    uint64_t sleep_ms;
+} SleepArgs;
+
+static void sleeping_body(void *arg)
+{
+    SleepArgs *args = arg;
+    coro_sleep_ns(args->sleep_ms * 1000000ULL);
+    order_log[order_len++] = args->letter;
+}
+
+/* Helper: Parks and records how the park ended */
+typedef struct {
+    uint64_t deadline;
+    int result;
+    int done;
+} ParkArgs;
+
+static void parking_body(void *arg)
+{
+    ParkArgs *args = arg;
+    args->result = coro_park_until(args->deadline);
+    args->done = 1;
+}
+
+/* Helper: Records whether coro_current() is set inside a coroutine */
+static void current_body(void *arg)
+{
+    *(Coro **)arg = coro_current();
+}
+
+/* Helper: Counts to ten with a yield per step */
+static void counting_body(void *arg)
+{
+    for (int i = 0; i < 10; i++) {
+        (*(long *)arg)++;
+        coro_yield();
+    }
+}
+
+/* Helper: Recursion that touches a few kilobytes of stack per level */
+static int deep_recursion(int depth)
+{
+    volatile char frame[512];
+    frame[0] = (char)depth;
+    if (depth == 0) {
+        return frame[0];
+    }
+    return deep_recursion(depth - 1) + 1 + frame[0] - (char)depth;
+}
+
+static void deep_body(void *arg)
+{
+    *(int *)arg = deep_recursion(64);
+}
+
+/* Helper: Spawns a child coroutine from inside a coroutine */
+typedef struct {
+    CoroScheduler *sched;
+    int children;
+} SpawnArgs;
+
+static void child_body(void *arg)
+{
+    ((SpawnArgs *)arg)->children++;
+}
+
+static void parent_body(void *arg)
+{
+    SpawnArgs *args = arg;
+    coro_spawn(args->sched, child_body, args);
+}
+
+/* Helper: Headless session waiting on input or its gravity timer */
+typedef struct {
+    GameState game;
+    InputAction inbox;      /* Delivered action, INPUT_NONE if empty */
+    int inputs;             /* Actions applied */
+    int steps;              /* Gravity steps taken */
+    Coro *coro;
+} MuxSession;
+
+static void session_body(void *arg)
+{
+    MuxSession *session = arg;
+    while (session->steps < 5 && session->game.is_running) {
+        if (coro_park_until(coro_now_ns() + 2000000ULL)) {
+            if (session->inbox == INPUT_HARD_DROP) {
+                game_hard_drop(&session->game);
+            } else if (session->inbox == INPUT_LEFT) {
+                game_move_current(&session->game, -1, 0);
+            }
+            session->inbox = INPUT_NONE;
+            session->inputs++;
+        } else {
+            game_step(&session->game);
+            session->steps++;
+        }
+    }
+}
+
+/* Test: Scheduler creation */
+mu_test(test_scheduler_create_destroy)
+{
+    CoroScheduler *sched = coro_scheduler_create(0);
+
+    mu_assert_not_null(sched);
+    mu_assert_eq_int(0, (int)coro_scheduler_live(sched));
+    coro_scheduler_destroy(sched);
+    coro_scheduler_destroy(NULL);
+}
+
+/* Test: Yielding coroutines interleave round-robin */
+mu_test(test_yield_round_robin)
+{
+    CoroScheduler *sched = coro_scheduler_create(0);
+    order_len = 0;
+
+    coro_spawn(sched, yielding_body, "A");
+    coro_spawn(sched, yielding_body, "B");
+    mu_assert_eq_int(2, (int)coro_scheduler_live(sched));
+    coro_scheduler_run(sched);
+
+    order_log[order_len] = '\0';
+    mu_assert("Coroutines must alternate", strcmp(order_log, "ABABAB") == 0);
+    mu_assert_eq_int(0, (int)coro_scheduler_live(sched));
+    coro_scheduler_destroy(sched);
+}
+
+/* Test: coro_current() is only set inside a coroutine */
+mu_test(test_current)
+{
+    CoroScheduler *sched = coro_scheduler_create(0);
+    Coro *seen = NULL;
+
+    mu_assert_null(coro_current());
+    Coro *coro = coro_spawn(sched, current_body, &seen);
+    coro_scheduler_run(sched);
+
+    mu_assert("Inside, current must be the coroutine", seen == coro);
+    mu_assert_null(coro_current());
+    coro_scheduler_destroy(sched);
+}
+
+/* Test: Sleepers wake in deadline order */
+mu_test(test_sleep_order)
+{
+    CoroScheduler *sched = coro_scheduler_create(0);
+    SleepArgs c = { 'C', 15 }, a = { 'A', 1 }, b = { 'B', 8 };
+    order_len = 0;
+
+    coro_spawn(sched, sleeping_body, &c);
+    coro_spawn(sched, sleeping_body, &a);
+    coro_spawn(sched, sleeping_body, &b);
+    coro_scheduler_run(sched);
+
+    order_log[order_len] = '\0';
+    mu_assert("Sleepers must finish by deadline", strcmp(order_log, "ABC") == 0);
+    coro_scheduler_destroy(sched);
+}
+
+/* Test: Park without deadline returns 1 after coro_wake() */
+mu_test(test_park_wake)
+{
+    CoroScheduler *sched = coro_scheduler_create(0);
+    ParkArgs args = { CORO_NO_DEADLINE, -1, 0 };
+
+    Coro *coro = coro_spawn(sched, parking_body, &args);
+    coro_scheduler_run(sched);
+    mu_assert_eq_int(0, args.done);
+    mu_assert_eq_int(1, (int)coro_scheduler_live(sched));
+
+    mu_assert_eq_int(1, coro_wake(coro));
+    mu_assert_eq_int(0, coro_wake(coro));
+    coro_scheduler_run(sched);
+
+    mu_assert_eq_int(1, args.done);
+    mu_assert_eq_int(1, args.result);
+    coro_scheduler_destroy(sched);
+}
+
+/* Test: Park with a passed deadline returns 0 */
+mu_test(test_park_timeout)
+{
+    CoroScheduler *sched = coro_scheduler_create(0);
+    ParkArgs args = { 0, -1, 0 };
+
+    args.deadline = coro_now_ns() + 1000000ULL;
+    coro_spawn(sched, parking_body, &args);
+    coro_scheduler_run(sched);
+
+    mu_assert_eq_int(1, args.done);
+    mu_assert_eq_int(0, args.result);
+    coro_scheduler_destroy(sched);
+}
+
+/* Test: Waking removes the pending timer */
+mu_test(test_wake_cancels_timer)
+{
+    CoroScheduler *sched = coro_scheduler_create(0);
+    ParkArgs args = { 0, -1, 0 };
+
+    /* Far deadline: run() would sleep for an hour if the timer stayed */
+    args.deadline = coro_now_ns() + 3600ULL * 1000000000ULL;
+    Coro *coro = coro_spawn(sched, parking_body, &args);
+    coro_scheduler_poll(sched);
+    mu_assert_eq_int(1, coro_wake(coro));
+
+    uint64_t start = coro_now_ns();
+    coro_scheduler_run(sched);
+    mu_assert("Run must not wait for a cancelled timer",
+              coro_now_ns() - start < 1000000000ULL);
+    mu_assert_eq_int(1, args.result);
+    coro_scheduler_destroy(sched);
+}
+
+/* Test: Poll resumes each ready coroutine once */
+mu_test(test_poll_once)
+{
+    CoroScheduler *sched = coro_scheduler_create(0);
+    long counter = 0;
+
+    coro_spawn(sched, counting_body, &counter);
+    coro_spawn(sched, counting_body, &counter);
+    mu_assert_eq_int(2, (int)coro_scheduler_poll(sched));
+    mu_assert_eq_int(2, (int)counter);
+    mu_assert("Two switches per resume", coro_scheduler_switches(sched) == 4);
+
+    coro_scheduler_run(sched);
+    mu_assert_eq_int(20, (int)counter);
+    coro_scheduler_destroy(sched);
+}
+
+/* Test: Thousands of coroutines interleave on one thread */
+mu_test(test_many_coroutines)
+{
+    enum { COUNT = 5000 };
+    CoroScheduler *sched = coro_scheduler_create(16 * 1024);
+    long counter = 0;
+
+    for (int i = 0; i < COUNT; i++) {
+        mu_assert_not_null(coro_spawn(sched, counting_body, &counter));
+    }
+    coro_scheduler_run(sched);
+
+    mu_assert("Every coroutine must count to ten", counter == COUNT * 10L);
+    mu_assert_eq_int(0, (int)coro_scheduler_live(sched));
+    coro_scheduler_destroy(sched);
+}
+
+/* Test: Finished coroutines' stacks are reused */
+mu_test(test_stack_reuse)
+{
+    CoroScheduler *sched = coro_scheduler_create(0);
+    long counter = 0;
+
+    Coro *first = coro_spawn(sched, counting_body, &counter);
+    coro_scheduler_run(sched);
+    Coro *second = coro_spawn(sched, counting_body, &counter);
+    coro_scheduler_run(sched);
+
+    mu_assert("Finished slot should be recycled", first == second);
+    mu_assert_eq_int(20, (int)counter);
+    coro_scheduler_destroy(sched);
+}
+
+/* Test: Coroutine stacks hold real call depth */
+mu_test(test_stack_depth)
+{
+    CoroScheduler *sched = coro_scheduler_create(0);
+    int result = 0;
+
+    coro_spawn(sched, deep_body, &result);
+    coro_scheduler_run(sched);
+
+    mu_assert_eq_int(64, result);
+    coro_scheduler_destroy(sched);
+}
+
+/* Test: Coroutines may spawn coroutines */
+mu_test(test_spawn_from_coroutine)
+{
+    CoroScheduler *sched = coro_scheduler_create(0);
+    SpawnArgs ctx = { sched, 0 };
+
+    coro_spawn(sched, parent_body, &ctx);
+    coro_scheduler_run(sched);
+
+    mu_assert_eq_int(1, ctx.children);
+    coro_scheduler_destroy(sched);
+}
+
+/* Test: Game sessions wait on input or gravity timers on one thread */
+mu_test(test_session_multiplexing)
+{
+    enum { SESSIONS = 200 };
+    static MuxSession sessions[SESSIONS];
+    CoroScheduler *sched = coro_scheduler_create(32 * 1024);
+
+    for (int i = 0; i < SESSIONS; i++) {
+        memset(&sessions[i], 0, sizeof(MuxSession));
+        game_init_seeded(&sessions[i].game, (uint64_t)i + 1);
+        sessions[i].coro = coro_spawn(sched, session_body, &sessions[i]);
+    }
+    coro_scheduler_poll(sched);
+
+    /* Deliver two inputs to every session, then let timers run out */
+    for (int round = 0; round < 2; round++) {
+        for (int i = 0; i < SESSIONS; i++) {
+            sessions[i].inbox = round == 0 ? INPUT_LEFT : INPUT_HARD_DROP;
+            coro_wake(sessions[i].coro);
+        }
+        coro_scheduler_poll(sched);
+    }
+    coro_scheduler_run(sched);
+
+    for (int i = 0; i < SESSIONS; i++) {
+        mu_assert_eq_int(2, sessions[i].inputs);
+        mu_assert_eq_int(5, sessions[i].steps);
+    }
+    mu_assert_eq_int(0, (int)coro_scheduler_live(sched));
+    coro_scheduler_destroy(sched);
+}
+
+/* Test suite runner */
+static void run_all_tests(void)
+{
+    printf("\nRunning Coroutine Module Tests...\n");
+    printf("=================================\n\n");
+
+    mu_run_test(test_scheduler_create_destroy);
+    mu_run_test(test_yield_round_robin);
+    mu_run_test(test_current);
+    mu_run_test(test_sleep_order);
+    mu_run_test(test_park_wake);
+    mu_run_test(test_park_timeout);
+    mu_run_test(test_wake_cancels_timer);
+    mu_run_test(test_poll_once);
+    mu_run_test(test_many_coroutines);
+    mu_run_test(test_stack_reuse);
+    mu_run_test(test_stack_depth);
+    mu_run_test(test_spawn_from_coroutine);
+    mu_run_test(test_session_multiplexing);
+}
+
+int main(void)
+{
+    run_all_tests();
+    mu_print_summary();
+
+    if (mu_tests_failed == 0) {
+        printf("\nAll tests passed!\n");
+    }
+
+    return mu_return_status();
+}
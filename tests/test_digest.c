@@ -0,0 +1,173 @@
+/**
+ * @file test_digest.c
+ * @brief Golden state digest over a million scripted game ticks
+ *
+ * Runs a fixed set of seeded sessions through the serial SessionHost
+ * with the default scripted driver and folds the engine state of every
+ * session into a rolling hash every DIGEST_INTERVAL ticks. The result
+ * must match the committed golden values, so any change in how the
+ * engine plays out (randomizer, gravity, lock delay, scoring, clears)
+ * shows up here even when no unit test covers it.
+ *
+ * After an intended behavior change, copy the printed digests into
+ * GOLDEN_DIGESTS.
+ */
+
+#include <stdio.h>
+#include <time.h>
+#include "minunit.h"
+#include "../src/session_host.h"
+
+#define DIGEST_SESSIONS 8
+#define DIGEST_TICKS    125000      /* Per session: one million in total */
+#define DIGEST_INTERVAL 64
+
+/* Rolling digest per session for seeds 1..DIGEST_SESSIONS */
+static const uint64_t GOLDEN_DIGESTS[DIGEST_SESSIONS] = {
+    0xBDE97850E2D585F0ULL, 0xE70251F00475E3DDULL,
+    0x6A78B53E27560C50ULL, 0x5B364ACEAA50350AULL,
+    0x21AA5E62CFAB8B81ULL, 0x89E08466EF6C6734ULL,
+    0x7AEAB564DDEF35C3ULL, 0xF9B9AA25C26D163FULL,
+};
+
+#define FNV_OFFSET 0xCBF29CE484222325ULL
+#define FNV_PRIME  0x100000001B3ULL
+
+/* Helper: Folds a value into an FNV-1a hash, byte order independent */
+static uint64_t fold(uint64_t hash, uint64_t value)
+{
+    for (int i = 0; i < 8; i++) {
+        hash = (hash ^ (value & 0xFF)) * FNV_PRIME;
+        value >>= 8;
+    }
+    return hash;
+}
+
+/* Helper: Hashes the state of a session field by field (no padding bytes) */
+static uint64_t fold_session(uint64_t hash, const Session *session)
+{
+    const GameState *game = &session->game;
+    for (int y = 0; y < BOARD_HEIGHT; y++) {
+        for (int x = 0; x < BOARD_WIDTH; x++) {
+            hash = fold(hash, (uint64_t)game->board.cells[y][x]);
+        }
+    }
+    hash = fold(hash, (uint64_t)game->current.type);
+    hash = fold(hash, (uint64_t)(int64_t)game->current.x);
+    hash = fold(hash, (uint64_t)(int64_t)game->current.y);
+    hash = fold(hash, (uint64_t)game->current.rotation);
+    hash = fold(hash, (uint64_t)game->next.type);
+    hash = fold(hash, (uint64_t)game->hold);
+    hash = fold(hash, (uint64_t)game->hold_used);
+    hash = fold(hash, (uint64_t)game->score);
+    hash = fold(hash, (uint64_t)game->level);
+    hash = fold(hash, (uint64_t)game->lines);
+    hash = fold(hash, (uint64_t)game->is_running);
+    hash = fold(hash, game->rng_state);
+    hash = fold(hash, game->bag);
+    hash = fold(hash, game->revision);
+    hash = fold(hash, game->gravity_accum);
+    hash = fold(hash, game->lock_deadline_ns);
+    hash = fold(hash, (uint64_t)game->lock_resets);
+    hash = fold(hash, (uint64_t)(int64_t)game->lowest_y);
+    hash = fold(hash, session->pieces);
+    hash = fold(hash, session->games_finished);
+    return hash;
+}
+
+/* Helper: Runs the seeded sessions and fills one digest per session */
+static int run_digest(int ticks, uint64_t digests[DIGEST_SESSIONS])
+{
+    SessionHost *host = session_host_create(NULL);
+    if (host == NULL) {
+        return 0;
+    }
+    SessionId ids[DIGEST_SESSIONS];
+    for (int i = 0; i < DIGEST_SESSIONS; i++) {
+        ids[i] = session_host_create_session(host, (uint64_t)i + 1);
+        digests[i] = FNV_OFFSET;
+    }
+
+    for (int tick = 1; tick <= ticks; tick++) {
+        session_host_tick(host);
+        if (tick % DIGEST_INTERVAL == 0 || tick == ticks) {
+            for (int i = 0; i < DIGEST_SESSIONS; i++) {
+                digests[i] = fold_session(digests[i], session_host_get(host, ids[i]));
+            }
+        }
+    }
+    session_host_destroy(host);
+    return 1;
+}
+
+/* Test: The same seeds give the same digests */
+mu_test(test_digest_repeatable)
+{
+    uint64_t a[DIGEST_SESSIONS], b[DIGEST_SESSIONS];
+    mu_assert("first run", run_digest(5000, a));
+    mu_assert("second run", run_digest(5000, b));
+    for (int i = 0; i < DIGEST_SESSIONS; i++) {
+        mu_assert("digest repeats", a[i] == b[i]);
+    }
+    mu_assert("seeds differ", a[0] != a[1]);
+}
+
+/* Test: One changed cell changes the hash */
+mu_test(test_digest_sensitive)
+{
+    static Session session;
+    game_init_seeded(&session.game, 3);
+    uint64_t before = fold_session(FNV_OFFSET, &session);
+    session.game.board.cells[BOARD_HEIGHT - 1][0] = COLOR_T;
+    mu_assert("cell change detected", fold_session(FNV_OFFSET, &session) != before);
+}
+
+/* Test: A million scripted ticks end in the golden digests */
+mu_test(test_digest_golden)
+{
+    uint64_t digests[DIGEST_SESSIONS];
+    struct timespec start, end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    mu_assert("run", run_digest(DIGEST_TICKS, digests));
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    double seconds = (double)(end.tv_sec - start.tv_sec) + (double)(end.tv_nsec - start.tv_nsec) / 1e9;
+    double ticks = (double)DIGEST_TICKS * DIGEST_SESSIONS;
+    printf("  %.0f game ticks in %.2f s (%.2f M ticks/s)\n", ticks, seconds,
+           seconds > 0.0 ? ticks / seconds / 1e6 : 0.0);
+
+    int matches = 1;
+    for (int i = 0; i < DIGEST_SESSIONS; i++) {
+        matches &= digests[i] == GOLDEN_DIGESTS[i];
+    }
+    if (!matches) {
+        printf("  Digests (copy into GOLDEN_DIGESTS after an intended change):\n");
+        for (int i = 0; i < DIGEST_SESSIONS; i += 2) {
+            printf("    0x%016llXULL, 0x%016llXULL,\n",
+                   (unsigned long long)digests[i], (unsigned long long)digests[i + 1]);
+        }
+    }
+    mu_assert("engine behavior matches the golden digests", matches);
+}
+
+static void run_all_tests(void)
+{
+    printf("\nRunning State Digest Tests...\n");
+    printf("=============================\n\n");
+
+    mu_run_test(test_digest_repeatable);
+    mu_run_test(test_digest_sensitive);
+    mu_run_test(test_digest_golden);
+}
+
+int main(void)
+{
+    run_all_tests();
+    mu_print_summary();
+
+    if (mu_tests_failed == 0) {
+        printf("\nAll tests passed!\n");
+    }
+
+    return mu_return_status();
+}
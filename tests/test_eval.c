@@ -0,0 +1,137 @@
+/**
+ * @file test_eval.c
+ * @brief Unit tests for the row lookup tables and board evaluation
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "minunit.h"
+#include "../src/eval.h"
+
+/* Cell of a row pattern, with the walls filled */
+static int cell(unsigned int pattern, int x)
+{
+    return x < 0 || x >= BOARD_WIDTH ? 1 : (int)((pattern >> x) & 1u);
+}
+
+/* Test: Every table entry matches a walk over the cells */
+mu_test(test_row_table_matches_cells)
+{
+    for (unsigned int pattern = 0; pattern < EVAL_ROW_PATTERNS; pattern++) {
+        int filled = 0, transitions = 0, gaps = 0;
+        unsigned int wells = 0;
+        for (int x = 0; x < BOARD_WIDTH; x++) {
+            filled += cell(pattern, x);
+            transitions += cell(pattern, x) != cell(pattern, x - 1);
+            gaps += !cell(pattern, x) && cell(pattern, x - 1);
+            if (!cell(pattern, x) && cell(pattern, x - 1) && cell(pattern, x + 1)) {
+                wells |= 1u << x;
+            }
+        }
+        transitions += cell(pattern, BOARD_WIDTH - 1) != cell(pattern, BOARD_WIDTH);
+        
+        const EvalRow *row = eval_row(pattern);
+        mu_assert_eq_int(filled, row->filled);
+        mu_assert_eq_int(transitions, row->transitions);
+        mu_assert_eq_int(gaps, row->gaps);
+        mu_assert_eq_int((int)wells, row->wells);
+        mu_assert_eq_int(__builtin_popcount(wells), row->well_cells);
+    }
+}
+
+/* Test: A few patterns by hand */
+mu_test(test_row_table_examples)
+{
+    mu_assert_eq_int(2, eval_row(0x000)->transitions);
+    mu_assert_eq_int(1, eval_row(0x000)->gaps);
+    mu_assert_eq_int(0, eval_row(0x3FF)->transitions);
+    mu_assert_eq_int(10, eval_row(0x3FF)->filled);
+    /* Column 0 open against the wall, column 5 open between blocks */
+    mu_assert_eq_int(0x021, eval_row(0x3DE)->wells);
+    mu_assert_eq_int(2, eval_row(0x3DE)->gaps);
+    mu_assert_eq_int(4, eval_row(0x3DE)->transitions);
+}
+
+/* Test: Patterns are cut from the padded row masks */
+mu_test(test_row_pattern_from_board)
+{
+    GameState game;
+    game_init_seeded(&game, 1);
+    game.board.cells[BOARD_HEIGHT - 1][0] = 1;
+    game.board.cells[BOARD_HEIGHT - 1][9] = 1;
+    game_board_sync(&game.board);
+    
+    mu_assert_eq_int(0x201, (int)eval_row_pattern(&game.board, BOARD_HEIGHT - 1));
+    mu_assert_eq_int(0, (int)eval_row_pattern(&game.board, 0));
+}
+
+/* Test: Table sums agree with the cells and the engine's features */
+mu_test(test_rows_match_board)
+{
+    GameState game;
+    game_init_seeded(&game, 95);
+    
+    for (int i = 0; i < 200 && game.is_running; i++) {
+        game_move_current(&game, (i % 7) - 3, 0);
+        if (i % 3 == 0) {
+            game_rotate_current(&game, 1);
+        }
+        game_hard_drop(&game);
+        
+        int filled = 0;
+        for (int y = 0; y < BOARD_HEIGHT; y++) {
+            for (int x = 0; x < BOARD_WIDTH; x++) {
+                filled += game.board.cells[y][x] != 0;
+            }
+        }
+        EvalRowSums sums;
+        eval_rows(&game.board, &sums);
+        mu_assert_eq_int(filled, sums.filled);
+        mu_assert_eq_int(game.board.features.row_transition_total, sums.row_transitions);
+    }
+}
+
+/* Test: A hole costs more than the same cells stacked flat */
+mu_test(test_eval_prefers_flat)
+{
+    GameState flat, holed;
+    game_init_seeded(&flat, 1);
+    game_init_seeded(&holed, 1);
+    
+    for (int x = 0; x < 4; x++) {
+        flat.board.cells[BOARD_HEIGHT - 1][x] = 1;
+        holed.board.cells[BOARD_HEIGHT - 1][x] = x != 1;
+    }
+    holed.board.cells[BOARD_HEIGHT - 2][1] = 1;
+    game_board_sync(&flat.board);
+    game_board_sync(&holed.board);
+    
+    mu_assert("Flat board should score higher",
+              eval_board(&flat.board, &EVAL_DEFAULT_WEIGHTS) >
+              eval_board(&holed.board, &EVAL_DEFAULT_WEIGHTS));
+    mu_assert_eq_int(0, eval_board(&flat.board, &(EvalWeights){ 0, 0, 0, 0, 0, 0 }));
+}
+
+static void run_all_tests(void)
+{
+    printf("\nRunning Evaluation Module Tests...\n");
+    printf("==================================\n\n");
+
+    mu_run_test(test_row_table_matches_cells);
+    mu_run_test(test_row_table_examples);
+    mu_run_test(test_row_pattern_from_board);
+    mu_run_test(test_rows_match_board);
+    mu_run_test(test_eval_prefers_flat);
+}
+
+int main(void)
+{
+    run_all_tests();
+    mu_print_summary();
+
+    if (mu_tests_failed == 0) {
+        printf("\nAll tests passed!\n");
+    }
+
+    return mu_return_status();
+}
@@ -118,6 +118,7 @@ mu_test(test_invalid_position_collision)
     
     /* Place a cell in the board */
     game.board.cells[5][5] = COLOR_O;
+    game_board_sync(&game.board);
     
     /* Create piece that would overlap */
     Tetromino t = tetromino_create(TETRO_O);
@@ -167,6 +168,7 @@ mu_test(test_move_blocked_piece)
     /* Place a blocking cell to the right of spawn position (x=3) */
     game.board.cells[0][5] = COLOR_Z;
     game.board.cells[1][5] = COLOR_Z;  /* O-piece is 2x2 */
+    game_board_sync(&game.board);
     
     /* Position piece at spawn (x=3) and try to move right */
     int result = game_move_current(&game, 1, 0);
@@ -198,6 +200,7 @@ mu_test(test_rotate_blocked)
     game.board.cells[1][5] = COLOR_Z;
     game.board.cells[2][5] = COLOR_Z;
     game.board.cells[3][5] = COLOR_Z;
+    game_board_sync(&game.board);
     
     int result = game_rotate_current(&game, 1);
     
@@ -271,6 +274,7 @@ mu_test(test_clear_single_line)
     for (int x = 0; x < BOARD_WIDTH; x++) {
         game.board.cells[BOARD_HEIGHT - 1][x] = COLOR_I;
     }
+    game_board_sync(&game.board);
     
     int cleared = game_clear_lines(&game);
     
@@ -290,6 +294,7 @@ mu_test(test_clear_double)
         game.board.cells[BOARD_HEIGHT - 1][x] = COLOR_I;
         game.board.cells[BOARD_HEIGHT - 2][x] = COLOR_O;
     }
+    game_board_sync(&game.board);
     
     int cleared = game_clear_lines(&game);
     
@@ -310,6 +315,7 @@ mu_test(test_clear_tetris)
             game.board.cells[BOARD_HEIGHT - 1 - row][x] = COLOR_I;
         }
     }
+    game_board_sync(&game.board);
     
     int cleared = game_clear_lines(&game);
     
@@ -331,6 +337,7 @@ mu_test(test_clear_shifts_down)
     for (int x = 0; x < BOARD_WIDTH; x++) {
         game.board.cells[BOARD_HEIGHT - 1][x] = COLOR_I;
     }
+    game_board_sync(&game.board);
     
     game_clear_lines(&game);
     
@@ -349,6 +356,7 @@ mu_test(test_clear_no_lines)
     /* Place some incomplete lines */
     game.board.cells[BOARD_HEIGHT - 1][0] = COLOR_I;
     game.board.cells[BOARD_HEIGHT - 1][5] = COLOR_O;
+    game_board_sync(&game.board);
     
     int cleared = game_clear_lines(&game);
     
@@ -370,6 +378,7 @@ mu_test(test_score_level_2)
     for (int x = 0; x < BOARD_WIDTH; x++) {
         game.board.cells[BOARD_HEIGHT - 1][x] = COLOR_I;
     }
+    game_board_sync(&game.board);
     
     game_clear_lines(&game);
     
@@ -387,6 +396,7 @@ mu_test(test_level_progression)
         for (int x = 0; x < BOARD_WIDTH; x++) {
             game.board.cells[BOARD_HEIGHT - 1][x] = COLOR_I;
         }
+        game_board_sync(&game.board);
         game_clear_lines(&game);
     }
     
@@ -452,6 +462,7 @@ mu_test(test_game_over_blocked)
             game.board.cells[y][x] = COLOR_Z;
         }
     }
+    game_board_sync(&game.board);
     
     mu_assert_eq_int(1, game_check_game_over(&game));
 }
@@ -480,6 +491,7 @@ mu_test(test_spawn_blocked)
             game.board.cells[y][x] = COLOR_Z;
         }
     }
+    game_board_sync(&game.board);
     
     int result = game_spawn_piece(&game, TETRO_O);
     
@@ -498,6 +510,78 @@ mu_test(test_next_type)
     mu_assert_eq_int(TETRO_L, game_get_next_type(&game));
 }
 
+/* Test: Every run of seven draws is one of each type */
+mu_test(test_bag_draws)
+{
+    static GameState game;
+    game_init_seeded(&game, 42);
+    
+    /* The first two draws are next, then current */
+    unsigned int seen = (1u << game.next.type) | (1u << game.current.type);
+    mu_assert("first draws differ", game.next.type != game.current.type);
+    mu_assert_eq_int((int)(GAME_BAG_FULL & ~seen), (int)game_bag(&game));
+    int draws = 2;
+    
+    for (int i = 0; i < 7 * 20; i++) {
+        /* Empty the board so the game never tops out */
+        memset(game.board.cells, 0, sizeof(game.board.cells));
+        game_board_sync(&game.board);
+        unsigned int before = game_bag(&game);
+        game_hard_drop(&game);
+        TetrominoType drawn = game.next.type;
+        mu_assert("drawn type was in the bag", before & (1u << drawn));
+        mu_assert("type not drawn twice in a bag", !(seen & (1u << drawn)));
+        seen |= 1u << drawn;
+        if (++draws % 7 == 0) {
+            mu_assert_eq_int((int)GAME_BAG_FULL, (int)seen);
+            mu_assert_eq_int((int)GAME_BAG_FULL, (int)game_bag(&game));
+            seen = 0;
+        }
+    }
+}
+
+/* Test: Draw probabilities are exact and sum to one */
+mu_test(test_bag_probabilities)
+{
+    static GameState game;
+    game_init_seeded(&game, 5);
+    
+    double sum = 0.0;
+    int feasible = 0;
+    for (int type = 0; type < TETRO_COUNT; type++) {
+        double p = game_draw_probability(&game, (TetrominoType)type);
+        sum += p;
+        if (game_bag(&game) & (1u << type)) {
+            feasible++;
+            mu_assert("feasible type has 1/5", p == 1.0 / 5.0);
+        } else {
+            mu_assert("drawn type has 0", p == 0.0);
+        }
+    }
+    mu_assert_eq_int(5, feasible);
+    mu_assert("probabilities sum to one", sum > 0.999999 && sum < 1.000001);
+    mu_assert("next cannot come again", game_draw_probability(&game, game.next.type) == 0.0);
+    
+    game.bag = 1u << TETRO_T;
+    mu_assert("last type is certain", game_draw_probability(&game, TETRO_T) == 1.0);
+}
+
+/* Test: Following the bag without a game */
+mu_test(test_bag_after)
+{
+    unsigned int bag = GAME_BAG_FULL;
+    bag = game_bag_after(bag, TETRO_I);
+    mu_assert_eq_int((int)(GAME_BAG_FULL & ~(1u << TETRO_I)), (int)bag);
+    mu_assert_eq_int((int)GAME_BAG_FULL, (int)game_bag_after(1u << TETRO_L, TETRO_L));
+    
+    /* Holding into an empty slot draws too */
+    static GameState game;
+    game_init_seeded(&game, 9);
+    unsigned int before = game_bag(&game);
+    game_hold_piece(&game);
+    mu_assert_eq_int((int)game_bag_after(before, game.next.type), (int)game_bag(&game));
+}
+
 /* Test: Move down (gravity) */
 mu_test(test_move_down)
 {
@@ -563,6 +647,7 @@ mu_test(test_complex_line_clear)
     for (int x = 0; x < BOARD_WIDTH; x++) {
         game.board.cells[BOARD_HEIGHT - 3][x] = COLOR_T;
     }
+    game_board_sync(&game.board);
     
     int cleared = game_clear_lines(&game);
     
@@ -577,6 +662,845 @@ mu_test(test_complex_line_clear)
     mu_assert_eq_int(COLOR_O, game.board.cells[BOARD_HEIGHT - 1][9]);
 }
 
+/* Helper: Build a T-spin double slot with its T piece at x=3, y=17 */
+static void setup_tsd_slot(GameState *game)
+{
+    setup_game_with_next(game, TETRO_I);
+    
+    for (int x = 0; x < BOARD_WIDTH; x++) {
+        if (x != 4) {
+            game->board.cells[BOARD_HEIGHT - 1][x] = COLOR_Z;
+        }
+        if (x < 3 || x > 5) {
+            game->board.cells[BOARD_HEIGHT - 2][x] = COLOR_Z;
+        }
+    }
+    /* Overhang above the slot */
+    game->board.cells[BOARD_HEIGHT - 3][3] = COLOR_Z;
+    game_board_sync(&game->board);
+    
+    game_spawn_piece(game, TETRO_T);
+    game->current.x = 3;
+    game->current.y = BOARD_HEIGHT - 3;
+    game->current.rotation = 1;
+}
+
+/* Test: Rotating a T into a slot is a full T-spin */
+mu_test(test_tspin_full_detected)
+{
+    GameState game;
+    setup_tsd_slot(&game);
+    
+    mu_assert_eq_int(1, game_rotate_current(&game, 1));
+    mu_assert_eq_int(MOVE_ROTATE, game.last_move);
+    mu_assert_eq_int(SPIN_FULL, game_detect_spin(&game));
+}
+
+/* Test: T-spin double scores and reports through last_clear */
+mu_test(test_tspin_double_lock)
+{
+    GameState game;
+    setup_tsd_slot(&game);
+    game_rotate_current(&game, 1);
+    
+    int cleared = game_lock_piece(&game);
+    
+    mu_assert_eq_int(2, cleared);
+    mu_assert_eq_int(1200, game.score);
+    mu_assert_eq_int(SPIN_FULL, game.last_clear.spin);
+    mu_assert_eq_int(1200, game.last_clear.points);
+    mu_assert_eq_int((1 << (BOARD_HEIGHT - 1)) | (1 << (BOARD_HEIGHT - 2)),
+                     game.last_clear.rows_mask);
+}
+
+/* Test: Same slot reached without a rotation is no spin */
+mu_test(test_tspin_requires_rotation)
+{
+    GameState game;
+    setup_tsd_slot(&game);
+    game.current.rotation = 2;
+    game.last_move = MOVE_DROP;
+    
+    mu_assert_eq_int(SPIN_NONE, game_detect_spin(&game));
+}
+
+/* Test: Three corners without both front corners is a mini */
+mu_test(test_tspin_mini_detected)
+{
+    GameState game;
+    setup_game_with_next(&game, TETRO_I);
+    game_spawn_piece(&game, TETRO_T);
+    
+    /* T pointing up on the floor; floor fills both bottom corners */
+    game.board.cells[BOARD_HEIGHT - 2][0] = COLOR_Z;
+    game_board_sync(&game.board);
+    game.current.x = 0;
+    game.current.y = BOARD_HEIGHT - 2;
+    game.current.rotation = 0;
+    game.last_move = MOVE_ROTATE;
+    
+    mu_assert_eq_int(SPIN_MINI, game_detect_spin(&game));
+}
+
+/* Test: Open T rotation on an empty board is no spin */
+mu_test(test_tspin_open_board)
+{
+    GameState game;
+    setup_game_with_next(&game, TETRO_I);
+    game_spawn_piece(&game, TETRO_T);
+    
+    game_rotate_current(&game, 1);
+    
+    mu_assert_eq_int(SPIN_NONE, game_detect_spin(&game));
+}
+
+/* Test: game_calculate_spin_score table */
+mu_test(test_calculate_spin_score)
+{
+    mu_assert_eq_int(400, game_calculate_spin_score(0, SPIN_FULL, 1));
+    mu_assert_eq_int(800, game_calculate_spin_score(1, SPIN_FULL, 1));
+    mu_assert_eq_int(2400, game_calculate_spin_score(2, SPIN_FULL, 2));
+    mu_assert_eq_int(1600, game_calculate_spin_score(3, SPIN_FULL, 1));
+    mu_assert_eq_int(100, game_calculate_spin_score(0, SPIN_MINI, 1));
+    mu_assert_eq_int(200, game_calculate_spin_score(1, SPIN_MINI, 1));
+    mu_assert_eq_int(400, game_calculate_spin_score(2, SPIN_MINI, 1));
+    mu_assert_eq_int(300, game_calculate_spin_score(2, SPIN_NONE, 1));
+    mu_assert_eq_int(0, game_calculate_spin_score(5, SPIN_FULL, 1));
+}
+
+/* Test: game_clear_lines reports cleared rows as a mask */
+mu_test(test_clear_rows_mask)
+{
+    GameState game;
+    game_init(&game);
+    
+    for (int x = 0; x < BOARD_WIDTH; x++) {
+        game.board.cells[BOARD_HEIGHT - 1][x] = COLOR_I;
+        game.board.cells[BOARD_HEIGHT - 3][x] = COLOR_I;
+    }
+    game_board_sync(&game.board);
+    
+    game_clear_lines(&game);
+    
+    mu_assert_eq_int(2, game.last_clear.lines);
+    mu_assert_eq_int((1 << (BOARD_HEIGHT - 1)) | (1 << (BOARD_HEIGHT - 3)),
+                     game.last_clear.rows_mask);
+    mu_assert_eq_int(SPIN_NONE, game.last_clear.spin);
+    mu_assert_eq_int(300, game.last_clear.points);
+}
+
+/* Test: First hold stores current and brings in next */
+mu_test(test_hold_empty_slot)
+{
+    GameState game;
+    setup_game_with_next(&game, TETRO_I);
+    game_spawn_piece(&game, TETRO_T);
+    
+    mu_assert_eq_int(TETRO_COUNT, game_get_hold_type(&game));
+    mu_assert_eq_int(TETRO_I, game_get_hold_alternative(&game));
+    
+    mu_assert_eq_int(1, game_hold_piece(&game));
+    mu_assert_eq_int(TETRO_T, game_get_hold_type(&game));
+    mu_assert_eq_int(TETRO_I, game.current.type);
+    mu_assert_eq_int(TETRO_START_X, game.current.x);
+    mu_assert_eq_int(TETRO_START_Y, game.current.y);
+}
+
+/* Test: Hold is locked until the next piece is promoted */
+mu_test(test_hold_once_per_drop)
+{
+    GameState game;
+    setup_game_with_next(&game, TETRO_I);
+    game_spawn_piece(&game, TETRO_T);
+    
+    game_hold_piece(&game);
+    mu_assert_eq_int(0, game_can_hold(&game));
+    mu_assert_eq_int(0, game_hold_piece(&game));
+    mu_assert_eq_int(TETRO_I, game.current.type);
+    
+    game_set_next_type(&game, TETRO_O);
+    game_hard_drop(&game);
+    mu_assert_eq_int(1, game_can_hold(&game));
+}
+
+/* Test: Hold swaps with the held type and resets position */
+mu_test(test_hold_swap)
+{
+    GameState game;
+    setup_game_with_next(&game, TETRO_I);
+    game_spawn_piece(&game, TETRO_T);
+    game_hold_piece(&game);
+    
+    game_set_next_type(&game, TETRO_O);
+    game_hard_drop(&game);
+    
+    /* O is current, T is held */
+    game_move_current(&game, 1, 1);
+    mu_assert_eq_int(1, game_hold_piece(&game));
+    mu_assert_eq_int(TETRO_T, game.current.type);
+    mu_assert_eq_int(TETRO_O, game_get_hold_type(&game));
+    mu_assert_eq_int(TETRO_START_X, game.current.x);
+    mu_assert_eq_int(0, game.current.rotation);
+}
+
+/* Test: game_step moves the piece down while possible */
+mu_test(test_step_moves_down)
+{
+    GameState game;
+    setup_game_with_next(&game, TETRO_I);
+    game_spawn_piece(&game, TETRO_O);
+    
+    int start_y = game.current.y;
+    StepResult step = game_step(&game);
+    
+    mu_assert_eq_int(1, step.moved);
+    mu_assert_eq_int(0, step.locked);
+    mu_assert_eq_int(start_y + 1, game.current.y);
+}
+
+/* Test: game_step locks at the bottom and promotes next exactly once */
+mu_test(test_step_locks_and_spawns)
+{
+    GameState game;
+    setup_game_with_next(&game, TETRO_I);
+    game_spawn_piece(&game, TETRO_O);
+    game.current.y = BOARD_HEIGHT - 2;
+    
+    StepResult step = game_step(&game);
+    
+    mu_assert_eq_int(0, step.moved);
+    mu_assert_eq_int(1, step.locked);
+    mu_assert_eq_int(0, step.game_over);
+    mu_assert_eq_int(TETRO_I, game.current.type);
+    mu_assert_eq_int(TETRO_START_Y, game.current.y);
+    mu_assert_eq_int(1, game.is_running);
+}
+
+/* Test: game_commit_piece reports top-out */
+mu_test(test_commit_game_over)
+{
+    GameState game;
+    setup_game_with_next(&game, TETRO_I);
+    game_spawn_piece(&game, TETRO_O);
+    game.current.y = BOARD_HEIGHT - 2;
+    
+    /* Block the I spawn row without completing it */
+    game.board.cells[1][4] = COLOR_Z;
+    game_board_sync(&game.board);
+    
+    StepResult step = game_commit_piece(&game);
+    
+    mu_assert_eq_int(1, step.locked);
+    mu_assert_eq_int(1, step.game_over);
+    mu_assert_eq_int(0, game.is_running);
+}
+
+/* Test: Lines are cleared before the spawn is validated */
+mu_test(test_commit_clears_before_topout)
+{
+    GameState game;
+    setup_game_with_next(&game, TETRO_O);
+    game_spawn_piece(&game, TETRO_I);
+    
+    /* Row 1 blocks the spawn until the vertical I completes it */
+    for (int x = 1; x < BOARD_WIDTH; x++) {
+        game.board.cells[1][x] = COLOR_Z;
+    }
+    game_board_sync(&game.board);
+    game.current.rotation = 1;
+    game.current.x = -2;
+    game.current.y = 1;
+    
+    StepResult step = game_commit_piece(&game);
+    
+    mu_assert_eq_int(1, step.clear.lines);
+    mu_assert_eq_int(1 << 1, step.clear.rows_mask);
+    mu_assert_eq_int(0, step.game_over);
+    mu_assert_eq_int(1, game.is_running);
+    mu_assert_eq_int(TETRO_O, game.current.type);
+}
+
+/* Test: game_commit_piece flags level changes */
+mu_test(test_commit_level_up)
+{
+    GameState game;
+    setup_game_with_next(&game, TETRO_O);
+    game_spawn_piece(&game, TETRO_I);
+    game.lines = 9;
+    
+    for (int x = 4; x < BOARD_WIDTH; x++) {
+        game.board.cells[BOARD_HEIGHT - 1][x] = COLOR_Z;
+    }
+    game_board_sync(&game.board);
+    game.current.x = 0;
+    game.current.y = BOARD_HEIGHT - 2;
+    
+    StepResult step = game_commit_piece(&game);
+    
+    mu_assert_eq_int(1, step.clear.lines);
+    mu_assert_eq_int(1, step.level_up);
+    mu_assert_eq_int(2, game.level);
+}
+
+/* Test: Fresh game has no pending events */
+mu_test(test_events_empty_on_init)
+{
+    GameState game;
+    GameEvent event;
+    game_init(&game);
+    
+    mu_assert_eq_int(0, game_pending_events(&game));
+    mu_assert_eq_int(0, game_poll_event(&game, &event));
+}
+
+/* Test: Locking emits a lock event with the piece cells */
+mu_test(test_event_piece_locked)
+{
+    GameState game;
+    GameEvent event;
+    setup_game_with_next(&game, TETRO_I);
+    game_spawn_piece(&game, TETRO_O);
+    game.current.x = 4;
+    game.current.y = BOARD_HEIGHT - 2;
+    
+    game_commit_piece(&game);
+    
+    mu_assert_eq_int(1, game_poll_event(&game, &event));
+    mu_assert_eq_int(GAME_EVENT_PIECE_LOCKED, event.type);
+    mu_assert_eq_int(TETRO_O, event.lock.piece);
+    for (int i = 0; i < 4; i++) {
+        mu_assert("Locked cell must be on the board",
+                  game.board.cells[event.lock.cell_y[i]][event.lock.cell_x[i]] == COLOR_O);
+    }
+    mu_assert_eq_int(0, game_pending_events(&game));
+}
+
+/* Test: Line clear and level change events in order */
+mu_test(test_event_clear_and_level)
+{
+    GameState game;
+    GameEvent event;
+    setup_game_with_next(&game, TETRO_O);
+    game_spawn_piece(&game, TETRO_I);
+    game.lines = 9;
+    
+    for (int x = 4; x < BOARD_WIDTH; x++) {
+        game.board.cells[BOARD_HEIGHT - 1][x] = COLOR_Z;
+    }
+    game_board_sync(&game.board);
+    game.current.x = 0;
+    game.current.y = BOARD_HEIGHT - 2;
+    game_commit_piece(&game);
+    
+    mu_assert_eq_int(3, game_pending_events(&game));
+    game_poll_event(&game, &event);
+    mu_assert_eq_int(GAME_EVENT_PIECE_LOCKED, event.type);
+    game_poll_event(&game, &event);
+    mu_assert_eq_int(GAME_EVENT_LINES_CLEARED, event.type);
+    mu_assert_eq_int(1, event.clear.lines);
+    mu_assert_eq_int(1 << (BOARD_HEIGHT - 1), event.clear.rows_mask);
+    game_poll_event(&game, &event);
+    mu_assert_eq_int(GAME_EVENT_LEVEL_CHANGED, event.type);
+    mu_assert_eq_int(1, event.level.old_level);
+    mu_assert_eq_int(2, event.level.new_level);
+}
+
+/* Test: Blocked spawn emits game over */
+mu_test(test_event_game_over)
+{
+    GameState game;
+    GameEvent event;
+    game_init(&game);
+    game.score = 1234;
+    
+    for (int x = 0; x < BOARD_WIDTH; x++) {
+        game.board.cells[0][x] = COLOR_Z;
+        game.board.cells[1][x] = COLOR_Z;
+    }
+    game_board_sync(&game.board);
+    game_spawn_piece(&game, TETRO_O);
+    
+    mu_assert_eq_int(1, game_poll_event(&game, &event));
+    mu_assert_eq_int(GAME_EVENT_GAME_OVER, event.type);
+    mu_assert_eq_int(1234, event.over.score);
+}
+
+/* Test: Full queue drops new events and counts them */
+mu_test(test_event_queue_overflow)
+{
+    GameState game;
+    GameEvent event;
+    game_init(&game);
+    
+    for (int i = 0; i < GAME_EVENT_QUEUE_SIZE + 3; i++) {
+        game_spawn_piece(&game, TETRO_O);
+        game.current.y = BOARD_HEIGHT - 2;
+        game_commit_piece(&game);
+        memset(game.board.cells, 0, sizeof(game.board.cells));
+        game_board_sync(&game.board);
+    }
+    
+    mu_assert_eq_int(GAME_EVENT_QUEUE_SIZE, game_pending_events(&game));
+    mu_assert_eq_int(3, game.events_dropped);
+    mu_assert_eq_int(1, game_poll_event(&game, &event));
+    mu_assert_eq_int(GAME_EVENT_QUEUE_SIZE - 1, game_pending_events(&game));
+}
+
+/* Per-cell bounds and occupancy test the padded masks replace */
+static int reference_is_valid(const GameState *game, const Tetromino *t)
+{
+    const int (*shape)[TETRO_MATRIX_SIZE] = tetromino_get_shape(t->type, t->rotation);
+    
+    for (int row = 0; row < TETRO_MATRIX_SIZE; row++) {
+        for (int col = 0; col < TETRO_MATRIX_SIZE; col++) {
+            if (shape[row][col]) {
+                int x = t->x + col;
+                int y = t->y + row;
+                if (x < 0 || x >= BOARD_WIDTH || y < 0 || y >= BOARD_HEIGHT ||
+                    game->board.cells[y][x] != 0) {
+                    return 0;
+                }
+            }
+        }
+    }
+    return 1;
+}
+
+/* Test: Sentinel rows and walls are set up by init */
+mu_test(test_board_sentinels)
+{
+    GameState game;
+    game_init(&game);
+    
+    for (int i = 0; i < BOARD_PAD; i++) {
+        mu_assert("Rows above the board must be filled", game.board.rows[i] == BOARD_FULL_ROW);
+        mu_assert("Rows below the board must be filled",
+                  game.board.rows[BOARD_PAD + BOARD_HEIGHT + i] == BOARD_FULL_ROW);
+    }
+    for (int y = 0; y < BOARD_HEIGHT; y++) {
+        mu_assert("Board rows must hold only the walls",
+                  game.board.rows[y + BOARD_PAD] == BOARD_EMPTY_ROW);
+    }
+}
+
+/* Test: Mask collision agrees with the per-cell test everywhere */
+mu_test(test_padded_collision_matches_reference)
+{
+    GameState game;
+    game_init_seeded(&game, 91);
+    uint64_t state = 91;
+    
+    for (int round = 0; round < 20; round++) {
+        /* Random rubble, denser towards the floor */
+        for (int y = 0; y < BOARD_HEIGHT; y++) {
+            for (int x = 0; x < BOARD_WIDTH; x++) {
+                state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+                game.board.cells[y][x] = (int)(state >> 59) < y ? COLOR_Z : 0;
+            }
+        }
+        game_board_sync(&game.board);
+        
+        for (int type = 0; type < TETRO_COUNT; type++) {
+            for (int rotation = 0; rotation < ROTATION_COUNT; rotation++) {
+                for (int y = -6; y < BOARD_HEIGHT + 4; y++) {
+                    for (int x = -6; x < BOARD_WIDTH + 4; x++) {
+                        Tetromino t = { (TetrominoType)type, x, y, rotation };
+                        mu_assert_eq_int(reference_is_valid(&game, &t),
+                                         game_is_valid_position(&game, &t));
+                    }
+                }
+            }
+        }
+    }
+}
+
+/* Test: Lock and line clear keep the masks equal to the cells */
+mu_test(test_masks_follow_play)
+{
+    GameState game;
+    game_init_seeded(&game, 7);
+    
+    /* O pieces side by side clear two rows every five drops, then the
+       regular sequence stacks rubble until it tops out */
+    for (int i = 0; i < 600 && game.is_running; i++) {
+        if (i < 100) {
+            game_spawn_piece(&game, TETRO_O);
+            game_move_current(&game, 2 * (i % 5) - 1 - game.current.x, 0);
+        } else {
+            game_move_current(&game, (i % 7) - 3, 0);
+            if (i % 3 == 0) {
+                game_rotate_current(&game, 1);
+            }
+        }
+        game_hard_drop(&game);
+        
+        Board rebuilt = game.board;
+        game_board_sync(&rebuilt);
+        mu_assert("Masks must match the cells after every lock",
+                  memcmp(rebuilt.rows, game.board.rows, sizeof(rebuilt.rows)) == 0);
+        mu_assert("Column masks must match the cells after every lock",
+                  memcmp(rebuilt.cols, game.board.cols, sizeof(rebuilt.cols)) == 0);
+    }
+    mu_assert_eq_int(40, game.lines);
+}
+
+/* Test: Gravity table follows the guideline curve up to 20G */
+mu_test(test_gravity_table)
+{
+    mu_assert_eq_int(1092, (int)game_gravity(1));
+    mu_assert_eq_int(1092, (int)game_gravity(0));
+    for (int level = 2; level < 19; level++) {
+        mu_assert("Gravity must grow with the level", game_gravity(level) > game_gravity(level - 1));
+        mu_assert("Gravity below level 19 must be under 20G", game_gravity(level) < GAME_GRAVITY_20G);
+    }
+    mu_assert_eq_int((int)GAME_GRAVITY_20G, (int)game_gravity(19));
+    mu_assert_eq_int((int)GAME_GRAVITY_20G, (int)game_gravity(50));
+}
+
+/* Test: Drop distance equals stepping the piece down row by row */
+mu_test(test_drop_distance)
+{
+    GameState game;
+    game_init_seeded(&game, 92);
+    
+    game_spawn_piece(&game, TETRO_O);
+    mu_assert_eq_int(BOARD_HEIGHT - 2, game_drop_distance(&game));
+    
+    for (int i = 0; i < 200 && game.is_running; i++) {
+        game_move_current(&game, (i % 9) - 4, 0);
+        if (i % 2 == 0) {
+            game_rotate_current(&game, i % 4 == 0);
+        }
+        
+        GameState probe = game;
+        int stepped = 0;
+        while (game_move_current(&probe, 0, 1)) {
+            stepped++;
+        }
+        mu_assert_eq_int(stepped, game_drop_distance(&game));
+        
+        game_hard_drop(&game);
+    }
+}
+
+/* Test: Gravity accumulates over calls and the first call starts the clock */
+mu_test(test_advance_gravity)
+{
+    GameState game;
+    game_init_seeded(&game, 1);
+    game_spawn_piece(&game, TETRO_T);
+    int start_y = game.current.y;
+    
+    StepResult step = game_advance(&game, 5000000000ULL);
+    mu_assert_eq_int(0, step.moved);
+    
+    /* Level 1 is just under one row per second: 10 ms frames for 1.5 s */
+    for (int i = 1; i <= 150; i++) {
+        game_advance(&game, 5000000000ULL + (uint64_t)i * 10000000ULL);
+    }
+    mu_assert_eq_int(start_y + 1, game.current.y);
+    
+    /* A paused game does not fall */
+    game.is_paused = 1;
+    game_advance(&game, 9000000000ULL);
+    mu_assert_eq_int(start_y + 1, game.current.y);
+}
+
+/* Test: At 20G the piece lands in the same call, then waits for the lock delay */
+mu_test(test_advance_20g)
+{
+    GameState game;
+    game_init_seeded(&game, 1);
+    game.level = 20;
+    game_spawn_piece(&game, TETRO_I);
+    
+    /* 20G needs no elapsed time, so even the clock-starting call lands */
+    StepResult step = game_advance(&game, 1000);
+    mu_assert_eq_int(1, step.moved);
+    mu_assert_eq_int(0, step.locked);
+    mu_assert_eq_int(0, game_drop_distance(&game));
+    
+    step = game_advance(&game, 1000 + GAME_LOCK_DELAY_NS - 1);
+    mu_assert_eq_int(0, step.locked);
+    step = game_advance(&game, 1000 + GAME_LOCK_DELAY_NS);
+    mu_assert_eq_int(1, step.locked);
+    mu_assert_eq_int(COLOR_I, game.board.cells[BOARD_HEIGHT - 1][3]);
+}
+
+/* Test: Moves on the ground restart the lock delay at most GAME_LOCK_RESETS times */
+mu_test(test_lock_delay_resets)
+{
+    GameState game;
+    game_init_seeded(&game, 1);
+    game.level = 20;
+    game_spawn_piece(&game, TETRO_O);
+    
+    uint64_t landed = 1;
+    game_advance(&game, landed);
+    mu_assert_eq_int(0, game_drop_distance(&game));
+    
+    uint64_t t = landed;
+    for (int i = 1; i <= GAME_LOCK_RESETS + 1; i++) {
+        t += GAME_LOCK_DELAY_NS / 2;
+        mu_assert("Shift on the floor must succeed", game_move_current(&game, (i % 2) ? 1 : -1, 0));
+        mu_assert_eq_int(0, game_advance(&game, t).locked);
+    }
+    mu_assert_eq_int(GAME_LOCK_RESETS, game.lock_resets);
+    
+    /* The last move came after the resets ran out: the deadline stayed */
+    uint64_t deadline = landed + GAME_LOCK_RESETS * (GAME_LOCK_DELAY_NS / 2) + GAME_LOCK_DELAY_NS;
+    mu_assert_eq_int(0, game_advance(&game, deadline - 1).locked);
+    mu_assert_eq_int(1, game_advance(&game, deadline).locked);
+}
+
+/* Test: Reaching a lower row gives the resets back; a pause holds the deadline */
+mu_test(test_lock_delay_step_reset_and_pause)
+{
+    GameState game;
+    game_init_seeded(&game, 1);
+    game_spawn_piece(&game, TETRO_O);
+    
+    game.lock_resets = GAME_LOCK_RESETS;
+    mu_assert_eq_int(1, game_move_current(&game, 0, 1));
+    mu_assert_eq_int(0, game.lock_resets);
+    
+    game.level = 20;
+    game_advance(&game, 1);
+    
+    game.is_paused = 1;
+    game_advance(&game, 10 * GAME_LOCK_DELAY_NS);
+    game.is_paused = 0;
+    mu_assert_eq_int(0, game_advance(&game, 10 * GAME_LOCK_DELAY_NS + 1).locked);
+    mu_assert_eq_int(1, game_advance(&game, 11 * GAME_LOCK_DELAY_NS + 1).locked);
+}
+
+/* Reference for game_apply_actions(): one engine call per action */
+static size_t apply_one_by_one(GameState *game, const InputAction *actions, size_t count)
+{
+    for (size_t i = 0; i < count; i++) {
+        if (!game->is_running) {
+            return i;
+        }
+        switch (actions[i]) {
+            case INPUT_LEFT:       game_move_current(game, -1, 0); break;
+            case INPUT_RIGHT:      game_move_current(game, 1, 0); break;
+            case INPUT_DOWN:       game_move_current(game, 0, 1); break;
+            case INPUT_ROTATE_CW:  game_rotate_current(game, 1); break;
+            case INPUT_ROTATE_CCW: game_rotate_current(game, 0); break;
+            case INPUT_HOLD:       game_hold_piece(game); break;
+            case INPUT_HARD_DROP:
+                game_hard_drop(game);
+                return i + 1;
+            default: break;
+        }
+    }
+    return count;
+}
+
+mu_test(test_apply_actions_matches_single_calls)
+{
+    static const InputAction moves[] = {
+        INPUT_LEFT, INPUT_RIGHT, INPUT_DOWN, INPUT_ROTATE_CW,
+        INPUT_ROTATE_CCW, INPUT_HOLD, INPUT_HARD_DROP, INPUT_NONE
+    };
+    uint32_t rng = 93;
+    int locks = 0;
+    GameState batched, single;
+    
+    for (int round = 0; round < 2000; round++) {
+        if (round == 0 || !single.is_running) {
+            game_init_seeded(&batched, (uint64_t)round);
+            single = batched;
+        }
+        /* Runs of repeated actions, hard drops rare enough to reach walls */
+        InputAction actions[24];
+        size_t count = 0;
+        while (count < 24) {
+            rng = rng * 1103515245u + 12345u;
+            InputAction action = moves[(rng >> 16) % 8];
+            if (action == INPUT_HARD_DROP && (rng >> 24) % 4 != 0) {
+                action = INPUT_DOWN;
+            }
+            size_t run = 1 + (rng >> 8) % 7;
+            for (size_t k = 0; k < run && count < 24; k++) {
+                actions[count++] = action;
+            }
+        }
+        /* Half the rounds play as if the piece were already grounded */
+        if (round % 2 == 1) {
+            batched.lock_deadline_ns = single.lock_deadline_ns = 1;
+        }
+        
+        mu_assert_eq_int((int)apply_one_by_one(&single, actions, count),
+                         (int)game_apply_actions(&batched, actions, count));
+        mu_assert_eq_int(single.current.type, batched.current.type);
+        mu_assert_eq_int(single.current.x, batched.current.x);
+        mu_assert_eq_int(single.current.y, batched.current.y);
+        mu_assert_eq_int(single.current.rotation, batched.current.rotation);
+        mu_assert_eq_int(single.last_move, batched.last_move);
+        mu_assert_eq_int(single.lock_resets, batched.lock_resets);
+        mu_assert_eq_int(single.lock_reset_pending, batched.lock_reset_pending);
+        mu_assert_eq_int(single.lowest_y, batched.lowest_y);
+        mu_assert_eq_int(single.hold, batched.hold);
+        mu_assert_eq_int(single.hold_used, batched.hold_used);
+        mu_assert_eq_int(single.score, batched.score);
+        mu_assert_eq_int(single.is_running, batched.is_running);
+        mu_assert("Boards should match",
+                  memcmp(single.board.rows, batched.board.rows,
+                         sizeof(single.board.rows)) == 0);
+        
+        GameEvent event;
+        while (game_poll_event(&batched, &event)) {
+            locks += event.type == GAME_EVENT_PIECE_LOCKED;
+        }
+        single.event_head = single.event_tail;
+    }
+    mu_assert("Random play should lock pieces", locks > 100);
+}
+
+mu_test(test_apply_actions_stops_at_lock)
+{
+    GameState game;
+    game_init_seeded(&game, 1);
+    game_spawn_piece(&game, TETRO_O);
+    
+    InputAction actions[] = { INPUT_LEFT, INPUT_HARD_DROP, INPUT_RIGHT, INPUT_RIGHT };
+    mu_assert_eq_int(2, (int)game_apply_actions(&game, actions, 4));
+    GameEvent event;
+    mu_assert("The drop should lock", game_poll_event(&game, &event));
+    mu_assert_eq_int(GAME_EVENT_PIECE_LOCKED, event.type);
+    mu_assert_eq_int(tetromino_create(game.current.type).y, game.current.y);
+    
+    mu_assert_eq_int(2, (int)game_apply_actions(&game, actions + 2, 2));
+    mu_assert_eq_int(0, (int)game_apply_actions(&game, actions, 0));
+}
+
+mu_test(test_apply_actions_shift_run_clamped)
+{
+    GameState game;
+    game_init_seeded(&game, 1);
+    game_spawn_piece(&game, TETRO_I);
+    unsigned int revision = game.revision;
+    
+    InputAction left[BOARD_WIDTH * 2];
+    for (int i = 0; i < BOARD_WIDTH * 2; i++) {
+        left[i] = INPUT_LEFT;
+    }
+    mu_assert_eq_int(BOARD_WIDTH * 2, (int)game_apply_actions(&game, left, BOARD_WIDTH * 2));
+    mu_assert_eq_int(0, game.current.x);
+    mu_assert_eq_int(MOVE_SHIFT, game.last_move);
+    mu_assert("A run should count as one change", game.revision == revision + 1);
+    
+    /* A block in the way stops the run next to it */
+    const unsigned char *masks = tetromino_get_row_masks(TETRO_I, game.current.rotation);
+    int row = 0;
+    while (masks[row] == 0) {
+        row++;
+    }
+    game.board.cells[game.current.y + row][7] = 1;
+    game_board_sync(&game.board);
+    InputAction right[] = { INPUT_RIGHT, INPUT_RIGHT, INPUT_RIGHT, INPUT_RIGHT, INPUT_RIGHT };
+    game_apply_actions(&game, right, 5);
+    mu_assert_eq_int(3, game.current.x);
+}
+
+mu_test(test_features_empty_board)
+{
+    GameState game;
+    game_init_seeded(&game, 1);
+    const BoardFeatures *f = game_get_features(&game);
+    
+    mu_assert_eq_int(0, f->holes);
+    mu_assert_eq_int(0, f->well_depth);
+    mu_assert_eq_int(2 * BOARD_HEIGHT, f->row_transition_total);
+    mu_assert_eq_int(BOARD_WIDTH, f->column_transition_total);
+    for (int x = 0; x < BOARD_WIDTH; x++) {
+        mu_assert_eq_int(0, f->heights[x]);
+    }
+}
+
+mu_test(test_features_known_board)
+{
+    GameState game;
+    game_init_seeded(&game, 1);
+    
+    /* Bottom row filled except column 0, one overhang over a hole in column 3 */
+    for (int x = 1; x < BOARD_WIDTH; x++) {
+        game.board.cells[BOARD_HEIGHT - 1][x] = 1;
+    }
+    game.board.cells[BOARD_HEIGHT - 3][3] = 1;
+    game_board_sync(&game.board);
+    const BoardFeatures *f = game_get_features(&game);
+    
+    mu_assert_eq_int(0, f->heights[0]);
+    mu_assert_eq_int(1, f->heights[1]);
+    mu_assert_eq_int(3, f->heights[3]);
+    mu_assert_eq_int(1, f->column_holes[3]);
+    mu_assert_eq_int(1, f->holes);
+    mu_assert_eq_int(1, f->wells[0]);
+    mu_assert_eq_int(1, f->well_depth);
+    mu_assert_eq_int(2, f->row_transitions[BOARD_HEIGHT - 1]);
+    mu_assert_eq_int(4, f->row_transitions[BOARD_HEIGHT - 3]);
+    mu_assert_eq_int(2 * BOARD_HEIGHT + 2, f->row_transition_total);
+    mu_assert_eq_int(3, f->column_transitions[3]);
+    mu_assert_eq_int(12, f->column_transition_total);
+}
+
+mu_test(test_features_follow_play)
+{
+    GameState game;
+    game_init_seeded(&game, 94);
+    
+    /* Same mix as test_masks_follow_play: clean clears, then rubble */
+    for (int i = 0; i < 600 && game.is_running; i++) {
+        if (i < 100) {
+            game_spawn_piece(&game, TETRO_O);
+            game_move_current(&game, 2 * (i % 5) - 1 - game.current.x, 0);
+        } else {
+            game_move_current(&game, (i % 7) - 3, 0);
+            if (i % 3 == 0) {
+                game_rotate_current(&game, 1);
+            }
+        }
+        game_hard_drop(&game);
+        mu_assert("Features must match a recomputation after every lock",
+                  game_features_verify(&game.board));
+    }
+}
+
+mu_test(test_features_clear_under_rubble)
+{
+    GameState game;
+    game_init_seeded(&game, 1);
+    
+    /* Four rows open in column 9, with rubble and two holes above them */
+    for (int y = BOARD_HEIGHT - 4; y < BOARD_HEIGHT; y++) {
+        for (int x = 0; x < BOARD_WIDTH - 1; x++) {
+            game.board.cells[y][x] = 1;
+        }
+    }
+    game.board.cells[BOARD_HEIGHT - 6][2] = 1;
+    game.board.cells[BOARD_HEIGHT - 6][3] = 1;
+    game.board.cells[BOARD_HEIGHT - 5][6] = 1;
+    game_board_sync(&game.board);
+    mu_assert_eq_int(2, game_get_features(&game)->holes);
+    
+    /* A vertical I into column 9 clears all four rows */
+    game_spawn_piece(&game, TETRO_I);
+    game_rotate_current(&game, 1);
+    const unsigned char *masks = tetromino_get_row_masks(TETRO_I, game.current.rotation);
+    game_move_current(&game, BOARD_WIDTH - 1 - game.current.x - __builtin_ctz(masks[0]), 0);
+    game_hard_drop(&game);
+    
+    mu_assert_eq_int(4, game.last_clear.lines);
+    mu_assert("Features must match a recomputation after the clear",
+              game_features_verify(&game.board));
+    const BoardFeatures *f = game_get_features(&game);
+    mu_assert_eq_int(2, f->holes);
+    mu_assert_eq_int(2, f->heights[2]);
+    mu_assert_eq_int(1, f->heights[6]);
+}
+
 /* Test suite runner */
 static void run_all_tests(void)
 {
@@ -618,6 +1542,45 @@ static void run_all_tests(void)
     mu_run_test(test_move_down_blocked);
     mu_run_test(test_multiple_moves);
     mu_run_test(test_complex_line_clear);
+    mu_run_test(test_tspin_full_detected);
+    mu_run_test(test_tspin_double_lock);
+    mu_run_test(test_tspin_requires_rotation);
+    mu_run_test(test_tspin_mini_detected);
+    mu_run_test(test_tspin_open_board);
+    mu_run_test(test_calculate_spin_score);
+    mu_run_test(test_clear_rows_mask);
+    mu_run_test(test_hold_empty_slot);
+    mu_run_test(test_hold_once_per_drop);
+    mu_run_test(test_hold_swap);
+    mu_run_test(test_step_moves_down);
+    mu_run_test(test_step_locks_and_spawns);
+    mu_run_test(test_commit_game_over);
+    mu_run_test(test_commit_clears_before_topout);
+    mu_run_test(test_commit_level_up);
+    mu_run_test(test_events_empty_on_init);
+    mu_run_test(test_event_piece_locked);
+    mu_run_test(test_event_clear_and_level);
+    mu_run_test(test_event_game_over);
+    mu_run_test(test_event_queue_overflow);
+    mu_run_test(test_board_sentinels);
+    mu_run_test(test_padded_collision_matches_reference);
+    mu_run_test(test_masks_follow_play);
+    mu_run_test(test_gravity_table);
+    mu_run_test(test_drop_distance);
+    mu_run_test(test_advance_gravity);
+    mu_run_test(test_advance_20g);
+    mu_run_test(test_lock_delay_resets);
+    mu_run_test(test_lock_delay_step_reset_and_pause);
+    mu_run_test(test_apply_actions_matches_single_calls);
+    mu_run_test(test_apply_actions_stops_at_lock);
+    mu_run_test(test_apply_actions_shift_run_clamped);
+    mu_run_test(test_features_empty_board);
+    mu_run_test(test_features_known_board);
+    mu_run_test(test_features_follow_play);
+    mu_run_test(test_features_clear_under_rubble);
+    mu_run_test(test_bag_draws);
+    mu_run_test(test_bag_probabilities);
+    mu_run_test(test_bag_after);
 }
 
 int main(void)
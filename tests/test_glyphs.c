@@ -0,0 +1,90 @@
+/**
+ * @file test_glyphs.c
+ * @brief Unit tests for the packed cell glyph tables
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "minunit.h"
+#include "../src/glyphs.h"
+
+/* Test: Half blocks for all four masks */
+mu_test(test_half_blocks)
+{
+    mu_assert("Empty", strcmp(glyphs_half(0), " ") == 0);
+    mu_assert("Upper", strcmp(glyphs_half(1), "▀") == 0);
+    mu_assert("Lower", strcmp(glyphs_half(2), "▄") == 0);
+    mu_assert("Both", strcmp(glyphs_half(3), "█") == 0);
+}
+
+/* Test: Half block masks are cut from two row bitmasks */
+mu_test(test_half_mask)
+{
+    uint32_t top = 0x005;       /* columns 0 and 2 */
+    uint32_t bottom = 0x006;    /* columns 1 and 2 */
+
+    mu_assert_eq_int(1, (int)glyphs_half_mask(top, bottom, 0));
+    mu_assert_eq_int(2, (int)glyphs_half_mask(top, bottom, 1));
+    mu_assert_eq_int(3, (int)glyphs_half_mask(top, bottom, 2));
+    mu_assert_eq_int(0, (int)glyphs_half_mask(top, bottom, 3));
+}
+
+/* Test: Braille range ends and single dots */
+mu_test(test_braille_dots)
+{
+    mu_assert("No dots is U+2800", strcmp(glyphs_braille(0x00), "⠀") == 0);
+    mu_assert("All dots is U+28FF", strcmp(glyphs_braille(0xFF), "⣿") == 0);
+    mu_assert("Top left is dot 1", strcmp(glyphs_braille(0x01), "⠁") == 0);
+    mu_assert("Top right is dot 4", strcmp(glyphs_braille(0x02), "⠈") == 0);
+    mu_assert("Third row left is dot 3", strcmp(glyphs_braille(0x10), "⠄") == 0);
+    mu_assert("Bottom left is dot 7", strcmp(glyphs_braille(0x40), "⡀") == 0);
+    mu_assert("Bottom right is dot 8", strcmp(glyphs_braille(0x80), "⢀") == 0);
+    mu_assert("Left column", strcmp(glyphs_braille(0x55), "⡇") == 0);
+}
+
+/* Test: Every braille entry is a distinct three-byte character */
+mu_test(test_braille_table_distinct)
+{
+    for (unsigned int mask = 0; mask < 256; mask++) {
+        const char *glyph = glyphs_braille(mask);
+        mu_assert_eq_int(3, (int)strlen(glyph));
+        if (mask > 0) {
+            mu_assert("Entries must differ", strcmp(glyph, glyphs_braille(mask - 1)) != 0);
+        }
+    }
+}
+
+/* Test: Braille masks are cut from four row bitmasks */
+mu_test(test_braille_mask)
+{
+    uint32_t rows[GLYPHS_BRAILLE_ROWS] = { 0x3, 0x1, 0x2, 0xC };
+
+    mu_assert_eq_int(0x03 | 0x04 | 0x20, (int)glyphs_braille_mask(rows, 0));
+    mu_assert_eq_int(0xC0, (int)glyphs_braille_mask(rows, 2));
+    mu_assert_eq_int(0, (int)glyphs_braille_mask(rows, 4));
+}
+
+/* Test suite runner */
+static void run_all_tests(void)
+{
+    printf("\nRunning Glyphs Module Tests...\n");
+    printf("==============================\n\n");
+
+    mu_run_test(test_half_blocks);
+    mu_run_test(test_half_mask);
+    mu_run_test(test_braille_dots);
+    mu_run_test(test_braille_table_distinct);
+    mu_run_test(test_braille_mask);
+}
+
+int main(void)
+{
+    run_all_tests();
+    mu_print_summary();
+
+    if (mu_tests_failed == 0) {
+        printf("\nAll tests passed!\n");
+    }
+
+    return mu_return_status();
+}
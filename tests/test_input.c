@@ -5,8 +5,10 @@
 
 #include "../tests/minunit.h"
 #include "../src/input.h"
+#include "../src/input_queue.h"
 
 #include <ncurses.h>
+#include <time.h>
 #include <unistd.h>
 
 /* Test: Input initialization and cleanup */
@@ -262,6 +264,23 @@ mu_test(test_input_key_mapping_q_uppercase)
     endwin();
 }
 
+mu_test(test_input_key_mapping_c_hold)
+{
+    initscr();
+    input_init();
+    
+    /* Simulate lowercase and uppercase c */
+    ungetch('c');
+    InputAction action = input_get_action();
+    mu_assert_eq_int(INPUT_HOLD, action);
+    ungetch('C');
+    action = input_get_action();
+    mu_assert_eq_int(INPUT_HOLD, action);
+    
+    input_cleanup();
+    endwin();
+}
+
 mu_test(test_input_key_mapping_invalid)
 {
     initscr();
@@ -297,6 +316,144 @@ mu_test(test_input_has_input_with_input)
     endwin();
 }
 
+/* Test: input_decode maps plain keys */
+mu_test(test_input_decode_plain_keys)
+{
+    InputAction action;
+    
+    mu_assert_eq_int(1, (int)input_decode((const unsigned char *)" ", 1, &action));
+    mu_assert_eq_int(INPUT_HARD_DROP, action);
+    input_decode((const unsigned char *)"Z", 1, &action);
+    mu_assert_eq_int(INPUT_ROTATE_CCW, action);
+    input_decode((const unsigned char *)"c", 1, &action);
+    mu_assert_eq_int(INPUT_HOLD, action);
+    input_decode((const unsigned char *)"x", 1, &action);
+    mu_assert_eq_int(INPUT_INVALID, action);
+    mu_assert_eq_int(0, (int)input_decode((const unsigned char *)"", 0, &action));
+}
+
+/* Test: input_decode maps arrow sequences in both cursor modes */
+mu_test(test_input_decode_arrows)
+{
+    InputAction action;
+    
+    mu_assert_eq_int(3, (int)input_decode((const unsigned char *)"\x1b[D", 3, &action));
+    mu_assert_eq_int(INPUT_LEFT, action);
+    input_decode((const unsigned char *)"\x1b[C", 3, &action);
+    mu_assert_eq_int(INPUT_RIGHT, action);
+    input_decode((const unsigned char *)"\x1bOB", 3, &action);
+    mu_assert_eq_int(INPUT_DOWN, action);
+    input_decode((const unsigned char *)"\x1bOA", 3, &action);
+    mu_assert_eq_int(INPUT_ROTATE_CW, action);
+}
+
+/* Test: input_decode walks a buffer with several keys */
+mu_test(test_input_decode_sequence)
+{
+    const unsigned char buf[] = "\x1b[Dq\x1b[5~p";
+    size_t len = sizeof(buf) - 1;
+    InputAction actions[4];
+    size_t pos = 0;
+    int n = 0;
+    
+    while (pos < len && n < 4) {
+        pos += input_decode(buf + pos, len - pos, &actions[n++]);
+    }
+    
+    mu_assert_eq_int(4, n);
+    mu_assert_eq_int(INPUT_LEFT, actions[0]);
+    mu_assert_eq_int(INPUT_QUIT, actions[1]);
+    mu_assert_eq_int(INPUT_INVALID, actions[2]);  /* Page Up */
+    mu_assert_eq_int(INPUT_PAUSE, actions[3]);
+}
+
+/* Test: input_decode waits for the rest of a split escape sequence */
+mu_test(test_input_decode_incomplete)
+{
+    InputAction action = INPUT_NONE;
+    
+    mu_assert_eq_int(0, (int)input_decode((const unsigned char *)"\x1b", 1, &action));
+    mu_assert_eq_int(0, (int)input_decode((const unsigned char *)"\x1b[", 2, &action));
+    mu_assert_eq_int(0, (int)input_decode((const unsigned char *)"\x1bO", 2, &action));
+    mu_assert_eq_int(0, (int)input_decode((const unsigned char *)"\x1b[5", 3, &action));
+    mu_assert_eq_int(4, (int)input_decode((const unsigned char *)"\x1b[5~", 4, &action));
+    mu_assert_eq_int(INPUT_INVALID, action);
+    
+    /* ESC followed by anything else is complete */
+    mu_assert_eq_int(1, (int)input_decode((const unsigned char *)"\x1bq", 2, &action));
+    mu_assert_eq_int(INPUT_INVALID, action);
+}
+
+/* Helper: Sleeps for the given milliseconds */
+static void sleep_ms(long ms)
+{
+    struct timespec pause = { ms / 1000, (ms % 1000) * 1000000L };
+    nanosleep(&pause, NULL);
+}
+
+/* Helper: Runs the input thread on a pipe as stdin, returns the actions */
+static int run_input_thread(const char *first, const char *second, long gap_ms,
+                            InputAction *actions, int max)
+{
+    static InputQueue queue;
+    int fds[2];
+    int saved_stdin = dup(STDIN_FILENO);
+    if (saved_stdin < 0 || pipe(fds) != 0) {
+        return -1;
+    }
+    dup2(fds[0], STDIN_FILENO);
+    close(fds[0]);
+    input_queue_init(&queue);
+    input_thread_start(&queue);
+    
+    ssize_t ignored = write(fds[1], first, strlen(first));
+    sleep_ms(gap_ms);
+    ignored = write(fds[1], second, strlen(second));
+    (void)ignored;
+    sleep_ms(30);
+    input_thread_stop();
+    
+    dup2(saved_stdin, STDIN_FILENO);
+    close(saved_stdin);
+    close(fds[1]);
+    
+    int count = 0;
+    TimedInput input;
+    while (count < max && input_queue_pop(&queue, &input)) {
+        actions[count++] = input.action;
+    }
+    return count;
+}
+
+/* Test: An arrow key split across two reads is still an arrow key */
+mu_test(test_input_thread_split_arrow)
+{
+    InputAction actions[4];
+    
+    /* Longer than the poll interval, so the halves are read separately */
+    int count = run_input_thread("\x1b[", "C", 25, actions, 4);
+    mu_assert_eq_int(1, count);
+    mu_assert_eq_int(INPUT_RIGHT, actions[0]);
+    
+    /* After the escape timeout a lone ESC is dropped and the key stands alone */
+    count = run_input_thread("\x1b", "c", 120, actions, 4);
+    mu_assert_eq_int(1, count);
+    mu_assert_eq_int(INPUT_HOLD, actions[0]);
+}
+
+/* Test: Input thread start/stop without a terminal */
+mu_test(test_input_thread_start_stop)
+{
+    static InputQueue queue;
+    input_queue_init(&queue);
+    
+    mu_assert_eq_int(0, input_thread_start(NULL));
+    mu_assert_eq_int(1, input_thread_start(&queue));
+    mu_assert_eq_int(0, input_thread_start(&queue));  /* Already running */
+    input_thread_stop();
+    input_thread_stop();  /* Second stop is a no-op */
+}
+
 /* Test suite */
 mu_suite(input_tests)
 {
@@ -320,8 +477,15 @@ mu_suite(input_tests)
     mu_run_test(test_input_key_mapping_p_uppercase);
     mu_run_test(test_input_key_mapping_q_lowercase);
     mu_run_test(test_input_key_mapping_q_uppercase);
+    mu_run_test(test_input_key_mapping_c_hold);
     mu_run_test(test_input_key_mapping_invalid);
     mu_run_test(test_input_has_input_with_input);
+    mu_run_test(test_input_decode_plain_keys);
+    mu_run_test(test_input_decode_arrows);
+    mu_run_test(test_input_decode_sequence);
+    mu_run_test(test_input_decode_incomplete);
+    mu_run_test(test_input_thread_split_arrow);
+    mu_run_test(test_input_thread_start_stop);
 }
 
 int main(void)
@@ -0,0 +1,180 @@
+/**
+ * @file test_input_queue.c
+ * @brief Unit and stress tests for the SPSC input queue
+ */
+
+#include <stdio.h>
+#include <pthread.h>
+#include <sched.h>
+#include "minunit.h"
+#include "../src/input_queue.h"
+
+#define STRESS_EVENTS 200000UL
+
+/* Shared state for the producer/consumer stress test */
+typedef struct {
+    InputQueue *queue;
+    unsigned long count;
+} StressArgs;
+
+/* Producer: pushes a strictly increasing sequence, retrying when full */
+static void *stress_producer(void *arg)
+{
+    StressArgs *args = arg;
+    for (unsigned long i = 0; i < args->count; i++) {
+        TimedInput input = {
+            .action = (InputAction)(i % INPUT_INVALID),
+            .timestamp_ns = i
+        };
+        while (!input_queue_push(args->queue, &input)) {
+            /* Full: let the consumer catch up */
+            sched_yield();
+        }
+    }
+    return NULL;
+}
+
+/* Test: Fresh queue is empty */
+mu_test(test_queue_empty)
+{
+    static InputQueue queue;
+    TimedInput input;
+    input_queue_init(&queue);
+
+    mu_assert_eq_int(0, input_queue_pop(&queue, &input));
+    mu_assert_eq_int(0, (int)input_queue_dropped(&queue));
+}
+
+/* Test: Push then pop returns the same event */
+mu_test(test_queue_push_pop)
+{
+    static InputQueue queue;
+    TimedInput in = { INPUT_HARD_DROP, 12345 };
+    TimedInput out;
+    input_queue_init(&queue);
+
+    mu_assert_eq_int(1, input_queue_push(&queue, &in));
+    mu_assert_eq_int(1, input_queue_pop(&queue, &out));
+    mu_assert_eq_int(INPUT_HARD_DROP, out.action);
+    mu_assert("Timestamp must survive the queue", out.timestamp_ns == 12345);
+    mu_assert_eq_int(0, input_queue_pop(&queue, &out));
+}
+
+/* Test: Events come out in FIFO order */
+mu_test(test_queue_fifo)
+{
+    static InputQueue queue;
+    TimedInput input;
+    input_queue_init(&queue);
+
+    for (int i = 0; i < 10; i++) {
+        input.action = INPUT_LEFT;
+        input.timestamp_ns = (uint64_t)i;
+        input_queue_push(&queue, &input);
+    }
+    for (int i = 0; i < 10; i++) {
+        mu_assert_eq_int(1, input_queue_pop(&queue, &input));
+        mu_assert_eq_int(i, (int)input.timestamp_ns);
+    }
+}
+
+/* Test: Full queue rejects and counts pushes */
+mu_test(test_queue_full_drops)
+{
+    static InputQueue queue;
+    TimedInput input = { INPUT_DOWN, 0 };
+    input_queue_init(&queue);
+
+    for (int i = 0; i < INPUT_QUEUE_SIZE; i++) {
+        mu_assert_eq_int(1, input_queue_push(&queue, &input));
+    }
+    mu_assert_eq_int(0, input_queue_push(&queue, &input));
+    mu_assert_eq_int(0, input_queue_push(&queue, &input));
+    mu_assert_eq_int(2, (int)input_queue_dropped(&queue));
+
+    /* One pop makes room for one push */
+    input_queue_pop(&queue, &input);
+    mu_assert_eq_int(1, input_queue_push(&queue, &input));
+}
+
+/* Test: Indices wrap around the ring many times */
+mu_test(test_queue_wraparound)
+{
+    static InputQueue queue;
+    TimedInput input;
+    input_queue_init(&queue);
+
+    for (uint64_t i = 0; i < INPUT_QUEUE_SIZE * 10; i++) {
+        input.action = INPUT_RIGHT;
+        input.timestamp_ns = i;
+        mu_assert_eq_int(1, input_queue_push(&queue, &input));
+        mu_assert_eq_int(1, input_queue_pop(&queue, &input));
+        mu_assert("Wrapped event must match", input.timestamp_ns == i);
+    }
+}
+
+/* Test: Monotonic clock advances */
+mu_test(test_queue_now_monotonic)
+{
+    uint64_t a = input_queue_now_ns();
+    uint64_t b = input_queue_now_ns();
+    mu_assert("Clock must not go backwards", b >= a);
+}
+
+/* Test: Concurrent producer/consumer loses and reorders nothing */
+mu_test(test_queue_stress_no_loss_no_reorder)
+{
+    static InputQueue queue;
+    StressArgs args = { &queue, STRESS_EVENTS };
+    pthread_t producer;
+    input_queue_init(&queue);
+
+    mu_assert_eq_int(0, pthread_create(&producer, NULL, stress_producer, &args));
+
+    unsigned long expected = 0;
+    int in_order = 1;
+    TimedInput input;
+    while (expected < STRESS_EVENTS) {
+        if (!input_queue_pop(&queue, &input)) {
+            sched_yield();
+            continue;
+        }
+        if (input.timestamp_ns != expected ||
+            input.action != (InputAction)(expected % INPUT_INVALID)) {
+            in_order = 0;
+            break;
+        }
+        expected++;
+    }
+    pthread_join(producer, NULL);
+
+    mu_assert("Events must arrive complete and in order", in_order);
+    mu_assert_eq_int(0, input_queue_pop(&queue, &input));
+}
+
+/* Test suite runner */
+static void run_all_tests(void)
+{
+    printf("\nRunning Input Queue Module Tests...\n");
+    printf("===================================\n\n");
+
+    mu_run_test(test_queue_empty);
+    mu_run_test(test_queue_push_pop);
+    mu_run_test(test_queue_fifo);
+    mu_run_test(test_queue_full_drops);
+    mu_run_test(test_queue_wraparound);
+    mu_run_test(test_queue_now_monotonic);
+    mu_run_test(test_queue_stress_no_loss_no_reorder);
+}
+
+int main(void)
+{
+    run_all_tests();
+    mu_print_summary();
+
+    if (mu_tests_failed == 0) {
+        printf("\nAll tests passed!\n");
+    }
+
+    return mu_return_status();
+}
@@ -0,0 +1,261 @@
+/**
+ * @file test_metrics.c
+ * @brief Unit tests for the metrics counters and Prometheus endpoint
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include "minunit.h"
+#include "../src/metrics.h"
+
+#define WRITER_TICKS 100000UL
+
+static char text[8192];
+
+/* Helper: Sends a request and reads the whole response */
+static int http_get(int fd, const char *path, char *response, size_t size)
+{
+    char request[128];
+    int length = snprintf(request, sizeof(request), "GET %s HTTP/1.0\r\n\r\n", path);
+    if (send(fd, request, (size_t)length, 0) != length) {
+        close(fd);
+        return 0;
+    }
+
+    size_t total = 0;
+    ssize_t n;
+    while (total < size - 1 && (n = recv(fd, response + total, size - 1 - total, 0)) > 0) {
+        total += (size_t)n;
+    }
+    response[total] = '\0';
+    close(fd);
+    return 1;
+}
+
+/* Helper: Connects to the TCP endpoint */
+static int connect_tcp(int port)
+{
+    struct sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons((uint16_t)port);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (fd >= 0 && connect(fd, (struct sockaddr *)&addr, sizeof(addr)) < 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+/* Helper: Game-loop stand-in recording ticks concurrently with scrapes */
+static void *tick_writer(void *arg)
+{
+    Metrics *metrics = arg;
+    for (unsigned long i = 0; i < WRITER_TICKS; i++) {
+        metrics_observe_tick(metrics, i % 2000000);
+        metrics_add_pieces(metrics, 1, i % 2);
+    }
+    return NULL;
+}
+
+/* Test: Fresh metrics format as zeros */
+mu_test(test_format_initial)
+{
+    static Metrics metrics;
+    metrics_init(&metrics);
+    metrics_format(&metrics, text, sizeof(text));
+
+    mu_assert("Gauge must be present", strstr(text, "\ntetris_games_active 0\n") != NULL);
+    mu_assert("Counter must be present", strstr(text, "\ntetris_ticks_total 0\n") != NULL);
+    mu_assert("Histogram type must be declared",
+              strstr(text, "# TYPE tetris_tick_duration_seconds histogram\n") != NULL);
+    mu_assert("+Inf bucket must be present",
+              strstr(text, "tetris_tick_duration_seconds_bucket{le=\"+Inf\"} 0\n") != NULL);
+}
+
+/* Test: Tick observations land in cumulative buckets */
+mu_test(test_tick_histogram)
+{
+    static Metrics metrics;
+    metrics_init(&metrics);
+
+    metrics_observe_tick(&metrics, 30000);          /* 30 us */
+    metrics_observe_tick(&metrics, 50000);          /* exactly 50 us */
+    metrics_observe_tick(&metrics, 700000);         /* 700 us */
+    metrics_observe_tick(&metrics, 1000000000);     /* 1 s */
+    metrics_format(&metrics, text, sizeof(text));
+
+    mu_assert("50us bucket is inclusive",
+              strstr(text, "_bucket{le=\"5e-05\"} 2\n") != NULL);
+    mu_assert("1ms bucket is cumulative",
+              strstr(text, "_bucket{le=\"0.001\"} 3\n") != NULL);
+    mu_assert("100ms bucket excludes the 1s tick",
+              strstr(text, "_bucket{le=\"0.1\"} 3\n") != NULL);
+    mu_assert("+Inf holds every tick",
+              strstr(text, "_bucket{le=\"+Inf\"} 4\n") != NULL);
+    mu_assert("Count equals +Inf",
+              strstr(text, "tetris_tick_duration_seconds_count 4\n") != NULL);
+    mu_assert("Sum is in seconds",
+              strstr(text, "tetris_tick_duration_seconds_sum 1.000780000\n") != NULL);
+    mu_assert("Ticks counter", strstr(text, "\ntetris_ticks_total 4\n") != NULL);
+}
+
+/* Test: Counters and gauges show their values */
+mu_test(test_counters)
+{
+    static Metrics metrics;
+    metrics_init(&metrics);
+
+    metrics_set_games_active(&metrics, 12);
+    metrics_add_pieces(&metrics, 5, 2);
+    metrics_add_pieces(&metrics, 1, 0);
+    metrics_store_renderer_bytes(&metrics, 4096);
+    metrics_store_inputs_dropped(&metrics, 3);
+    metrics_format(&metrics, text, sizeof(text));
+
+    mu_assert("Games", strstr(text, "\ntetris_games_active 12\n") != NULL);
+    mu_assert("Pieces", strstr(text, "\ntetris_pieces_total 6\n") != NULL);
+    mu_assert("Lines", strstr(text, "\ntetris_lines_total 2\n") != NULL);
+    mu_assert("Renderer bytes", strstr(text, "\ntetris_renderer_bytes_total 4096\n") != NULL);
+    mu_assert("Dropped inputs", strstr(text, "\ntetris_inputs_dropped_total 3\n") != NULL);
+}
+
+/* Test: Formatting into a small buffer truncates like snprintf */
+mu_test(test_format_truncates)
+{
+    static Metrics metrics;
+    char small[32];
+    metrics_init(&metrics);
+
+    size_t full = metrics_format(&metrics, text, sizeof(text));
+    size_t needed = metrics_format(&metrics, small, sizeof(small));
+
+    mu_assert("Length must not depend on the buffer", needed == full);
+    mu_assert_eq_int((int)sizeof(small) - 1, (int)strlen(small));
+    mu_assert("Length of zero-size format", metrics_format(&metrics, NULL, 0) == full);
+}
+
+/* Test: TCP endpoint serves the snapshot and 404s other paths */
+mu_test(test_server_tcp)
+{
+    static Metrics metrics;
+    metrics_init(&metrics);
+    metrics_add_pieces(&metrics, 42, 0);
+
+    MetricsServer *server = metrics_server_start(&metrics, "0");
+    mu_assert_not_null(server);
+    int port = metrics_server_port(server);
+    mu_assert("Ephemeral port must be assigned", port > 0);
+
+    mu_assert_eq_int(1, http_get(connect_tcp(port), "/metrics", text, sizeof(text)));
+    mu_assert("Status line", strncmp(text, "HTTP/1.0 200 OK\r\n", 17) == 0);
+    mu_assert("Content type",
+              strstr(text, "Content-Type: text/plain; version=0.0.4\r\n") != NULL);
+    mu_assert("Body", strstr(text, "\ntetris_pieces_total 42\n") != NULL);
+
+    mu_assert_eq_int(1, http_get(connect_tcp(port), "/other", text, sizeof(text)));
+    mu_assert("Unknown path", strncmp(text, "HTTP/1.0 404", 12) == 0);
+
+    metrics_server_stop(server);
+}
+
+/* Test: Unix socket endpoint, removed on stop */
+mu_test(test_server_unix)
+{
+    static Metrics metrics;
+    char path[64];
+    char address[80];
+    metrics_init(&metrics);
+    snprintf(path, sizeof(path), "/tmp/tetris_metrics_%d.sock", (int)getpid());
+    snprintf(address, sizeof(address), "unix:%s", path);
+
+    MetricsServer *server = metrics_server_start(&metrics, address);
+    mu_assert_not_null(server);
+    mu_assert_eq_int(0, metrics_server_port(server));
+
+    struct sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    strcpy(addr.sun_path, path);
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    mu_assert_eq_int(0, connect(fd, (struct sockaddr *)&addr, sizeof(addr)));
+    mu_assert_eq_int(1, http_get(fd, "/metrics", text, sizeof(text)));
+    mu_assert("Body over Unix socket", strstr(text, "tetris_ticks_total 0\n") != NULL);
+
+    metrics_server_stop(server);
+    mu_assert("Socket file must be removed", access(path, F_OK) != 0);
+}
+
+/* Test: Bad addresses are rejected */
+mu_test(test_server_bad_address)
+{
+    static Metrics metrics;
+    metrics_init(&metrics);
+
+    mu_assert_null(metrics_server_start(&metrics, "not-a-port"));
+    mu_assert_null(metrics_server_start(&metrics, "70000"));
+    mu_assert_null(metrics_server_start(&metrics, "unix:"));
+    metrics_server_stop(NULL);
+}
+
+/* Test: Scrapes during concurrent updates see consistent totals at the end */
+mu_test(test_concurrent_updates)
+{
+    static Metrics metrics;
+    pthread_t writer;
+    metrics_init(&metrics);
+
+    MetricsServer *server = metrics_server_start(&metrics, "0");
+    mu_assert_not_null(server);
+    int port = metrics_server_port(server);
+
+    pthread_create(&writer, NULL, tick_writer, &metrics);
+    for (int i = 0; i < 20; i++) {
+        mu_assert_eq_int(1, http_get(connect_tcp(port), "/metrics", text, sizeof(text)));
+        mu_assert("Every scrape must succeed", strstr(text, "200 OK") != NULL);
+    }
+    pthread_join(writer, NULL);
+
+    mu_assert_eq_int(1, http_get(connect_tcp(port), "/metrics", text, sizeof(text)));
+    mu_assert("All ticks counted", strstr(text, "\ntetris_ticks_total 100000\n") != NULL);
+    mu_assert("Histogram count matches",
+              strstr(text, "tetris_tick_duration_seconds_count 100000\n") != NULL);
+    mu_assert("All pieces counted", strstr(text, "\ntetris_pieces_total 100000\n") != NULL);
+    metrics_server_stop(server);
+}
+
+/* Test suite runner */
+static void run_all_tests(void)
+{
+    printf("\nRunning Metrics Module Tests...\n");
+    printf("===============================\n\n");
+
+    mu_run_test(test_format_initial);
+    mu_run_test(test_tick_histogram);
+    mu_run_test(test_counters);
+    mu_run_test(test_format_truncates);
+    mu_run_test(test_server_tcp);
+    mu_run_test(test_server_unix);
+    mu_run_test(test_server_bad_address);
+    mu_run_test(test_concurrent_updates);
+}
+
+int main(void)
+{
+    run_all_tests();
+    mu_print_summary();
+
+    if (mu_tests_failed == 0) {
+        printf("\nAll tests passed!\n");
+    }
+
+    return mu_return_status();
+}
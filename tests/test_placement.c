@@ -0,0 +1,234 @@
+/**
+ * @file test_placement.c
+ * @brief Unit tests for the placement search and the skyline cache
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "minunit.h"
+#include "../src/placement.h"
+
+static PlacementList list;
+static PlacementList expected;
+
+/* Fills every column up to the given height, no overhangs */
+static void set_skyline(GameState *game, const int heights[BOARD_WIDTH])
+{
+    memset(game->board.cells, 0, sizeof(game->board.cells));
+    for (int x = 0; x < BOARD_WIDTH; x++) {
+        for (int y = BOARD_HEIGHT - heights[x]; y < BOARD_HEIGHT; y++) {
+            game->board.cells[y][x] = 1;
+        }
+    }
+    game_board_sync(&game->board);
+}
+
+static int same_lists(const PlacementList *a, const PlacementList *b)
+{
+    return a->count == b->count &&
+           memcmp(a->items, b->items, (size_t)a->count * sizeof(Placement)) == 0;
+}
+
+/* Test: Distinct placements on the empty board */
+mu_test(test_enumerate_empty_board)
+{
+    GameState game;
+    game_init_seeded(&game, 1);
+
+    mu_assert_eq_int(9, placement_enumerate(&game, TETRO_O, &list));
+    mu_assert_eq_int(17, placement_enumerate(&game, TETRO_I, &list));
+    mu_assert_eq_int(17, placement_enumerate(&game, TETRO_S, &list));
+    mu_assert_eq_int(34, placement_enumerate(&game, TETRO_T, &list));
+    mu_assert_eq_int(34, placement_enumerate(&game, TETRO_L, &list));
+}
+
+/* Test: Every placement is a valid resting position */
+mu_test(test_placements_rest)
+{
+    GameState game;
+    game_init_seeded(&game, 1);
+    int heights[BOARD_WIDTH] = { 3, 5, 0, 2, 2, 7, 1, 0, 4, 6 };
+    set_skyline(&game, heights);
+
+    for (int type = 0; type < TETRO_COUNT; type++) {
+        placement_enumerate(&game, (TetrominoType)type, &list);
+        mu_assert("Pieces should have somewhere to go", list.count > 0);
+        for (int i = 0; i < list.count; i++) {
+            Tetromino t = { (TetrominoType)type, list.items[i].x, list.items[i].y,
+                            list.items[i].rotation };
+            mu_assert("Placement must be valid", game_is_valid_position(&game, &t));
+            t.y++;
+            mu_assert("Placement must rest on something", !game_is_valid_position(&game, &t));
+        }
+    }
+}
+
+/* Test: The search slides pieces under an overhang */
+mu_test(test_enumerate_tuck)
+{
+    GameState game;
+    game_init_seeded(&game, 1);
+
+    /* A roof over columns 0-3, two rows above the floor */
+    for (int x = 0; x < 4; x++) {
+        game.board.cells[BOARD_HEIGHT - 3][x] = 1;
+    }
+    game_board_sync(&game.board);
+
+    int tucked = 0;
+    placement_enumerate(&game, TETRO_O, &list);
+    for (int i = 0; i < list.count; i++) {
+        tucked |= list.items[i].x + 1 < 4 && list.items[i].y + 1 == BOARD_HEIGHT - 1;
+    }
+    mu_assert("An O should fit under the roof", tucked);
+}
+
+/* Test: No placements when the piece cannot spawn */
+mu_test(test_enumerate_blocked_spawn)
+{
+    GameState game;
+    game_init_seeded(&game, 1);
+    int heights[BOARD_WIDTH] = { 20, 20, 20, 20, 20, 20, 20, 20, 20, 20 };
+    set_skyline(&game, heights);
+
+    mu_assert_eq_int(0, placement_enumerate(&game, TETRO_T, &list));
+}
+
+/* Test: Skyline keys differ by heights and type */
+mu_test(test_skyline_key)
+{
+    GameState game;
+    game_init_seeded(&game, 1);
+    uint64_t empty = placement_skyline_key(&game.board, TETRO_I);
+
+    mu_assert("Type is part of the key", empty != placement_skyline_key(&game.board, TETRO_O));
+    game.board.cells[BOARD_HEIGHT - 1][9] = 1;
+    game_board_sync(&game.board);
+    mu_assert("Heights are part of the key", empty != placement_skyline_key(&game.board, TETRO_I));
+    mu_assert("Last column is the low bits",
+              placement_skyline_key(&game.board, TETRO_I) == empty + 1);
+
+    /* Low stacks key on heights above the lowest column */
+    for (int x = 0; x < BOARD_WIDTH; x++) {
+        game.board.cells[BOARD_HEIGHT - 1][x] = 1;
+    }
+    game.board.cells[BOARD_HEIGHT - 2][9] = 1;
+    game_board_sync(&game.board);
+    mu_assert("Raised stack shares the key",
+              placement_skyline_key(&game.board, TETRO_I) == empty + 1);
+}
+
+/* Test: Cached answers equal a fresh search on random open boards */
+mu_test(test_cache_matches_search)
+{
+    PlacementCache *cache = placement_cache_create(64);
+    mu_assert("Cache should be created", cache != NULL);
+    GameState game;
+    game_init_seeded(&game, 1);
+    uint32_t rng = 96;
+
+    /* A few random skylines, visited in random order so they repeat */
+    int skylines[8][BOARD_WIDTH];
+    for (int i = 0; i < 8; i++) {
+        for (int x = 0; x < BOARD_WIDTH; x++) {
+            rng = rng * 1103515245u + 12345u;
+            skylines[i][x] = (int)((rng >> 16) % 12);
+        }
+    }
+
+    for (int round = 0; round < 400; round++) {
+        rng = rng * 1103515245u + 12345u;
+        /* Raised by up to four rows: low stacks share their entry */
+        int heights[BOARD_WIDTH];
+        for (int x = 0; x < BOARD_WIDTH; x++) {
+            heights[x] = skylines[(rng >> 16) % 8][x] + (int)((rng >> 24) % 5);
+        }
+        set_skyline(&game, heights);
+        TetrominoType type = (TetrominoType)((rng >> 20) % TETRO_COUNT);
+
+        placement_find(cache, &game, type, &list);
+        placement_enumerate(&game, type, &expected);
+        mu_assert("Cache must return the search result", same_lists(&list, &expected));
+    }
+
+    PlacementCacheStats stats;
+    placement_cache_stats(cache, &stats);
+    mu_assert_eq_int(400, (int)(stats.hits + stats.misses));
+    mu_assert("Repeated skylines should hit", stats.hits > 0);
+    mu_assert_eq_int(0, (int)stats.fallbacks);
+    placement_cache_destroy(cache);
+}
+
+/* Test: A skyline and its mirror share one cache entry */
+mu_test(test_cache_shares_mirror)
+{
+    PlacementCache *cache = placement_cache_create(0);
+    GameState game;
+    game_init_seeded(&game, 1);
+    int heights[BOARD_WIDTH] = { 0, 1, 4, 2, 2, 3, 0, 5, 1, 1 };
+    int mirrored[BOARD_WIDTH];
+    for (int x = 0; x < BOARD_WIDTH; x++) {
+        mirrored[x] = heights[BOARD_WIDTH - 1 - x];
+    }
+
+    set_skyline(&game, heights);
+    placement_find(cache, &game, TETRO_S, &list);
+    set_skyline(&game, mirrored);
+    placement_find(cache, &game, TETRO_Z, &list);
+    placement_enumerate(&game, TETRO_Z, &expected);
+    mu_assert("Mirrored hit must return the search result", same_lists(&list, &expected));
+
+    PlacementCacheStats stats;
+    placement_cache_stats(cache, &stats);
+    mu_assert_eq_int(1, (int)stats.misses);
+    mu_assert_eq_int(1, (int)stats.hits);
+    placement_cache_destroy(cache);
+}
+
+/* Test: Boards with overhangs bypass the cache */
+mu_test(test_cache_overhang_fallback)
+{
+    PlacementCache *cache = placement_cache_create(0);
+    GameState game;
+    game_init_seeded(&game, 1);
+    game.board.cells[BOARD_HEIGHT - 2][4] = 1;
+    game_board_sync(&game.board);
+
+    placement_find(cache, &game, TETRO_T, &list);
+    placement_find(cache, &game, TETRO_T, &list);
+    placement_enumerate(&game, TETRO_T, &expected);
+    mu_assert("Fallback must return the search result", same_lists(&list, &expected));
+
+    PlacementCacheStats stats;
+    placement_cache_stats(cache, &stats);
+    mu_assert_eq_int(2, (int)stats.fallbacks);
+    mu_assert_eq_int(0, (int)(stats.hits + stats.misses));
+    placement_cache_destroy(cache);
+}
+
+static void run_all_tests(void)
+{
+    printf("\nRunning Placement Module Tests...\n");
+    printf("=================================\n\n");
+
+    mu_run_test(test_enumerate_empty_board);
+    mu_run_test(test_placements_rest);
+    mu_run_test(test_enumerate_tuck);
+    mu_run_test(test_enumerate_blocked_spawn);
+    mu_run_test(test_skyline_key);
+    mu_run_test(test_cache_matches_search);
+    mu_run_test(test_cache_shares_mirror);
+    mu_run_test(test_cache_overhang_fallback);
+}
+
+int main(void)
+{
+    run_all_tests();
+    mu_print_summary();
+
+    if (mu_tests_failed == 0) {
+        printf("\nAll tests passed!\n");
+    }
+
+    return mu_return_status();
+}
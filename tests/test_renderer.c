@@ -8,6 +8,7 @@
 #include "../src/game.h"
 
 #include <ncurses.h>
+#include <string.h>
 
 /* Test: Renderer initialization and cleanup */
 mu_test(test_renderer_init_cleanup)
@@ -128,6 +129,16 @@ mu_test(test_renderer_draw_next_piece_l)
     mu_assert("draw_next_piece L should not crash", 1);
 }
 
+/* Test: Draw hold piece, empty and filled */
+mu_test(test_renderer_draw_hold_piece)
+{
+    renderer_init();
+    renderer_draw_hold_piece(TETRO_COUNT);
+    renderer_draw_hold_piece(TETRO_T);
+    renderer_cleanup();
+    mu_assert("draw_hold_piece should not crash", 1);
+}
+
 /* Test: Draw score with various values */
 mu_test(test_renderer_draw_score_zero)
 {
@@ -315,6 +326,211 @@ mu_test(test_renderer_draw_without_init)
     mu_assert("renderer functions without init should not crash", 1);
 }
 
+/* Test: Terminal output is counted only while counting is on */
+mu_test(test_renderer_bytes_written)
+{
+    GameState game;
+    game_init_seeded(&game, 1);
+
+    unsigned long before = renderer_bytes_written();
+    renderer_set_output_counting(1);
+    renderer_init();
+    renderer_draw_game(&game);
+    renderer_cleanup();
+    renderer_set_output_counting(0);
+    /* cleanup waits for the output thread, so everything is counted */
+    unsigned long after = renderer_bytes_written();
+    mu_assert("Drawing a frame should write bytes", after > before);
+
+    renderer_init();
+    renderer_draw_game(&game);
+    renderer_cleanup();
+    mu_assert("Plain output is not counted", renderer_bytes_written() == after);
+}
+
+/* Helper: Output tap that counts bytes and remembers a drawn label */
+static size_t tapped_bytes = 0;
+static int tapped_score = 0;
+static void count_output(const char *data, size_t length, void *ctx)
+{
+    (void)ctx;
+    tapped_bytes += length;
+    for (size_t i = 0; i + 5 <= length; i++) {
+        if (memcmp(data + i, "SCORE", 5) == 0) {
+            tapped_score = 1;
+        }
+    }
+}
+
+/* Test: The output tap sees the frame, and the renderer works again without it */
+mu_test(test_renderer_output_tap)
+{
+    GameState game;
+    game_init_seeded(&game, 1);
+
+    unsigned long counted = renderer_bytes_written();
+    renderer_set_output_tap(count_output, NULL);
+    renderer_init();
+    renderer_draw_game(&game);
+    renderer_cleanup();
+    renderer_set_output_tap(NULL, NULL);
+
+    mu_assert("Tap must receive the frame", tapped_bytes > 0);
+    mu_assert("Tapped bytes are counted once",
+              renderer_bytes_written() - counted == (unsigned long)tapped_bytes);
+    mu_assert("Tap must see the sidebar text", tapped_score);
+
+    size_t before = tapped_bytes;
+    renderer_init();
+    renderer_draw_game(&game);
+    renderer_cleanup();
+    mu_assert("Removed tap must not be called", tapped_bytes == before);
+}
+
+mu_test(test_renderer_layout_reference)
+{
+    RendererLayout layout;
+    renderer_compute_layout(80, 24, &layout);
+
+    mu_assert("80x24 must fit", layout.fits);
+    mu_assert("80x24 must show the sidebar", layout.sidebar);
+    mu_assert("80x24 has no room for the controls", !layout.show_controls);
+    mu_assert_eq_int(17, layout.board_x);
+    mu_assert_eq_int(1, layout.board_y);
+    mu_assert_eq_int(layout.board_x + BOARD_WIDTH_CHARS + SIDEBAR_GAP, layout.sidebar_x);
+    mu_assert_eq_int(-1, layout.status_y);
+}
+
+mu_test(test_renderer_layout_controls)
+{
+    RendererLayout layout;
+    renderer_compute_layout(100, 30, &layout);
+
+    mu_assert("100x30 must show the controls", layout.show_controls);
+    mu_assert_eq_int(27, layout.board_x);
+    mu_assert_eq_int(1, layout.board_y);
+}
+
+mu_test(test_renderer_layout_collapsed)
+{
+    RendererLayout layout;
+    renderer_compute_layout(30, 30, &layout);
+
+    mu_assert("30x30 must fit", layout.fits);
+    mu_assert("30 columns must collapse the sidebar", !layout.sidebar);
+    mu_assert("Collapsed layout has no controls", !layout.show_controls);
+    mu_assert_eq_int(4, layout.board_x);
+    mu_assert_eq_int(3, layout.board_y);
+    mu_assert_eq_int(layout.board_y + BOARD_HEIGHT_CHARS, layout.status_y);
+
+    /* Exactly board-sized: no status line */
+    renderer_compute_layout(BOARD_WIDTH_CHARS, BOARD_HEIGHT_CHARS, &layout);
+    mu_assert("Board-sized terminal must fit", layout.fits);
+    mu_assert_eq_int(0, layout.board_x);
+    mu_assert_eq_int(-1, layout.status_y);
+}
+
+mu_test(test_renderer_layout_too_small)
+{
+    RendererLayout layout;
+    renderer_compute_layout(10, 10, &layout);
+    mu_assert("10x10 must not fit", !layout.fits);
+
+    renderer_compute_layout(BOARD_WIDTH_CHARS - 1, 40, &layout);
+    mu_assert("Too narrow must not fit", !layout.fits);
+    mu_assert_eq_int(BOARD_WIDTH_CHARS - 1, layout.cols);
+}
+
+mu_test(test_renderer_layout_cached)
+{
+    GameState game;
+    game_init_seeded(&game, 1);
+
+    renderer_init();
+    const RendererLayout *layout = renderer_get_layout();
+    int cols = COLS, rows = LINES;
+    renderer_draw_game(&game);
+    renderer_draw_game(&game);
+    renderer_cleanup();
+
+    mu_assert("Layout must be computed at init", layout->cols == cols && layout->rows == rows);
+}
+
+mu_test(test_renderer_clear_animation)
+{
+    GameEvent event = { .type = GAME_EVENT_LINES_CLEARED };
+    event.clear.lines = 2;
+    event.clear.rows_mask = (1 << 18) | (1 << 19);
+
+    renderer_animate_event(&event, 1000);
+    const RendererAnimation *animation = renderer_get_animation();
+    mu_assert_eq_int(event.clear.rows_mask, animation->clear_rows);
+
+    mu_assert("Wipe must run right after the clear", renderer_advance_animations(1000));
+    mu_assert_eq_int(0, animation->clear_step);
+
+    mu_assert("Wipe must still run halfway", renderer_advance_animations(1000 + RENDERER_CLEAR_ANIM_NS / 2));
+    mu_assert("Wipe must have advanced halfway", animation->clear_step > 0 && animation->clear_step <= BOARD_WIDTH / 2);
+
+    mu_assert("Wipe must end after its duration", !renderer_advance_animations(1000 + RENDERER_CLEAR_ANIM_NS));
+    mu_assert_eq_int(0, animation->clear_rows);
+}
+
+mu_test(test_renderer_lock_animation)
+{
+    GameEvent lock = { .type = GAME_EVENT_PIECE_LOCKED };
+    for (int i = 0; i < 4; i++) {
+        lock.lock.cell_x[i] = i;
+        lock.lock.cell_y[i] = BOARD_HEIGHT - 1;
+    }
+
+    renderer_animate_event(&lock, 0);
+    const RendererAnimation *animation = renderer_get_animation();
+    mu_assert("Lock must start the flash", animation->lock_active);
+    mu_assert_eq_int(3, animation->lock_x[3]);
+    mu_assert("Flash must run before its duration", renderer_advance_animations(RENDERER_LOCK_ANIM_NS - 1));
+    mu_assert("Flash must end after its duration", !renderer_advance_animations(RENDERER_LOCK_ANIM_NS));
+
+    /* A clear right after the lock replaces the flash with the wipe */
+    GameEvent clear = { .type = GAME_EVENT_LINES_CLEARED };
+    clear.clear.lines = 1;
+    clear.clear.rows_mask = 1 << (BOARD_HEIGHT - 1);
+    renderer_animate_event(&lock, 0);
+    renderer_animate_event(&clear, 0);
+    mu_assert("Clear must end the lock flash", !animation->lock_active);
+    mu_assert("Clear must start the wipe", animation->clear_rows != 0);
+    renderer_advance_animations(RENDERER_CLEAR_ANIM_NS);
+
+    /* Unrelated events start nothing */
+    GameEvent over = { .type = GAME_EVENT_GAME_OVER };
+    renderer_animate_event(&over, 0);
+    renderer_animate_event(NULL, 0);
+    mu_assert("Other events must not animate", !renderer_advance_animations(0));
+}
+
+mu_test(test_renderer_draw_animating)
+{
+    GameState game;
+    game_init_seeded(&game, 1);
+    for (int x = 0; x < BOARD_WIDTH; x++) {
+        game.board.cells[BOARD_HEIGHT - 1][x] = COLOR_I;
+    }
+
+    GameEvent clear = { .type = GAME_EVENT_LINES_CLEARED };
+    clear.clear.lines = 1;
+    clear.clear.rows_mask = 1 << (BOARD_HEIGHT - 1);
+
+    renderer_init();
+    renderer_animate_event(&clear, 0);
+    for (uint64_t t = 0; renderer_advance_animations(t); t += RENDERER_CLEAR_ANIM_NS / 8) {
+        renderer_draw_game(&game);
+    }
+    renderer_draw_game(&game);
+    renderer_cleanup();
+
+    mu_assert("Wipe must be over", renderer_get_animation()->clear_rows == 0);
+}
+
 /* Test suite */
 mu_suite(renderer_tests)
 {
@@ -332,6 +548,7 @@ mu_suite(renderer_tests)
     mu_run_test(test_renderer_draw_next_piece_z);
     mu_run_test(test_renderer_draw_next_piece_j);
     mu_run_test(test_renderer_draw_next_piece_l);
+    mu_run_test(test_renderer_draw_hold_piece);
     mu_run_test(test_renderer_draw_score_zero);
     mu_run_test(test_renderer_draw_score_typical);
     mu_run_test(test_renderer_draw_score_high);
@@ -346,6 +563,16 @@ mu_suite(renderer_tests)
     mu_run_test(test_renderer_full_sequence);
     mu_run_test(test_renderer_draw_board_filled);
     mu_run_test(test_renderer_draw_without_init);
+    mu_run_test(test_renderer_bytes_written);
+    mu_run_test(test_renderer_output_tap);
+    mu_run_test(test_renderer_layout_reference);
+    mu_run_test(test_renderer_layout_controls);
+    mu_run_test(test_renderer_layout_collapsed);
+    mu_run_test(test_renderer_layout_too_small);
+    mu_run_test(test_renderer_layout_cached);
+    mu_run_test(test_renderer_clear_animation);
+    mu_run_test(test_renderer_lock_animation);
+    mu_run_test(test_renderer_draw_animating);
 }
 
 int main(void)
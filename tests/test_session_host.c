@@ -0,0 +1,298 @@
+/**
+ * @file test_session_host.c
+ * @brief Unit tests for the headless multi-session host
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "minunit.h"
+#include "../src/session_host.h"
+
+#define POOL_THREADS 4
+
+/* Helper: Driver that only hard-drops, so games end quickly */
+static InputAction drop_driver(const GameState *game, uint64_t *script_state, void *ctx)
+{
+    (void)game;
+    (void)script_state;
+    (void)ctx;
+    return INPUT_HARD_DROP;
+}
+
+/* Helper: Driver that counts its calls (serial hosts only) */
+static InputAction counting_driver(const GameState *game, uint64_t *script_state, void *ctx)
+{
+    (void)game;
+    (void)script_state;
+    (*(int *)ctx)++;
+    return INPUT_NONE;
+}
+
+/* Helper: Two sessions played the same game */
+static int sessions_equal(const Session *a, const Session *b)
+{
+    return a->game.score == b->game.score &&
+           a->game.lines == b->game.lines &&
+           a->game.current.type == b->game.current.type &&
+           a->game.current.x == b->game.current.x &&
+           a->game.current.y == b->game.current.y &&
+           a->pieces == b->pieces &&
+           a->games_finished == b->games_finished &&
+           memcmp(&a->game.board, &b->game.board, sizeof(Board)) == 0;
+}
+
+/* Test: Host creation with defaults */
+mu_test(test_host_create_destroy)
+{
+    SessionHost *host = session_host_create(NULL);
+
+    mu_assert_not_null(host);
+    mu_assert_eq_int(0, (int)session_host_count(host));
+    session_host_destroy(host);
+    session_host_destroy(NULL);
+}
+
+/* Test: New session is live and running */
+mu_test(test_create_session)
+{
+    SessionHost *host = session_host_create(NULL);
+    SessionId id = session_host_create_session(host, 42);
+
+    mu_assert("Session id must be valid", id != SESSION_INVALID);
+    mu_assert_eq_int(1, (int)session_host_count(host));
+
+    const Session *session = session_host_get(host, id);
+    mu_assert_not_null(session);
+    mu_assert_eq_int(1, session->game.is_running);
+    mu_assert("Seed must be stored", session->seed == 42);
+    session_host_destroy(host);
+}
+
+/* Test: Sessions spanning several slabs get distinct, stable slots */
+mu_test(test_sessions_span_slabs)
+{
+    enum { COUNT = SESSION_SLAB_SIZE * 3 + 5 };
+    SessionHost *host = session_host_create(NULL);
+    static SessionId ids[COUNT];
+    static const Session *ptrs[COUNT];
+
+    for (int i = 0; i < COUNT; i++) {
+        ids[i] = session_host_create_session(host, (uint64_t)i);
+        ptrs[i] = session_host_get(host, ids[i]);
+    }
+    mu_assert_eq_int(COUNT, (int)session_host_count(host));
+
+    /* Later slabs must not move earlier sessions */
+    for (int i = 0; i < COUNT; i++) {
+        mu_assert("Session must not move", session_host_get(host, ids[i]) == ptrs[i]);
+        for (int j = 0; j < i; j++) {
+            mu_assert("Ids must be unique", ids[i] != ids[j]);
+        }
+    }
+    session_host_destroy(host);
+}
+
+/* Test: Freed slot is reused before the host grows */
+mu_test(test_destroy_session_reuses_slot)
+{
+    SessionHost *host = session_host_create(NULL);
+    SessionId a = session_host_create_session(host, 1);
+    SessionId b = session_host_create_session(host, 2);
+
+    session_host_destroy_session(host, a);
+    mu_assert_eq_int(1, (int)session_host_count(host));
+    mu_assert_null(session_host_get(host, a));
+
+    SessionId c = session_host_create_session(host, 3);
+    mu_assert("Freed slot should be reused", c == a);
+    mu_assert_not_null(session_host_get(host, b));
+    session_host_destroy(host);
+}
+
+/* Test: Unknown and repeated destroys are ignored */
+mu_test(test_destroy_invalid_session)
+{
+    SessionHost *host = session_host_create(NULL);
+    SessionId id = session_host_create_session(host, 7);
+
+    session_host_destroy_session(host, SESSION_INVALID);
+    session_host_destroy_session(host, 123456);
+    session_host_destroy_session(host, id);
+    session_host_destroy_session(host, id);
+
+    mu_assert_eq_int(0, (int)session_host_count(host));
+    mu_assert_null(session_host_get(host, 123456));
+    session_host_destroy(host);
+}
+
+/* Test: Ticks let the scripted driver lock pieces */
+mu_test(test_tick_advances_games)
+{
+    SessionHost *host = session_host_create(NULL);
+    for (int i = 0; i < 10; i++) {
+        session_host_create_session(host, (uint64_t)i);
+    }
+    for (int t = 0; t < 200; t++) {
+        session_host_tick(host);
+    }
+
+    SessionTotals totals;
+    session_host_totals(host, &totals);
+    mu_assert_eq_int(10, (int)totals.sessions);
+    mu_assert("Scripted sessions should lock pieces", totals.pieces > 10);
+    session_host_destroy(host);
+}
+
+/* Test: Finished games restart when configured */
+mu_test(test_game_over_restarts)
+{
+    SessionHostConfig config = { NULL, drop_driver, NULL, 0, 1, NULL };
+    SessionHost *host = session_host_create(&config);
+    SessionId id = session_host_create_session(host, 99);
+
+    for (int t = 0; t < 500; t++) {
+        session_host_tick(host);
+    }
+
+    const Session *session = session_host_get(host, id);
+    mu_assert("Hard-drop-only games must end", session->games_finished >= 2);
+    mu_assert_eq_int(1, session->game.is_running);
+    session_host_destroy(host);
+}
+
+/* Test: Finished games stay over without restart */
+mu_test(test_game_over_without_restart)
+{
+    SessionHostConfig config = { NULL, drop_driver, NULL, 0, 0, NULL };
+    SessionHost *host = session_host_create(&config);
+    SessionId id = session_host_create_session(host, 99);
+
+    for (int t = 0; t < 500; t++) {
+        session_host_tick(host);
+    }
+
+    const Session *session = session_host_get(host, id);
+    mu_assert_eq_int(1, (int)session->games_finished);
+    mu_assert_eq_int(0, session->game.is_running);
+    session_host_destroy(host);
+}
+
+/* Test: Custom driver is called once per session and tick */
+mu_test(test_custom_driver)
+{
+    int calls = 0;
+    SessionHostConfig config = { NULL, counting_driver, &calls, 0, 1, NULL };
+    SessionHost *host = session_host_create(&config);
+
+    for (int i = 0; i < 5; i++) {
+        session_host_create_session(host, (uint64_t)i);
+    }
+    for (int t = 0; t < 3; t++) {
+        session_host_tick(host);
+    }
+
+    mu_assert_eq_int(15, calls);
+    session_host_destroy(host);
+}
+
+/* Test: Batches on a thread pool give the same games as a serial run */
+mu_test(test_parallel_matches_serial)
+{
+    enum { COUNT = 500, TICKS = 300 };
+    ThreadPoolConfig pool_config = { POOL_THREADS, 0 };
+    ThreadPool *pool = threadpool_create(&pool_config);
+    SessionHostConfig parallel_config = { pool, NULL, NULL, 0, 1, NULL };
+    SessionHost *serial = session_host_create(NULL);
+    SessionHost *parallel = session_host_create(&parallel_config);
+    static SessionId ids[COUNT];
+
+    for (int i = 0; i < COUNT; i++) {
+        ids[i] = session_host_create_session(serial, 1000 + (uint64_t)i);
+        session_host_create_session(parallel, 1000 + (uint64_t)i);
+    }
+    for (int t = 0; t < TICKS; t++) {
+        session_host_tick(serial);
+        session_host_tick(parallel);
+    }
+
+    for (int i = 0; i < COUNT; i++) {
+        mu_assert("Parallel session must match serial session",
+                  sessions_equal(session_host_get(serial, ids[i]),
+                                 session_host_get(parallel, ids[i])));
+    }
+
+    session_host_destroy(serial);
+    session_host_destroy(parallel);
+    threadpool_destroy(pool);
+}
+
+/* Test: Tick statistics are ordered and resettable */
+mu_test(test_tick_stats)
+{
+    SessionHost *host = session_host_create(NULL);
+    SessionTickStats stats;
+
+    session_host_tick_stats(host, &stats);
+    mu_assert_eq_int(0, (int)stats.samples);
+
+    session_host_create_session(host, 5);
+    for (int t = 0; t < 20; t++) {
+        session_host_tick(host);
+    }
+    session_host_tick_stats(host, &stats);
+    mu_assert_eq_int(20, (int)stats.samples);
+    mu_assert("Percentiles must be ordered",
+              stats.p50 <= stats.p90 && stats.p90 <= stats.p99 && stats.p99 <= stats.max);
+
+    session_host_reset_stats(host);
+    session_host_tick_stats(host, &stats);
+    mu_assert_eq_int(0, (int)stats.samples);
+    session_host_destroy(host);
+}
+
+/* Test: Paced run records one sample per tick */
+mu_test(test_paced_run)
+{
+    SessionHostConfig config = { NULL, NULL, NULL, 1000000ULL, 1, NULL };
+    SessionHost *host = session_host_create(&config);
+    SessionTickStats stats;
+
+    session_host_create_session(host, 11);
+    session_host_run(host, 5);
+    session_host_tick_stats(host, &stats);
+
+    mu_assert_eq_int(5, (int)stats.samples);
+    session_host_destroy(host);
+}
+
+/* Test suite runner */
+static void run_all_tests(void)
+{
+    printf("\nRunning Session Host Module Tests...\n");
+    printf("====================================\n\n");
+
+    mu_run_test(test_host_create_destroy);
+    mu_run_test(test_create_session);
+    mu_run_test(test_sessions_span_slabs);
+    mu_run_test(test_destroy_session_reuses_slot);
+    mu_run_test(test_destroy_invalid_session);
+    mu_run_test(test_tick_advances_games);
+    mu_run_test(test_game_over_restarts);
+    mu_run_test(test_game_over_without_restart);
+    mu_run_test(test_custom_driver);
+    mu_run_test(test_parallel_matches_serial);
+    mu_run_test(test_tick_stats);
+    mu_run_test(test_paced_run);
+}
+
+int main(void)
+{
+    run_all_tests();
+    mu_print_summary();
+
+    if (mu_tests_failed == 0) {
+        printf("\nAll tests passed!\n");
+    }
+
+    return mu_return_status();
+}
@@ -0,0 +1,338 @@
+/**
+ * @file test_spectator.c
+ * @brief Unit tests for the tiled multi-board view
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "minunit.h"
+#include "../src/game.h"
+#include "../src/renderer.h"
+#include "../src/spectator.h"
+
+#define GAMES 4
+#define CELLS (BOARD_WIDTH * BOARD_HEIGHT)
+
+static GameState games[GAMES];
+static const GameState *boards[GAMES];
+
+/* Helper: Seeds the test games and a view that shows all of them */
+static SpectatorView *setup(void)
+{
+    for (int i = 0; i < GAMES; i++) {
+        game_init_seeded(&games[i], (uint64_t)i + 1);
+        boards[i] = &games[i];
+    }
+    SpectatorView *view = spectator_create(GAMES, SPECTATOR_GLYPHS_COMPACT);
+    if (view != NULL) {
+        spectator_layout(view, 200, 50);
+    }
+    return view;
+}
+
+/* Test: Tiles fill rows left to right */
+mu_test(test_layout_wide)
+{
+    SpectatorView *view = spectator_create(16, SPECTATOR_GLYPHS_WIDE);
+    mu_assert_not_null(view);
+    int x, y;
+
+    spectator_layout(view, 80, 24);
+    mu_assert_eq_int(3, (int)spectator_visible(view));
+    mu_assert_eq_int(1, spectator_tile_origin(view, 2, &x, &y));
+    mu_assert_eq_int(2 * (BOARD_WIDTH * 2 + 2 + SPECTATOR_TILE_GAP), x);
+    mu_assert_eq_int(0, y);
+    mu_assert_eq_int(0, spectator_tile_origin(view, 3, &x, &y));
+
+    spectator_layout(view, 80, 2 * (BOARD_HEIGHT + 3));
+    mu_assert_eq_int(6, (int)spectator_visible(view));
+    mu_assert_eq_int(1, spectator_tile_origin(view, 3, &x, &y));
+    mu_assert_eq_int(0, x);
+    mu_assert_eq_int(BOARD_HEIGHT + 3, y);
+    spectator_destroy(view);
+}
+
+/* Test: Compact glyphs fit more boards per row */
+mu_test(test_layout_compact)
+{
+    SpectatorView *view = spectator_create(64, SPECTATOR_GLYPHS_WIDE);
+    mu_assert_not_null(view);
+
+    spectator_layout(view, 160, 48);
+    mu_assert_eq_int(2 * 7, (int)spectator_visible(view));
+    spectator_set_glyphs(view, SPECTATOR_GLYPHS_COMPACT);
+    mu_assert_eq_int(2 * 12, (int)spectator_visible(view));
+
+    spectator_layout(view, 1000, 1000);
+    mu_assert("Visible boards are capped at the capacity", spectator_visible(view) == 64);
+    spectator_destroy(view);
+}
+
+/* Test: Packed glyphs shrink the tiles */
+mu_test(test_layout_packed)
+{
+    SpectatorView *view = spectator_create(64, SPECTATOR_GLYPHS_HALF);
+    mu_assert_not_null(view);
+    int width, height;
+
+    spectator_tile_size(view, &width, &height);
+    mu_assert_eq_int(BOARD_WIDTH + 2 + SPECTATOR_TILE_GAP, width);
+    mu_assert_eq_int(BOARD_HEIGHT / 2 + 3, height);
+
+    spectator_set_glyphs(view, SPECTATOR_GLYPHS_BRAILLE);
+    spectator_tile_size(view, &width, &height);
+    mu_assert_eq_int(BOARD_WIDTH / 2 + 2 + SPECTATOR_TILE_GAP, width);
+    mu_assert_eq_int(BOARD_HEIGHT / 4 + 3, height);
+
+    spectator_layout(view, 80, 24);
+    mu_assert_eq_int(10 * 3, (int)spectator_visible(view));
+    spectator_destroy(view);
+}
+
+/* Test: Packed modes send far fewer characters for the same boards */
+mu_test(test_packed_glyph_counts)
+{
+    SpectatorView *view = setup();
+    mu_assert_not_null(view);
+    SpectatorStats before, after;
+
+    spectator_set_glyphs(view, SPECTATOR_GLYPHS_HALF);
+    spectator_draw(view, boards, GAMES);
+    spectator_stats(view, &after);
+    mu_assert_eq_int(GAMES * CELLS / 2, (int)after.glyphs_drawn);
+
+    before = after;
+    spectator_set_glyphs(view, SPECTATOR_GLYPHS_BRAILLE);
+    spectator_draw(view, boards, GAMES);
+    spectator_stats(view, &after);
+    mu_assert_eq_int(GAMES * CELLS / 8, (int)(after.glyphs_drawn - before.glyphs_drawn));
+
+    before = after;
+    mu_assert_eq_int(1, game_move_current(&games[0], 1, 0));
+    spectator_draw(view, boards, GAMES);
+    spectator_stats(view, &after);
+    mu_assert("A shift touches at most a few braille glyphs",
+              after.glyphs_drawn - before.glyphs_drawn <= 4);
+    spectator_destroy(view);
+}
+
+/* Test: A terminal smaller than one tile shows nothing */
+mu_test(test_layout_too_small)
+{
+    SpectatorView *view = setup();
+    mu_assert_not_null(view);
+    SpectatorStats stats;
+
+    spectator_layout(view, 10, 10);
+    mu_assert_eq_int(0, (int)spectator_visible(view));
+    spectator_draw(view, boards, GAMES);
+    spectator_stats(view, &stats);
+    mu_assert("No board drawn", stats.boards_drawn == 0 && stats.glyphs_drawn == 0);
+    mu_assert("Frame still counted", stats.frames == 1);
+    spectator_destroy(view);
+}
+
+/* Test: The first frame draws every cell of every board */
+mu_test(test_first_frame_draws_all)
+{
+    SpectatorView *view = setup();
+    mu_assert_not_null(view);
+    SpectatorStats stats;
+
+    spectator_draw(view, boards, GAMES);
+    spectator_stats(view, &stats);
+    mu_assert_eq_int(GAMES, (int)stats.boards_drawn);
+    mu_assert_eq_int(GAMES * CELLS, (int)stats.glyphs_drawn);
+    spectator_destroy(view);
+}
+
+/* Test: An unchanged frame skips every board */
+mu_test(test_unchanged_frame_skips)
+{
+    SpectatorView *view = setup();
+    mu_assert_not_null(view);
+    SpectatorStats before, after;
+
+    spectator_draw(view, boards, GAMES);
+    spectator_stats(view, &before);
+    spectator_draw(view, boards, GAMES);
+    spectator_stats(view, &after);
+
+    mu_assert_eq_int(GAMES, (int)(after.boards_skipped - before.boards_skipped));
+    mu_assert_eq_int(0, (int)(after.boards_drawn - before.boards_drawn));
+    mu_assert_eq_int(0, (int)(after.glyphs_drawn - before.glyphs_drawn));
+    spectator_destroy(view);
+}
+
+/* Test: Moving one piece redraws only that piece's old and new cells */
+mu_test(test_move_redraws_changed_cells)
+{
+    SpectatorView *view = setup();
+    mu_assert_not_null(view);
+    SpectatorStats before, after;
+
+    spectator_draw(view, boards, GAMES);
+    spectator_stats(view, &before);
+    mu_assert_eq_int(1, game_move_current(&games[2], 0, 1));
+    spectator_draw(view, boards, GAMES);
+    spectator_stats(view, &after);
+
+    unsigned long cells = after.glyphs_drawn - before.glyphs_drawn;
+    mu_assert_eq_int(1, (int)(after.boards_drawn - before.boards_drawn));
+    mu_assert_eq_int(GAMES - 1, (int)(after.boards_skipped - before.boards_skipped));
+    mu_assert("Some cells must change", cells > 0);
+    mu_assert("At most the old and new piece cells", cells <= 8);
+    spectator_destroy(view);
+}
+
+/* Test: A hard drop redraws the piece's path ends and the new spawn */
+mu_test(test_hard_drop_redraws_few_cells)
+{
+    SpectatorView *view = setup();
+    mu_assert_not_null(view);
+    SpectatorStats before, after;
+
+    spectator_draw(view, boards, GAMES);
+    spectator_stats(view, &before);
+    game_hard_drop(&games[0]);
+    spectator_draw(view, boards, GAMES);
+    spectator_stats(view, &after);
+
+    unsigned long cells = after.glyphs_drawn - before.glyphs_drawn;
+    mu_assert("Locked piece plus respawn", cells > 0 && cells <= 12);
+    spectator_destroy(view);
+}
+
+/* Test: A game re-initialized in place is not mistaken for unchanged */
+mu_test(test_reinit_detected)
+{
+    SpectatorView *view = setup();
+    mu_assert_not_null(view);
+    SpectatorStats before, after;
+
+    game_hard_drop(&games[1]);
+    spectator_draw(view, boards, GAMES);
+    spectator_stats(view, &before);
+    game_init_seeded(&games[1], 99);
+    spectator_draw(view, boards, GAMES);
+    spectator_stats(view, &after);
+
+    mu_assert_eq_int(1, (int)(after.boards_drawn - before.boards_drawn));
+    mu_assert("The locked piece must disappear", after.glyphs_drawn - before.glyphs_drawn >= 4);
+    spectator_destroy(view);
+}
+
+/* Test: Invalidation and a changed board count force a full redraw */
+mu_test(test_invalidate_redraws_all)
+{
+    SpectatorView *view = setup();
+    mu_assert_not_null(view);
+    SpectatorStats before, after;
+
+    spectator_draw(view, boards, GAMES);
+    spectator_stats(view, &before);
+    spectator_invalidate(view);
+    spectator_draw(view, boards, GAMES);
+    spectator_stats(view, &after);
+    mu_assert_eq_int(GAMES * CELLS, (int)(after.glyphs_drawn - before.glyphs_drawn));
+
+    before = after;
+    spectator_draw(view, boards, GAMES - 1);
+    spectator_stats(view, &after);
+    mu_assert_eq_int((GAMES - 1) * CELLS, (int)(after.glyphs_drawn - before.glyphs_drawn));
+    spectator_destroy(view);
+}
+
+/* Test: NULL entries show an empty board */
+mu_test(test_null_board)
+{
+    SpectatorView *view = setup();
+    mu_assert_not_null(view);
+    SpectatorStats before, after;
+    const GameState *partial[GAMES] = { &games[0], NULL, &games[2], NULL };
+
+    spectator_draw(view, partial, GAMES);
+    spectator_stats(view, &before);
+    mu_assert_eq_int(GAMES * CELLS, (int)before.glyphs_drawn);
+    spectator_draw(view, partial, GAMES);
+    spectator_stats(view, &after);
+    mu_assert_eq_int(GAMES, (int)(after.boards_skipped - before.boards_skipped));
+    spectator_destroy(view);
+}
+
+/* Test: Drawing into a live ncurses screen */
+mu_test(test_draw_with_renderer)
+{
+    SpectatorView *view = setup();
+    mu_assert_not_null(view);
+    SpectatorStats stats;
+
+    renderer_init();
+    spectator_layout(view, 200, 50);
+    spectator_draw(view, boards, GAMES);
+    game_move_current(&games[0], 1, 0);
+    game_hard_drop(&games[3]);
+    spectator_draw(view, boards, GAMES);
+    renderer_cleanup();
+
+    spectator_stats(view, &stats);
+    mu_assert_eq_int(2, (int)stats.frames);
+    mu_assert_eq_int(GAMES + 2, (int)stats.boards_drawn);
+    spectator_destroy(view);
+}
+
+/* Test: Every game function that changes what is shown bumps the revision */
+mu_test(test_game_revision)
+{
+    GameState game;
+    game_init_seeded(&game, 7);
+    unsigned int revision = game.revision;
+
+    mu_assert_eq_int(1, game_move_current(&game, 0, 1));
+    mu_assert("Move bumps", game.revision != revision);
+    revision = game.revision;
+    mu_assert_eq_int(0, game_move_current(&game, -BOARD_WIDTH, 0));
+    mu_assert("Blocked move does not bump", game.revision == revision);
+    game_set_next_type(&game, TETRO_I);
+    mu_assert("Next piece bumps", game.revision != revision);
+    revision = game.revision;
+    game_hold_piece(&game);
+    mu_assert("Hold bumps", game.revision != revision);
+    revision = game.revision;
+    game_hard_drop(&game);
+    mu_assert("Lock bumps", game.revision != revision);
+}
+
+/* Test suite runner */
+static void run_all_tests(void)
+{
+    printf("\nRunning Spectator Module Tests...\n");
+    printf("================================\n\n");
+
+    mu_run_test(test_layout_wide);
+    mu_run_test(test_layout_compact);
+    mu_run_test(test_layout_packed);
+    mu_run_test(test_packed_glyph_counts);
+    mu_run_test(test_layout_too_small);
+    mu_run_test(test_first_frame_draws_all);
+    mu_run_test(test_unchanged_frame_skips);
+    mu_run_test(test_move_redraws_changed_cells);
+    mu_run_test(test_hard_drop_redraws_few_cells);
+    mu_run_test(test_reinit_detected);
+    mu_run_test(test_invalidate_redraws_all);
+    mu_run_test(test_null_board);
+    mu_run_test(test_draw_with_renderer);
+    mu_run_test(test_game_revision);
+}
+
+int main(void)
+{
+    run_all_tests();
+    mu_print_summary();
+
+    if (mu_tests_failed == 0) {
+        printf("\nAll tests passed!\n");
+    }
+
+    return mu_return_status();
+}
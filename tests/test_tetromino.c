@@ -262,6 +262,27 @@ mu_test(test_j_l_different)
     mu_assert_eq_int(1, l_shape[0][2]);
 }
 
+/* Test: Row masks describe the same cells as the shape matrices */
+mu_test(test_row_masks_match_shapes)
+{
+    for (int type = 0; type < TETRO_COUNT; type++) {
+        for (int rot = 0; rot < ROTATION_COUNT; rot++) {
+            const int (*shape)[TETRO_MATRIX_SIZE] = tetromino_get_shape(type, rot);
+            const unsigned char *masks = tetromino_get_row_masks(type, rot);
+            mu_assert_not_null(masks);
+            
+            for (int row = 0; row < TETRO_MATRIX_SIZE; row++) {
+                for (int col = 0; col < TETRO_MATRIX_SIZE; col++) {
+                    mu_assert_eq_int(shape[row][col], (masks[row] >> col) & 1);
+                }
+            }
+        }
+    }
+    
+    mu_assert_null(tetromino_get_row_masks(TETRO_COUNT, 0));
+    mu_assert_null(tetromino_get_row_masks(TETRO_I, 4));
+}
+
 /* Test suite runner */
 static void run_all_tests(void)
 {
@@ -286,6 +307,7 @@ static void run_all_tests(void)
     mu_run_test(test_rotation_is_valid);
     mu_run_test(test_s_z_different);
     mu_run_test(test_j_l_different);
+    mu_run_test(test_row_masks_match_shapes);
 }
 
 int main(void)
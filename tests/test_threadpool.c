@@ -0,0 +1,305 @@
+/**
+ * @file test_threadpool.c
+ * @brief Unit tests for the work-stealing thread pool
+ */
+
+#include <stdio.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <time.h>
+#include "minunit.h"
+#include "../src/threadpool.h"
+
+#define POOL_THREADS 4
+
+/* Helper: Task that increments a shared counter */
+static void count_task(void *arg)
+{
+    atomic_fetch_add((atomic_int *)arg, 1);
+}
+
+/* Helper: Recursive fork/join Fibonacci */
+typedef struct {
+    ThreadPool *pool;
+    int n;
+    long result;
+} FibTask;
+
+static void fib_task(void *arg)
+{
+    FibTask *task = arg;
+    if (task->n < 2) {
+        task->result = task->n;
+        return;
+    }
+
+    FibTask left = { task->pool, task->n - 1, 0 };
+    FibTask right = { task->pool, task->n - 2, 0 };
+    ThreadPoolGroup group;
+    threadpool_group_init(&group);
+    threadpool_spawn(task->pool, &group, fib_task, &left);
+    fib_task(&right);
+    threadpool_wait(task->pool, &group);
+    task->result = left.result + right.result;
+}
+
+/* Helper: parallel_for body marking each index */
+static void mark_range(void *ctx, size_t begin, size_t end)
+{
+    atomic_int *marks = ctx;
+    for (size_t i = begin; i < end; i++) {
+        atomic_fetch_add(&marks[i], 1);
+    }
+}
+
+/* Helper: Task recording the worker it ran on */
+static void record_worker(void *arg)
+{
+    *(int *)arg = threadpool_current_worker();
+}
+
+/* Test: Pool creation with explicit size */
+mu_test(test_pool_create_destroy)
+{
+    ThreadPoolConfig config = { POOL_THREADS, 0 };
+    ThreadPool *pool = threadpool_create(&config);
+
+    mu_assert_not_null(pool);
+    mu_assert_eq_int(POOL_THREADS, threadpool_size(pool));
+    threadpool_destroy(pool);
+}
+
+/* Test: Default configuration uses at least one worker */
+mu_test(test_pool_default_config)
+{
+    ThreadPool *pool = threadpool_create(NULL);
+
+    mu_assert_not_null(pool);
+    mu_assert("Default pool should have workers", threadpool_size(pool) >= 1);
+    threadpool_destroy(pool);
+}
+
+/* Test: Destroying NULL is a no-op */
+mu_test(test_pool_destroy_null)
+{
+    threadpool_destroy(NULL);
+    mu_assert("destroy(NULL) should not crash", 1);
+}
+
+/* Test: Calling thread is not a worker */
+mu_test(test_current_worker_outside)
+{
+    mu_assert_eq_int(-1, threadpool_current_worker());
+}
+
+/* Test: Tasks submitted from outside all run */
+mu_test(test_spawn_external)
+{
+    ThreadPoolConfig config = { POOL_THREADS, 0 };
+    ThreadPool *pool = threadpool_create(&config);
+    ThreadPoolGroup group;
+    atomic_int counter = 0;
+
+    threadpool_group_init(&group);
+    for (int i = 0; i < 1000; i++) {
+        mu_assert_eq_int(1, threadpool_spawn(pool, &group, count_task, &counter));
+    }
+    threadpool_wait(pool, &group);
+
+    mu_assert_eq_int(1000, atomic_load(&counter));
+    threadpool_destroy(pool);
+}
+
+/* Test: Tasks run on pool workers */
+mu_test(test_task_runs_on_worker)
+{
+    ThreadPoolConfig config = { POOL_THREADS, 0 };
+    ThreadPool *pool = threadpool_create(&config);
+    ThreadPoolGroup group;
+    int worker = -2;
+
+    threadpool_group_init(&group);
+    threadpool_spawn(pool, &group, record_worker, &worker);
+    threadpool_wait(pool, &group);
+
+    /* The waiting thread may run the task itself (-1) or a worker does */
+    mu_assert("Task must report a valid worker index",
+              worker >= -1 && worker < POOL_THREADS);
+    threadpool_destroy(pool);
+}
+
+/* Test: Nested fork/join computes the right result */
+mu_test(test_fork_join_fib)
+{
+    ThreadPoolConfig config = { POOL_THREADS, 0 };
+    ThreadPool *pool = threadpool_create(&config);
+    FibTask root = { pool, 20, 0 };
+    ThreadPoolGroup group;
+
+    threadpool_group_init(&group);
+    threadpool_spawn(pool, &group, fib_task, &root);
+    threadpool_wait(pool, &group);
+
+    mu_assert("fib(20) should be 6765", root.result == 6765);
+    threadpool_destroy(pool);
+}
+
+/* Test: parallel_for visits every index exactly once */
+mu_test(test_parallel_for_covers_range)
+{
+    ThreadPoolConfig config = { POOL_THREADS, 0 };
+    ThreadPool *pool = threadpool_create(&config);
+    enum { COUNT = 10007 };
+    static atomic_int marks[COUNT];
+
+    for (int i = 0; i < COUNT; i++) {
+        atomic_init(&marks[i], 0);
+    }
+    threadpool_parallel_for(pool, COUNT, 64, mark_range, marks);
+
+    for (int i = 0; i < COUNT; i++) {
+        mu_assert_eq_int(1, atomic_load(&marks[i]));
+    }
+    threadpool_destroy(pool);
+}
+
+/* Test: parallel_for with empty range and zero grain */
+mu_test(test_parallel_for_edge_cases)
+{
+    ThreadPoolConfig config = { 2, 0 };
+    ThreadPool *pool = threadpool_create(&config);
+    static atomic_int marks[3];
+
+    threadpool_parallel_for(pool, 0, 4, mark_range, marks);
+    threadpool_parallel_for(pool, 3, 0, mark_range, marks);
+
+    for (int i = 0; i < 3; i++) {
+        mu_assert_eq_int(1, atomic_load(&marks[i]));
+    }
+    threadpool_destroy(pool);
+}
+
+/* Test: More tasks than a deque holds fall back to inline execution */
+mu_test(test_deque_overflow_runs_inline)
+{
+    ThreadPoolConfig config = { 1, 0 };
+    ThreadPool *pool = threadpool_create(&config);
+    enum { COUNT = THREADPOOL_DEQUE_SIZE * 4 };
+    static atomic_int marks[COUNT];
+
+    for (int i = 0; i < COUNT; i++) {
+        atomic_init(&marks[i], 0);
+    }
+    threadpool_parallel_for(pool, COUNT, 1, mark_range, marks);
+
+    int total = 0;
+    for (int i = 0; i < COUNT; i++) {
+        total += atomic_load(&marks[i]);
+    }
+    mu_assert_eq_int(COUNT, total);
+    threadpool_destroy(pool);
+}
+
+/* Test: Workers wake up from futex sleep for new work */
+mu_test(test_wake_after_idle)
+{
+    ThreadPoolConfig config = { POOL_THREADS, 0 };
+    ThreadPool *pool = threadpool_create(&config);
+    ThreadPoolGroup group;
+    atomic_int counter = 0;
+
+    /* Let the workers go to sleep */
+    nanosleep(&(struct timespec){0, 50000000L}, NULL);
+
+    threadpool_group_init(&group);
+    for (int i = 0; i < 100; i++) {
+        threadpool_spawn(pool, &group, count_task, &counter);
+    }
+    threadpool_wait(pool, &group);
+
+    mu_assert_eq_int(100, atomic_load(&counter));
+    threadpool_destroy(pool);
+}
+
+/* Test: Group can be reused after waiting */
+mu_test(test_group_reuse)
+{
+    ThreadPoolConfig config = { 2, 0 };
+    ThreadPool *pool = threadpool_create(&config);
+    ThreadPoolGroup group;
+    atomic_int counter = 0;
+
+    threadpool_group_init(&group);
+    for (int round = 0; round < 10; round++) {
+        for (int i = 0; i < 10; i++) {
+            threadpool_spawn(pool, &group, count_task, &counter);
+        }
+        threadpool_wait(pool, &group);
+        mu_assert_eq_int((round + 1) * 10, atomic_load(&counter));
+    }
+    threadpool_destroy(pool);
+}
+
+/* Test: Core pinning option */
+mu_test(test_pinned_pool)
+{
+    ThreadPoolConfig config = { 2, 1 };
+    ThreadPool *pool = threadpool_create(&config);
+    ThreadPoolGroup group;
+    atomic_int counter = 0;
+
+    mu_assert_not_null(pool);
+    threadpool_group_init(&group);
+    for (int i = 0; i < 100; i++) {
+        threadpool_spawn(pool, &group, count_task, &counter);
+    }
+    threadpool_wait(pool, &group);
+
+    mu_assert_eq_int(100, atomic_load(&counter));
+    threadpool_destroy(pool);
+}
+
+/* Test: Pool may be destroyed while idle and recreated */
+mu_test(test_create_destroy_cycles)
+{
+    for (int i = 0; i < 20; i++) {
+        ThreadPoolConfig config = { 3, 0 };
+        ThreadPool *pool = threadpool_create(&config);
+        mu_assert_not_null(pool);
+        threadpool_destroy(pool);
+    }
+}
+
+/* Test suite runner */
+static void run_all_tests(void)
+{
+    printf("\nRunning Thread Pool Module Tests...\n");
+    printf("===================================\n\n");
+
+    mu_run_test(test_pool_create_destroy);
+    mu_run_test(test_pool_default_config);
+    mu_run_test(test_pool_destroy_null);
+    mu_run_test(test_current_worker_outside);
+    mu_run_test(test_spawn_external);
+    mu_run_test(test_task_runs_on_worker);
+    mu_run_test(test_fork_join_fib);
+    mu_run_test(test_parallel_for_covers_range);
+    mu_run_test(test_parallel_for_edge_cases);
+    mu_run_test(test_deque_overflow_runs_inline);
+    mu_run_test(test_wake_after_idle);
+    mu_run_test(test_group_reuse);
+    mu_run_test(test_pinned_pool);
+    mu_run_test(test_create_destroy_cycles);
+}
+
+int main(void)
+{
+    run_all_tests();
+    mu_print_summary();
+
+    if (mu_tests_failed == 0) {
+        printf("\nAll tests passed!\n");
+    }
+
+    return mu_return_status();
+}
@@ -0,0 +1,180 @@
+/**
+ * @file test_threads.c
+ * @brief Multi-threaded stress tests for the Game Engine module
+ *
+ * Runs many independent games concurrently and checks that every game
+ * produces exactly the same result as when it runs alone. Build with
+ * `make test_tsan` to run the same tests under ThreadSanitizer.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include <pthread.h>
+#include "minunit.h"
+#include "../src/game.h"
+
+#define STRESS_THREADS      8
+#define GAMES_PER_THREAD    16
+#define PIECES_PER_GAME     300
+
+/* Work item for one thread: a range of seeds and their digests */
+typedef struct {
+    uint64_t first_seed;
+    uint64_t digests[GAMES_PER_THREAD];
+} ThreadWork;
+
+/* Helper: FNV-1a over a block of memory */
+static uint64_t fnv1a(uint64_t hash, const void *data, size_t len)
+{
+    const unsigned char *bytes = data;
+    for (size_t i = 0; i < len; i++) {
+        hash ^= bytes[i];
+        hash *= 0x100000001B3ULL;
+    }
+    return hash;
+}
+
+/* Helper: Play one scripted game and return a digest of its course */
+static uint64_t play_game(uint64_t seed)
+{
+    GameState game;
+    game_init_seeded(&game, seed);
+
+    /* Script moves from a local generator so threads share nothing */
+    uint64_t script = seed ^ 0xA5A5A5A5A5A5A5A5ULL;
+    uint64_t hash = 0xCBF29CE484222325ULL;
+    GameEvent event;
+
+    for (int piece = 0; piece < PIECES_PER_GAME && game.is_running; piece++) {
+        script ^= script << 13;
+        script ^= script >> 7;
+        script ^= script << 17;
+
+        game_rotate_current(&game, (int)(script & 1));
+        int shift = (int)((script >> 8) % 9) - 4;
+        for (int i = 0; i < (shift < 0 ? -shift : shift); i++) {
+            game_move_current(&game, shift < 0 ? -1 : 1, 0);
+        }
+        if (script & 0x100000) {
+            game_hold_piece(&game);
+        }
+        game_hard_drop(&game);
+
+        while (game_poll_event(&game, &event)) {
+            hash = fnv1a(hash, &event.type, sizeof(event.type));
+        }
+        hash = fnv1a(hash, game.board.cells, sizeof(game.board.cells));
+    }
+
+    hash = fnv1a(hash, &game.score, sizeof(game.score));
+    hash = fnv1a(hash, &game.lines, sizeof(game.lines));
+    return hash;
+}
+
+/* Thread entry: play all games of one work item */
+static void *worker(void *arg)
+{
+    ThreadWork *work = arg;
+    for (int i = 0; i < GAMES_PER_THREAD; i++) {
+        work->digests[i] = play_game(work->first_seed + (uint64_t)i);
+    }
+    return NULL;
+}
+
+/* Test: Same seed gives the same piece sequence */
+mu_test(test_seeded_games_repeat)
+{
+    GameState a;
+    GameState b;
+    game_init_seeded(&a, 42);
+    game_init_seeded(&b, 42);
+
+    for (int i = 0; i < 100; i++) {
+        mu_assert("Games must keep running", a.is_running && b.is_running);
+        mu_assert_eq_int(a.current.type, b.current.type);
+        mu_assert_eq_int(a.next.type, b.next.type);
+        game_hard_drop(&a);
+        game_hard_drop(&b);
+        memset(a.board.cells, 0, sizeof(a.board.cells));
+        memset(b.board.cells, 0, sizeof(b.board.cells));
+        game_board_sync(&a.board);
+        game_board_sync(&b.board);
+    }
+}
+
+/* Test: Different seeds give different sequences */
+mu_test(test_seeds_differ)
+{
+    mu_assert("Different seeds should not replay the same game",
+              play_game(1) != play_game(2));
+}
+
+/* Test: Games interleaved on one thread do not influence each other */
+mu_test(test_interleaved_games_independent)
+{
+    GameState a;
+    GameState b;
+    GameState alone;
+    game_init_seeded(&a, 7);
+    game_init_seeded(&b, 8);
+    game_init_seeded(&alone, 7);
+
+    for (int i = 0; i < 50; i++) {
+        game_hard_drop(&a);
+        game_hard_drop(&b);
+        game_hard_drop(&alone);
+        mu_assert_eq_int(alone.current.type, a.current.type);
+        mu_assert_eq_int(alone.next.type, a.next.type);
+        if (!a.is_running) {
+            break;
+        }
+    }
+}
+
+/* Test: Concurrent games match their single-threaded results */
+mu_test(test_concurrent_games_match_sequential)
+{
+    static ThreadWork work[STRESS_THREADS];
+    pthread_t threads[STRESS_THREADS];
+
+    for (int t = 0; t < STRESS_THREADS; t++) {
+        work[t].first_seed = (uint64_t)t * GAMES_PER_THREAD + 1000;
+        mu_assert_eq_int(0, pthread_create(&threads[t], NULL, worker, &work[t]));
+    }
+    for (int t = 0; t < STRESS_THREADS; t++) {
+        pthread_join(threads[t], NULL);
+    }
+
+    for (int t = 0; t < STRESS_THREADS; t++) {
+        for (int i = 0; i < GAMES_PER_THREAD; i++) {
+            uint64_t expected = play_game(work[t].first_seed + (uint64_t)i);
+            mu_assert("Concurrent game diverged from sequential run",
+                      expected == work[t].digests[i]);
+        }
+    }
+}
+
+/* Test suite runner */
+static void run_all_tests(void)
+{
+    printf("\nRunning Engine Thread-Safety Tests...\n");
+    printf("=====================================\n\n");
+
+    mu_run_test(test_seeded_games_repeat);
+    mu_run_test(test_seeds_differ);
+    mu_run_test(test_interleaved_games_independent);
+    mu_run_test(test_concurrent_games_match_sequential);
+}
+
+int main(void)
+{
+    run_all_tests();
+    mu_print_summary();
+
+    if (mu_tests_failed == 0) {
+        printf("\nAll tests passed!\n");
+    }
+
+    return mu_return_status();
+}
@@ -0,0 +1,79 @@
+/**
+ * @file tetris_host.c
+ * @brief Headless load-test server hosting many scripted games
+ *
+ * Runs a SessionHost on the 60 Hz schedule for a fixed time and serves
+ * live metrics in Prometheus text format while it runs. At the end the
+ * tick duration percentiles are printed.
+ *
+ * Usage: tetris_host [sessions] [seconds] [metrics-address]
+ *   sessions         Number of games (default 10000)
+ *   seconds          Run time (default 10)
+ *   metrics-address  TCP port on 127.0.0.1 or unix:PATH (default 9464)
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "../src/metrics.h"
+#include "../src/session_host.h"
+#include "../src/threadpool.h"
+
+#define DEFAULT_SESSIONS 10000
+#define DEFAULT_SECONDS  10
+#define DEFAULT_ADDRESS  "9464"
+
+int main(int argc, char **argv)
+{
+    unsigned long sessions = argc > 1 ? strtoul(argv[1], NULL, 10) : DEFAULT_SESSIONS;
+    unsigned long seconds = argc > 2 ? strtoul(argv[2], NULL, 10) : DEFAULT_SECONDS;
+    const char *address = argc > 3 ? argv[3] : DEFAULT_ADDRESS;
+
+    static Metrics metrics;
+    metrics_init(&metrics);
+    MetricsServer *server = metrics_server_start(&metrics, address);
+    if (server == NULL) {
+        fprintf(stderr, "Cannot serve metrics on '%s'\n", address);
+        return 1;
+    }
+
+    ThreadPool *pool = threadpool_create(NULL);
+    SessionHostConfig config = { pool, NULL, NULL, 0, 1, &metrics };
+    SessionHost *host = session_host_create(&config);
+    if (pool == NULL || host == NULL) {
+        fprintf(stderr, "Out of memory\n");
+        return 1;
+    }
+
+    for (unsigned long i = 0; i < sessions; i++) {
+        if (session_host_create_session(host, i) == SESSION_INVALID) {
+            fprintf(stderr, "Out of memory after %lu sessions\n", i);
+            break;
+        }
+    }
+
+    if (metrics_server_port(server) > 0) {
+        printf("Hosting %zu games for %lus, metrics on http://127.0.0.1:%d/metrics\n",
+               session_host_count(host), seconds, metrics_server_port(server));
+    } else {
+        printf("Hosting %zu games for %lus, metrics on %s\n",
+               session_host_count(host), seconds, address);
+    }
+    fflush(stdout);
+
+    session_host_run(host, seconds * (1000000000ULL / SESSION_DEFAULT_TICK_NS));
+
+    SessionTickStats stats;
+    SessionTotals totals;
+    session_host_tick_stats(host, &stats);
+    session_host_totals(host, &totals);
+    printf("ticks %zu  p50 %.1f us  p90 %.1f us  p99 %.1f us  max %.1f us  overruns %lu\n",
+           stats.samples, (double)stats.p50 / 1e3, (double)stats.p90 / 1e3,
+           (double)stats.p99 / 1e3, (double)stats.max / 1e3, stats.overruns);
+    printf("pieces %llu  games finished %llu\n",
+           (unsigned long long)totals.pieces, (unsigned long long)totals.games_finished);
+
+    session_host_destroy(host);
+    threadpool_destroy(pool);
+    metrics_server_stop(server);
+    return 0;
+}
@@ -0,0 +1,235 @@
+/**
+ * @file tetris_sim.c
+ * @brief Headless bot simulation
+ *
+ * Plays seeded games with a greedy one-piece bot: every reachable
+ * placement of the current piece is locked on a copy of the game and
+ * scored with eval_board(), and the best one is played. While hold is
+ * available the bot also scores the placements of the hold alternative
+ * (game_get_hold_alternative()) and holds when that piece does better.
+ * Placements come
+ * from a PlacementCache, so open boards with a skyline seen before skip
+ * the search. At the end the results and the cache hit rate are
+ * printed.
+ *
+ * The bot puts the piece straight into its placement and locks it;
+ * the search has shown that the engine's moves can get it there.
+ *
+ * With -w the first BOOK_DEPTH decisions of every game are recorded
+ * into an opening book; with -b the bot plays those moves from a book
+ * and only searches when the position is not in it. The book stores
+ * placements of the current piece, so decisions that hold are not
+ * recorded.
+ *
+ * Usage: tetris_sim [-b book] [-w book] [games] [pieces] [cache-slots]
+ *   -b book      Play early moves from this opening book
+ *   -w book      Write the early decisions to this opening book
+ *   games        Number of games, seeded 0, 1, ... (default 20)
+ *   pieces       Piece limit per game (default 1000)
+ *   cache-slots  Placement cache size, 0 = no cache (default 4096)
+ */
+
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+#include "../src/book.h"
+#include "../src/eval.h"
+#include "../src/placement.h"
+
+#define DEFAULT_GAMES  20
+#define DEFAULT_PIECES 1000
+
+/**
+ * @brief Score bonus per cleared line on top of eval_board()
+ */
+#define LINE_BONUS 20
+
+static uint64_t now_ns(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000ULL + (uint64_t)now.tv_nsec;
+}
+
+/* Locks the current piece at a placement */
+static StepResult play(GameState *game, const Placement *placement)
+{
+    game->current.x = placement->x;
+    game->current.y = placement->y;
+    game->current.rotation = placement->rotation;
+    return game_commit_piece(game);
+}
+
+/* Index of the best placement, -1 if there is none; its score goes to *best_score */
+static int choose(const GameState *game, const PlacementList *list, int *best_score)
+{
+    static GameState trial;
+    int best = -1;
+    *best_score = INT_MIN;
+
+    for (int i = 0; i < list->count; i++) {
+        trial = *game;
+        StepResult result = play(&trial, &list->items[i]);
+        int score = result.game_over ? INT_MIN + 1
+                  : eval_board(&trial.board, &EVAL_DEFAULT_WEIGHTS) + LINE_BONUS * result.clear.lines;
+        if (score > *best_score) {
+            *best_score = score;
+            best = i;
+        }
+    }
+    return best;
+}
+
+/* 1 if the current piece can rest at the placement */
+static int is_resting(const GameState *game, const Placement *placement)
+{
+    Tetromino t = { game->current.type, placement->x, placement->y, placement->rotation };
+    if (!game_is_valid_position(game, &t)) {
+        return 0;
+    }
+    t.y++;
+    return !game_is_valid_position(game, &t);
+}
+
+int main(int argc, char **argv)
+{
+    const char *book_path = NULL;
+    const char *write_path = NULL;
+    int option;
+    while ((option = getopt(argc, argv, "b:w:")) != -1) {
+        switch (option) {
+        case 'b': book_path = optarg; break;
+        case 'w': write_path = optarg; break;
+        default:
+            fprintf(stderr, "Usage: %s [-b book] [-w book] [games] [pieces] [cache-slots]\n", argv[0]);
+            return 1;
+        }
+    }
+    argc -= optind - 1;
+    argv += optind - 1;
+
+    unsigned long games = argc > 1 ? strtoul(argv[1], NULL, 10) : DEFAULT_GAMES;
+    unsigned long limit = argc > 2 ? strtoul(argv[2], NULL, 10) : DEFAULT_PIECES;
+    unsigned long slots = argc > 3 ? strtoul(argv[3], NULL, 10) : PLACEMENT_CACHE_SLOTS;
+
+    PlacementCache *cache = NULL;
+    if (slots > 0) {
+        cache = placement_cache_create(slots);
+        if (cache == NULL) {
+            fprintf(stderr, "Out of memory\n");
+            return 1;
+        }
+    }
+
+    OpeningBook *book = NULL;
+    if (book_path != NULL && (book = book_open(book_path)) == NULL) {
+        fprintf(stderr, "Cannot open book %s\n", book_path);
+        return 1;
+    }
+    BookBuilder *builder = NULL;
+    if (write_path != NULL && (builder = book_builder_create()) == NULL) {
+        fprintf(stderr, "Out of memory\n");
+        return 1;
+    }
+    unsigned long book_hits = 0, book_misses = 0;
+
+    static GameState game, held;
+    static PlacementList list, hold_list;
+    unsigned long pieces = 0, lines = 0, topouts = 0, holds = 0;
+    uint64_t start = now_ns();
+
+    for (unsigned long g = 0; g < games; g++) {
+        game_init_seeded(&game, g);
+        for (unsigned long p = 0; p < limit && game.is_running; p++) {
+            Placement move;
+            if (book != NULL && p < BOOK_DEPTH) {
+                if (book_lookup(book, &game, &move) && is_resting(&game, &move)) {
+                    book_hits++;
+                    play(&game, &move);
+                    pieces++;
+                    continue;
+                }
+                book_misses++;
+            }
+
+            placement_find(cache, &game, game.current.type, &list);
+            int best_score;
+            int best = choose(&game, &list, &best_score);
+
+            /* Branch over the hold alternative as well */
+            int hold = 0;
+            if (game_can_hold(&game) && game_get_hold_alternative(&game) != game.current.type) {
+                held = game;
+                if (game_hold_piece(&held)) {
+                    placement_find(cache, &held, held.current.type, &hold_list);
+                    int hold_score;
+                    int hold_best = choose(&held, &hold_list, &hold_score);
+                    if (hold_best >= 0 && (best < 0 || hold_score > best_score)) {
+                        hold = 1;
+                        best = hold_best;
+                    }
+                }
+            }
+            if (best < 0) {
+                break;
+            }
+
+            if (hold) {
+                /* The copy already made the swap (and drew the same next piece) */
+                game = held;
+                move = hold_list.items[best];
+                holds++;
+            } else {
+                move = list.items[best];
+                if (builder != NULL && p < BOOK_DEPTH && !book_builder_add(builder, &game, &move)) {
+                    fprintf(stderr, "Out of memory\n");
+                    return 1;
+                }
+            }
+            play(&game, &move);
+            pieces++;
+
+            GameEvent event;
+            while (game_poll_event(&game, &event)) {
+            }
+        }
+        lines += (unsigned long)game.lines;
+        topouts += !game.is_running;
+    }
+    uint64_t elapsed = now_ns() - start;
+
+    printf("games %lu  pieces %lu  lines %lu  lines/game %.1f  topped out %lu  holds %lu\n",
+           games, pieces, lines, games > 0 ? (double)lines / (double)games : 0.0, topouts, holds);
+    printf("time %.2f s  %.1f us/piece\n", (double)elapsed / 1e9,
+           pieces > 0 ? (double)elapsed / 1e3 / (double)pieces : 0.0);
+
+    if (cache != NULL) {
+        PlacementCacheStats stats;
+        placement_cache_stats(cache, &stats);
+        unsigned long open = stats.hits + stats.misses;
+        printf("placement cache: hits %lu  misses %lu  overhang fallbacks %lu  "
+               "hit rate %.1f%% of open boards, %.1f%% of all\n",
+               stats.hits, stats.misses, stats.fallbacks,
+               open > 0 ? 100.0 * (double)stats.hits / (double)open : 0.0,
+               open + stats.fallbacks > 0
+                   ? 100.0 * (double)stats.hits / (double)(open + stats.fallbacks) : 0.0);
+        placement_cache_destroy(cache);
+    }
+    if (book != NULL) {
+        printf("opening book: %zu entries  hits %lu  misses %lu\n",
+               book_size(book), book_hits, book_misses);
+        book_close(book);
+    }
+    if (builder != NULL) {
+        long written = book_builder_write(builder, write_path);
+        book_builder_destroy(builder);
+        if (written < 0) {
+            fprintf(stderr, "Cannot write book %s\n", write_path);
+            return 1;
+        }
+        printf("opening book: wrote %ld entries to %s\n", written, write_path);
+    }
+    return 0;
+}
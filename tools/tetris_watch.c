@@ -0,0 +1,97 @@
+/**
+ * @file tetris_watch.c
+ * @brief Spectator for a grid of scripted games
+ *
+ * Hosts a number of scripted games with a SessionHost and shows them
+ * tiled in the terminal at 60 Hz. Only cells that changed since the
+ * previous frame are redrawn.
+ *
+ * Keys: c cycles the glyph modes (compact, half blocks, braille, wide),
+ * q quits.
+ *
+ * Usage: tetris_watch [games]
+ *   games  Number of games (default 16)
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <ncurses.h>
+#include "../src/renderer.h"
+#include "../src/session_host.h"
+#include "../src/spectator.h"
+
+#define DEFAULT_GAMES 16
+
+int main(int argc, char **argv)
+{
+    unsigned long games = argc > 1 ? strtoul(argv[1], NULL, 10) : DEFAULT_GAMES;
+    if (games == 0) {
+        fprintf(stderr, "Need at least one game\n");
+        return 1;
+    }
+
+    SessionHostConfig config = { NULL, NULL, NULL, 0, 1, NULL };
+    SessionHost *host = session_host_create(&config);
+    SessionId *ids = malloc(games * sizeof(*ids));
+    const GameState **boards = malloc(games * sizeof(*boards));
+    SpectatorGlyphs glyphs = SPECTATOR_GLYPHS_COMPACT;
+    SpectatorView *view = spectator_create(games, glyphs);
+    if (host == NULL || ids == NULL || boards == NULL || view == NULL) {
+        fprintf(stderr, "Out of memory\n");
+        return 1;
+    }
+    for (unsigned long i = 0; i < games; i++) {
+        ids[i] = session_host_create_session(host, i);
+    }
+
+    renderer_init();
+    timeout(0);
+    spectator_layout(view, COLS, LINES);
+
+    struct timespec deadline;
+    clock_gettime(CLOCK_MONOTONIC, &deadline);
+
+    int running = 1;
+    while (running) {
+        int key;
+        while ((key = getch()) != ERR) {
+            if (key == 'q' || key == 'Q') {
+                running = 0;
+            } else if (key == 'c' || key == 'C') {
+                glyphs = (SpectatorGlyphs)((glyphs + 1) % (SPECTATOR_GLYPHS_BRAILLE + 1));
+                spectator_set_glyphs(view, glyphs);
+            } else if (key == KEY_RESIZE) {
+                spectator_layout(view, COLS, LINES);
+            }
+        }
+
+        session_host_tick(host);
+        for (unsigned long i = 0; i < games; i++) {
+            const Session *session = session_host_get(host, ids[i]);
+            boards[i] = session != NULL ? &session->game : NULL;
+        }
+        spectator_draw(view, boards, games);
+
+        /* Absolute deadlines keep the frame rate from drifting */
+        deadline.tv_nsec += (long)SESSION_DEFAULT_TICK_NS;
+        while (deadline.tv_nsec >= 1000000000L) {
+            deadline.tv_nsec -= 1000000000L;
+            deadline.tv_sec++;
+        }
+        clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &deadline, NULL);
+    }
+
+    renderer_cleanup();
+
+    SpectatorStats stats;
+    spectator_stats(view, &stats);
+    printf("frames %lu  boards drawn %lu  skipped %lu  glyphs drawn %lu\n",
+           stats.frames, stats.boards_drawn, stats.boards_skipped, stats.glyphs_drawn);
+
+    spectator_destroy(view);
+    free(boards);
+    free(ids);
+    session_host_destroy(host);
+    return 0;
+}